@@ -23,6 +23,7 @@
 #include <libevmasm/Assembly.h>
 #include <libevmasm/GasMeter.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Word256.h>
 
 using namespace std;
 using namespace solidity;
@@ -201,9 +202,10 @@ AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 		// Is not always better, try literal and decomposition method.
 		AssemblyItems routine{u256(_value)};
 		bigint bestGas = gasNeeded(routine);
+		util::Word256 const value(_value);
 		for (unsigned bits = 255; bits > 8 && m_maxSteps > 0; --bits)
 		{
-			unsigned gapDetector = unsigned((_value >> (bits - 8)) & 0x1ff);
+			unsigned gapDetector = unsigned((value >> (bits - 8)).limb(0) & 0x1ff);
 			if (gapDetector != 0xff && gapDetector != 0x100)
 				continue;
 
@@ -255,7 +257,7 @@ AssemblyItems ComputeMethod::findRepresentation(u256 const& _value)
 bool ComputeMethod::checkRepresentation(u256 const& _value, AssemblyItems const& _routine) const
 {
 	// This is a tiny EVM that can only evaluate some instructions.
-	vector<u256> stack;
+	vector<util::Word256> stack;
 	for (AssemblyItem const& item: _routine)
 	{
 		switch (item.type())
@@ -264,7 +266,7 @@ bool ComputeMethod::checkRepresentation(u256 const& _value, AssemblyItems const&
 		{
 			if (stack.size() < item.arguments())
 				return false;
-			u256* sp = &stack.back();
+			util::Word256* sp = &stack.back();
 			switch (item.instruction())
 			{
 			case Instruction::MUL:
@@ -273,7 +275,7 @@ bool ComputeMethod::checkRepresentation(u256 const& _value, AssemblyItems const&
 			case Instruction::EXP:
 				if (sp[-1] > 0xff)
 					return false;
-				sp[-1] = boost::multiprecision::pow(sp[0], unsigned(sp[-1]));
+				sp[-1] = util::Word256::exp(sp[0], sp[-1]);
 				break;
 			case Instruction::ADD:
 				sp[-1] = sp[0] + sp[-1];
@@ -290,8 +292,8 @@ bool ComputeMethod::checkRepresentation(u256 const& _value, AssemblyItems const&
 					OptimizerException,
 					"Shift generated for invalid EVM version."
 				);
-				assertThrow(sp[0] <= u256(255), OptimizerException, "Invalid shift generated.");
-				sp[-1] = u256(bigint(sp[-1]) << unsigned(sp[0]));
+				assertThrow(sp[0] <= 255, OptimizerException, "Invalid shift generated.");
+				sp[-1] = sp[-1] << unsigned(sp[0].limb(0));
 				break;
 			case Instruction::SHR:
 				assertThrow(
@@ -299,8 +301,8 @@ bool ComputeMethod::checkRepresentation(u256 const& _value, AssemblyItems const&
 					OptimizerException,
 					"Shift generated for invalid EVM version."
 				);
-				assertThrow(sp[0] <= u256(255), OptimizerException, "Invalid shift generated.");
-				sp[-1] = sp[-1] >> unsigned(sp[0]);
+				assertThrow(sp[0] <= 255, OptimizerException, "Invalid shift generated.");
+				sp[-1] = sp[-1] >> unsigned(sp[0].limb(0));
 				break;
 			default:
 				return false;
@@ -309,13 +311,13 @@ bool ComputeMethod::checkRepresentation(u256 const& _value, AssemblyItems const&
 			break;
 		}
 		case Push:
-			stack.push_back(item.data());
+			stack.emplace_back(item.data());
 			break;
 		default:
 			return false;
 		}
 	}
-	return stack.size() == 1 && stack.front() == _value;
+	return stack.size() == 1 && stack.front() == util::Word256(_value);
 }
 
 bigint ComputeMethod::gasNeeded(AssemblyItems const& _routine) const
@@ -59,13 +59,13 @@ ostream& KnownState::stream(ostream& _out) const
 		streamExpressionClass(_out, eqClass);
 
 	_out << "Stack:" << endl;
-	for (auto const& it: m_stackElements)
+	for (auto const& it: *m_stackElements)
 	{
 		_out << "  " << dec << it.first << ": ";
 		streamExpressionClass(_out, it.second);
 	}
 	_out << "Storage:" << endl;
-	for (auto const& it: m_storageContent)
+	for (auto const& it: *m_storageContent)
 	{
 		_out << "  ";
 		streamExpressionClass(_out, it.first);
@@ -73,7 +73,7 @@ ostream& KnownState::stream(ostream& _out) const
 		streamExpressionClass(_out, it.second);
 	}
 	_out << "Memory:" << endl;
-	for (auto const& it: m_memoryContent)
+	for (auto const& it: *m_memoryContent)
 	{
 		_out << "  ";
 		streamExpressionClass(_out, it.first);
@@ -172,60 +172,73 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 					);
 			}
 		}
-		m_stackElements.erase(
-			m_stackElements.upper_bound(m_stackHeight + static_cast<int>(_item.deposit())),
-			m_stackElements.end()
-		);
 		m_stackHeight += static_cast<int>(_item.deposit());
+		if (m_stackElements->upper_bound(m_stackHeight) != m_stackElements->end())
+		{
+			map<int, Id>& stackElements = m_stackElements.write();
+			stackElements.erase(stackElements.upper_bound(m_stackHeight), stackElements.end());
+		}
 	}
 	return op;
 }
 
 /// Helper function for KnownState::reduceToCommonKnowledge, removes everything from
 /// _this which is not in or not equal to the value in _other.
-template <class Mapping> void intersect(Mapping& _this, Mapping const& _other)
+/// Keeps sharing the content of _this if nothing is removed.
+template <class Mapping> void intersect(util::CopyOnWrite<Mapping>& _this, util::CopyOnWrite<Mapping> const& _other)
 {
-	for (auto it = _this.begin(); it != _this.end();)
-		if (_other.count(it->first) && _other.at(it->first) == it->second)
-			++it;
-		else
-			it = _this.erase(it);
+	if (_this.sharesValueWith(_other))
+		return;
+	Mapping common;
+	for (auto const& item: *_this)
+	{
+		auto it = _other->find(item.first);
+		if (it != _other->end() && it->second == item.second)
+			common.insert(item);
+	}
+	if (common.size() != _this->size())
+		_this = util::CopyOnWrite<Mapping>(move(common));
 }
 
 void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combineSequenceNumbers)
 {
 	int stackDiff = m_stackHeight - _other.m_stackHeight;
-	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
-		if (_other.m_stackElements.count(it->first - stackDiff))
-		{
-			Id other = _other.m_stackElements.at(it->first - stackDiff);
-			if (it->second == other)
-				++it;
-			else
+	if (stackDiff != 0 || !m_stackElements.sharesValueWith(_other.m_stackElements))
+	{
+		map<int, Id>& stackElements = m_stackElements.write();
+		map<int, Id> const& otherStackElements = *_other.m_stackElements;
+		for (auto it = stackElements.begin(); it != stackElements.end();)
+			if (otherStackElements.count(it->first - stackDiff))
 			{
-				set<u256> theseTags = tagsInExpression(it->second);
-				set<u256> otherTags = tagsInExpression(other);
-				if (!theseTags.empty() && !otherTags.empty())
-				{
-					theseTags.insert(otherTags.begin(), otherTags.end());
-					it->second = tagUnion(theseTags);
+				Id other = otherStackElements.at(it->first - stackDiff);
+				if (it->second == other)
 					++it;
-				}
 				else
-					it = m_stackElements.erase(it);
+				{
+					set<u256> theseTags = tagsInExpression(it->second);
+					set<u256> otherTags = tagsInExpression(other);
+					if (!theseTags.empty() && !otherTags.empty())
+					{
+						theseTags.insert(otherTags.begin(), otherTags.end());
+						it->second = tagUnion(theseTags);
+						++it;
+					}
+					else
+						it = stackElements.erase(it);
+				}
 			}
-		}
-		else
-			it = m_stackElements.erase(it);
+			else
+				it = stackElements.erase(it);
 
-	// Use the smaller stack height. Essential to terminate in case of loops.
-	if (m_stackHeight > _other.m_stackHeight)
-	{
-		map<int, Id> shiftedStack;
-		for (auto const& stackElement: m_stackElements)
-			shiftedStack[stackElement.first - stackDiff] = stackElement.second;
-		m_stackElements = move(shiftedStack);
-		m_stackHeight = _other.m_stackHeight;
+		// Use the smaller stack height. Essential to terminate in case of loops.
+		if (m_stackHeight > _other.m_stackHeight)
+		{
+			map<int, Id> shiftedStack;
+			for (auto const& stackElement: stackElements)
+				shiftedStack[stackElement.first - stackDiff] = stackElement.second;
+			stackElements = move(shiftedStack);
+			m_stackHeight = _other.m_stackHeight;
+		}
 	}
 
 	intersect(m_storageContent, _other.m_storageContent);
@@ -236,23 +249,29 @@ void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combine
 
 bool KnownState::operator==(KnownState const& _other) const
 {
-	if (m_storageContent != _other.m_storageContent || m_memoryContent != _other.m_memoryContent)
+	if (
+		(!m_storageContent.sharesValueWith(_other.m_storageContent) && *m_storageContent != *_other.m_storageContent) ||
+		(!m_memoryContent.sharesValueWith(_other.m_memoryContent) && *m_memoryContent != *_other.m_memoryContent)
+	)
 		return false;
 	int stackDiff = m_stackHeight - _other.m_stackHeight;
-	auto thisIt = m_stackElements.cbegin();
-	auto otherIt = _other.m_stackElements.cbegin();
-	for (; thisIt != m_stackElements.cend() && otherIt != _other.m_stackElements.cend(); ++thisIt, ++otherIt)
+	if (stackDiff == 0 && m_stackElements.sharesValueWith(_other.m_stackElements))
+		return true;
+	auto thisIt = m_stackElements->cbegin();
+	auto otherIt = _other.m_stackElements->cbegin();
+	for (; thisIt != m_stackElements->cend() && otherIt != _other.m_stackElements->cend(); ++thisIt, ++otherIt)
 		if (thisIt->first - stackDiff != otherIt->first || thisIt->second != otherIt->second)
 			return false;
-	return (thisIt == m_stackElements.cend() && otherIt == _other.m_stackElements.cend());
+	return (thisIt == m_stackElements->cend() && otherIt == _other.m_stackElements->cend());
 }
 
 ExpressionClasses::Id KnownState::stackElement(int _stackHeight, SourceLocation const& _location)
 {
-	if (m_stackElements.count(_stackHeight))
-		return m_stackElements.at(_stackHeight);
+	auto it = m_stackElements->find(_stackHeight);
+	if (it != m_stackElements->end())
+		return it->second;
 	// Stack element not found (not assigned yet), create new unknown equivalence class.
-	return m_stackElements[_stackHeight] =
+	return m_stackElements.write()[_stackHeight] =
 			m_expressionClasses->find(AssemblyItem(UndefinedItem, _stackHeight, _location));
 }
 
@@ -263,16 +282,17 @@ KnownState::Id KnownState::relativeStackElement(int _stackOffset, SourceLocation
 
 void KnownState::clearTagUnions()
 {
-	for (auto it = m_stackElements.begin(); it != m_stackElements.end();)
-		if (m_tagUnions.left.count(it->second))
-			it = m_stackElements.erase(it);
+	map<int, Id>& stackElements = m_stackElements.write();
+	for (auto it = stackElements.begin(); it != stackElements.end();)
+		if (m_tagUnions->left.count(it->second))
+			it = stackElements.erase(it);
 		else
 			++it;
 }
 
 void KnownState::setStackElement(int _stackHeight, Id _class)
 {
-	m_stackElements[_stackHeight] = _class;
+	m_stackElements.write()[_stackHeight] = _class;
 }
 
 void KnownState::swapStackElements(
@@ -286,7 +306,8 @@ void KnownState::swapStackElements(
 	stackElement(_stackHeightA, _location);
 	stackElement(_stackHeightB, _location);
 
-	swap(m_stackElements[_stackHeightA], m_stackElements[_stackHeightB]);
+	map<int, Id>& stackElements = m_stackElements.write();
+	swap(stackElements[_stackHeightA], stackElements[_stackHeightB]);
 }
 
 KnownState::StoreOperation KnownState::storeInStorage(
@@ -294,23 +315,24 @@ KnownState::StoreOperation KnownState::storeInStorage(
 	Id _value,
 	SourceLocation const& _location)
 {
-	if (m_storageContent.count(_slot) && m_storageContent[_slot] == _value)
+	auto it = m_storageContent->find(_slot);
+	if (it != m_storageContent->end() && it->second == _value)
 		// do not execute the storage if we know that the value is already there
 		return StoreOperation();
 	m_sequenceNumber++;
-	decltype(m_storageContent) storageContents;
+	map<Id, Id> storageContents;
 	// Copy over all values (i.e. retain knowledge about them) where we know that this store
 	// operation will not destroy the knowledge. Specifically, we copy storage locations we know
 	// are different from _slot or locations where we know that the stored value is equal to _value.
-	for (auto const& storageItem: m_storageContent)
+	for (auto const& storageItem: *m_storageContent)
 		if (m_expressionClasses->knownToBeDifferent(storageItem.first, _slot) || storageItem.second == _value)
 			storageContents.insert(storageItem);
-	m_storageContent = move(storageContents);
 
 	AssemblyItem item(Instruction::SSTORE, _location);
 	Id id = m_expressionClasses->find(item, {_slot, _value}, true, m_sequenceNumber);
 	StoreOperation operation{StoreOperation::Storage, _slot, m_sequenceNumber, id};
-	m_storageContent[_slot] = _value;
+	storageContents[_slot] = _value;
+	m_storageContent = util::CopyOnWrite<map<Id, Id>>(move(storageContents));
 	// increment a second time so that we get unique sequence numbers for writes
 	m_sequenceNumber++;
 
@@ -319,30 +341,32 @@ KnownState::StoreOperation KnownState::storeInStorage(
 
 ExpressionClasses::Id KnownState::loadFromStorage(Id _slot, SourceLocation const& _location)
 {
-	if (m_storageContent.count(_slot))
-		return m_storageContent.at(_slot);
+	auto it = m_storageContent->find(_slot);
+	if (it != m_storageContent->end())
+		return it->second;
 
 	AssemblyItem item(Instruction::SLOAD, _location);
-	return m_storageContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	return m_storageContent.write()[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
 }
 
 KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, SourceLocation const& _location)
 {
-	if (m_memoryContent.count(_slot) && m_memoryContent[_slot] == _value)
+	auto it = m_memoryContent->find(_slot);
+	if (it != m_memoryContent->end() && it->second == _value)
 		// do not execute the store if we know that the value is already there
 		return StoreOperation();
 	m_sequenceNumber++;
-	decltype(m_memoryContent) memoryContents;
+	map<Id, Id> memoryContents;
 	// copy over values at points where we know that they are different from _slot by at least 32
-	for (auto const& memoryItem: m_memoryContent)
+	for (auto const& memoryItem: *m_memoryContent)
 		if (m_expressionClasses->knownToBeDifferentBy32(memoryItem.first, _slot))
 			memoryContents.insert(memoryItem);
-	m_memoryContent = move(memoryContents);
 
 	AssemblyItem item(Instruction::MSTORE, _location);
 	Id id = m_expressionClasses->find(item, {_slot, _value}, true, m_sequenceNumber);
 	StoreOperation operation{StoreOperation::Memory, _slot, m_sequenceNumber, id};
-	m_memoryContent[_slot] = _value;
+	memoryContents[_slot] = _value;
+	m_memoryContent = util::CopyOnWrite<map<Id, Id>>(move(memoryContents));
 	// increment a second time so that we get unique sequence numbers for writes
 	m_sequenceNumber++;
 	return operation;
@@ -350,11 +374,12 @@ KnownState::StoreOperation KnownState::storeInMemory(Id _slot, Id _value, Source
 
 ExpressionClasses::Id KnownState::loadFromMemory(Id _slot, SourceLocation const& _location)
 {
-	if (m_memoryContent.count(_slot))
-		return m_memoryContent.at(_slot);
+	auto it = m_memoryContent->find(_slot);
+	if (it != m_memoryContent->end())
+		return it->second;
 
 	AssemblyItem item(Instruction::MLOAD, _location);
-	return m_memoryContent[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
+	return m_memoryContent.write()[_slot] = m_expressionClasses->find(item, {_slot}, true, m_sequenceNumber);
 }
 
 KnownState::Id KnownState::applyKeccak256(
@@ -379,8 +404,9 @@ KnownState::Id KnownState::applyKeccak256(
 		);
 		arguments.push_back(loadFromMemory(slot, _location));
 	}
-	if (m_knownKeccak256Hashes.count(arguments))
-		return m_knownKeccak256Hashes.at(arguments);
+	auto it = m_knownKeccak256Hashes->find(arguments);
+	if (it != m_knownKeccak256Hashes->end())
+		return it->second;
 	Id v;
 	// If all arguments are known constants, compute the Keccak-256 here
 	if (all_of(arguments.begin(), arguments.end(), [this](Id _a) { return !!m_expressionClasses->knownConstant(_a); }))
@@ -393,13 +419,14 @@ KnownState::Id KnownState::applyKeccak256(
 	}
 	else
 		v = m_expressionClasses->find(keccak256Item, {_start, _length}, true, m_sequenceNumber);
-	return m_knownKeccak256Hashes[arguments] = v;
+	return m_knownKeccak256Hashes.write()[arguments] = v;
 }
 
 set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
 {
-	if (m_tagUnions.left.count(_expressionId))
-		return m_tagUnions.left.at(_expressionId);
+	auto it = m_tagUnions->left.find(_expressionId);
+	if (it != m_tagUnions->left.end())
+		return it->second;
 	// Might be a tag, then return the set of itself.
 	ExpressionClasses::Expression expr = m_expressionClasses->representative(_expressionId);
 	if (expr.item && expr.item->type() == PushTag)
@@ -410,12 +437,13 @@ set<u256> KnownState::tagsInExpression(KnownState::Id _expressionId)
 
 KnownState::Id KnownState::tagUnion(set<u256> _tags)
 {
-	if (m_tagUnions.right.count(_tags))
-		return m_tagUnions.right.at(_tags);
+	auto it = m_tagUnions->right.find(_tags);
+	if (it != m_tagUnions->right.end())
+		return it->second;
 	else
 	{
 		Id id = m_expressionClasses->newClass(SourceLocation());
-		m_tagUnions.right.insert(make_pair(_tags, id));
+		m_tagUnions.write().right.insert(make_pair(_tags, id));
 		return id;
 	}
 }
@@ -26,6 +26,7 @@
 #include <libevmasm/SimplificationRule.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Word256.h>
 
 #include <boost/multiprecision/detail/min_max.hpp>
 
@@ -39,16 +40,6 @@
 namespace solidity::evmasm
 {
 
-template <class S> S divWorkaround(S const& _a, S const& _b)
-{
-	return (S)(bigint(_a) / bigint(_b));
-}
-
-template <class S> S modWorkaround(S const& _a, S const& _b)
-{
-	return (S)(bigint(_a) % bigint(_b));
-}
-
 // This works around a bug fixed with Boost 1.64.
 // https://www.boost.org/doc/libs/1_68_0/libs/multiprecision/doc/html/boost_multiprecision/map/hist.html#boost_multiprecision.map.hist.multiprecision_2_3_1_boost_1_64
 template <class S> S shlWorkaround(S const& _x, unsigned _amount)
@@ -70,16 +61,19 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 {
 	using Word = typename Pattern::Word;
 	using Builtins = typename Pattern::Builtins;
+	using util::Word256;
+	// The expensive operations are evaluated on the fixed-width Word256.
+	static_assert(Pattern::WordSize == 256, "The constant folding assumes 256 bit words.");
 	return std::vector<SimplificationRule<Pattern>> {
 		// arithmetic on constants
 		{Builtins::ADD(A, B), [=]{ return A.d() + B.d(); }, false},
 		{Builtins::MUL(A, B), [=]{ return A.d() * B.d(); }, false},
 		{Builtins::SUB(A, B), [=]{ return A.d() - B.d(); }, false},
-		{Builtins::DIV(A, B), [=]{ return B.d() == 0 ? 0 : divWorkaround(A.d(), B.d()); }, false},
-		{Builtins::SDIV(A, B), [=]{ return B.d() == 0 ? 0 : s2u(divWorkaround(u2s(A.d()), u2s(B.d()))); }, false},
-		{Builtins::MOD(A, B), [=]{ return B.d() == 0 ? 0 : modWorkaround(A.d(), B.d()); }, false},
-		{Builtins::SMOD(A, B), [=]{ return B.d() == 0 ? 0 : s2u(modWorkaround(u2s(A.d()), u2s(B.d()))); }, false},
-		{Builtins::EXP(A, B), [=]{ return Word(boost::multiprecision::powm(bigint(A.d()), bigint(B.d()), bigint(1) << Pattern::WordSize)); }, false},
+		{Builtins::DIV(A, B), [=]{ return Word(Word256(A.d()) / Word256(B.d())); }, false},
+		{Builtins::SDIV(A, B), [=]{ return Word(Word256::signedDiv(Word256(A.d()), Word256(B.d()))); }, false},
+		{Builtins::MOD(A, B), [=]{ return Word(Word256(A.d()) % Word256(B.d())); }, false},
+		{Builtins::SMOD(A, B), [=]{ return Word(Word256::signedMod(Word256(A.d()), Word256(B.d()))); }, false},
+		{Builtins::EXP(A, B), [=]{ return Word(Word256::exp(Word256(A.d()), Word256(B.d()))); }, false},
 		{Builtins::NOT(A), [=]{ return ~A.d(); }, false},
 		{Builtins::LT(A, B), [=]() -> Word { return A.d() < B.d() ? 1 : 0; }, false},
 		{Builtins::GT(A, B), [=]() -> Word { return A.d() > B.d() ? 1 : 0; }, false},
@@ -96,8 +90,8 @@ std::vector<SimplificationRule<Pattern>> simplificationRuleListPart1(
 				0 :
 				(B.d() >> unsigned(8 * (Pattern::WordSize / 8 - 1 - A.d()))) & 0xff;
 		}, false},
-		{Builtins::ADDMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : Word((bigint(A.d()) + bigint(B.d())) % C.d()); }, false},
-		{Builtins::MULMOD(A, B, C), [=]{ return C.d() == 0 ? 0 : Word((bigint(A.d()) * bigint(B.d())) % C.d()); }, false},
+		{Builtins::ADDMOD(A, B, C), [=]{ return Word(Word256::addMod(Word256(A.d()), Word256(B.d()), Word256(C.d()))); }, false},
+		{Builtins::MULMOD(A, B, C), [=]{ return Word(Word256::mulMod(Word256(A.d()), Word256(B.d()), Word256(C.d()))); }, false},
 		{Builtins::SIGNEXTEND(A, B), [=]() -> Word {
 			if (A.d() >= Pattern::WordSize / 8 - 1)
 				return B.d();
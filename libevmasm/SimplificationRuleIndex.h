@@ -0,0 +1,157 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Index of simplification rules by the operation and the argument shapes of their patterns.
+ */
+
+#pragma once
+
+#include <libevmasm/Instruction.h>
+#include <libevmasm/SimplificationRule.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace solidity::evmasm
+{
+
+/// Expressions matched by the match groups of a rule, indexed by the match group.
+/// Match group zero denotes patterns without a match group and is unused.
+template <class Expression>
+using MatchGroups = std::array<Expression const*, 8>;
+
+/// Coarse shape of an expression or a pattern: The opcode of its operation, ConstantShape
+/// for constants and AnyShape for everything else. A pattern of shape AnyShape can match
+/// expressions of any shape, all other patterns only match expressions of their own shape.
+using Shape = unsigned;
+constexpr Shape ConstantShape = 256;
+constexpr Shape AnyShape = 257;
+
+/**
+ * Simplification rules indexed by the operation of their pattern and the shapes of its first
+ * two arguments. This yields the few rules that can possibly match an expression without
+ * trying all rules for its operation.
+ *
+ * The Pattern type has to provide `instruction()`, `arguments()` and `shape()`.
+ */
+template <class Pattern>
+class SimplificationRuleIndex
+{
+public:
+	using Rule = SimplificationRule<Pattern>;
+
+	SimplificationRuleIndex() = default;
+	explicit SimplificationRuleIndex(std::vector<Rule> const& _rules);
+	/// Not copyable because the candidates point into the rules of the index itself.
+	/// Moving keeps the rules at their addresses.
+	SimplificationRuleIndex(SimplificationRuleIndex const&) = delete;
+	SimplificationRuleIndex& operator=(SimplificationRuleIndex const&) = delete;
+	SimplificationRuleIndex(SimplificationRuleIndex&&) = default;
+	SimplificationRuleIndex& operator=(SimplificationRuleIndex&&) = default;
+
+	/// @returns the rules whose pattern might match an application of @a _instruction to
+	/// arguments whose first two have the shapes @a _first and @a _second, in their original order.
+	std::vector<Rule const*> const& candidates(Instruction _instruction, Shape _first, Shape _second) const;
+
+	/// @returns true if there are rules for @a _instruction.
+	bool hasRules(Instruction _instruction) const { return !m_nodes[uint8_t(_instruction)].rules.empty(); }
+
+private:
+	static constexpr size_t indexedArguments = 2;
+
+	struct Node
+	{
+		/// @returns the position of @a _shape in the shapes of argument @a _argument.
+		size_t position(size_t _argument, Shape _shape) const;
+
+		std::vector<Rule> rules;
+		/// Shapes that are required for the indexed arguments by any of the rules,
+		/// always starting with AnyShape.
+		std::array<std::vector<Shape>, indexedArguments> shapes{{{AnyShape}, {AnyShape}}};
+		/// The candidates for each combination of shapes of the indexed arguments.
+		/// Points into @a rules, which are not modified after construction.
+		std::vector<std::vector<Rule const*>> candidates;
+	};
+
+	/// @returns the shape of argument @a _argument of @a _pattern or AnyShape if it has no such argument.
+	static Shape argumentShape(Pattern const& _pattern, size_t _argument);
+
+	std::array<Node, 256> m_nodes;
+};
+
+template <class Pattern>
+SimplificationRuleIndex<Pattern>::SimplificationRuleIndex(std::vector<Rule> const& _rules)
+{
+	for (Rule const& rule: _rules)
+	{
+		Node& node = m_nodes[uint8_t(rule.pattern.instruction())];
+		node.rules.push_back(rule);
+		for (size_t argument = 0; argument < indexedArguments; ++argument)
+		{
+			Shape shape = argumentShape(rule.pattern, argument);
+			auto& shapes = node.shapes[argument];
+			if (std::find(shapes.begin(), shapes.end(), shape) == shapes.end())
+				shapes.push_back(shape);
+		}
+	}
+
+	for (Node& node: m_nodes)
+	{
+		node.candidates.resize(node.shapes[0].size() * node.shapes[1].size());
+		for (Rule const& rule: node.rules)
+		{
+			Shape first = argumentShape(rule.pattern, 0);
+			Shape second = argumentShape(rule.pattern, 1);
+			for (size_t i = 0; i < node.shapes[0].size(); ++i)
+				for (size_t j = 0; j < node.shapes[1].size(); ++j)
+					if (
+						(first == AnyShape || first == node.shapes[0][i]) &&
+						(second == AnyShape || second == node.shapes[1][j])
+					)
+						node.candidates[i * node.shapes[1].size() + j].push_back(&rule);
+		}
+	}
+}
+
+template <class Pattern>
+std::vector<SimplificationRule<Pattern> const*> const& SimplificationRuleIndex<Pattern>::candidates(
+	Instruction _instruction,
+	Shape _first,
+	Shape _second
+) const
+{
+	Node const& node = m_nodes[uint8_t(_instruction)];
+	return node.candidates[node.position(0, _first) * node.shapes[1].size() + node.position(1, _second)];
+}
+
+template <class Pattern>
+size_t SimplificationRuleIndex<Pattern>::Node::position(size_t _argument, Shape _shape) const
+{
+	// Shapes that no rule requires can only be matched by patterns of shape AnyShape at position zero.
+	auto it = std::find(shapes[_argument].begin(), shapes[_argument].end(), _shape);
+	return it == shapes[_argument].end() ? 0 : size_t(it - shapes[_argument].begin());
+}
+
+template <class Pattern>
+Shape SimplificationRuleIndex<Pattern>::argumentShape(Pattern const& _pattern, size_t _argument)
+{
+	auto const& arguments = _pattern.arguments();
+	return _argument < arguments.size() ? arguments[_argument].shape() : AnyShape;
+}
+
+}
@@ -45,11 +45,14 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 	resetMatchGroups();
 
 	assertThrow(_expr.item, OptimizerException, "");
-	for (auto const& rule: m_rules[uint8_t(_expr.item->instruction())])
+	Shape shapes[2] = {AnyShape, AnyShape};
+	for (size_t i = 0; i < min<size_t>(_expr.arguments.size(), 2); ++i)
+		shapes[i] = Pattern::shapeOf(_classes.representative(_expr.arguments[i]));
+	for (auto const* rule: m_rules.candidates(_expr.item->instruction(), shapes[0], shapes[1]))
 	{
-		if (rule.pattern.matches(_expr, _classes))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
+		if (rule->pattern.matches(_expr, _classes))
+			if (!rule->feasible || rule->feasible())
+				return rule;
 
 		resetMatchGroups();
 	}
@@ -58,18 +61,7 @@ SimplificationRule<Pattern> const* Rules::findFirstMatch(
 
 bool Rules::isInitialized() const
 {
-	return !m_rules[uint8_t(Instruction::ADD)].empty();
-}
-
-void Rules::addRules(std::vector<SimplificationRule<Pattern>> const& _rules)
-{
-	for (auto const& r: _rules)
-		addRule(r);
-}
-
-void Rules::addRule(SimplificationRule<Pattern> const& _rule)
-{
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	return m_rules.hasRules(Instruction::ADD);
 }
 
 Rules::Rules()
@@ -92,7 +84,7 @@ Rules::Rules()
 	Y.setMatchGroup(6, m_matchGroups);
 	Z.setMatchGroup(7, m_matchGroups);
 
-	addRules(simplificationRuleList(nullopt, A, B, C, W, X, Y, Z));
+	m_rules = SimplificationRuleIndex<Pattern>(simplificationRuleList(nullopt, A, B, C, W, X, Y, Z));
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
 }
 
@@ -103,8 +95,9 @@ Pattern::Pattern(Instruction _instruction, std::initializer_list<Pattern> _argum
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, MatchGroups<Expression>& _matchGroups)
 {
+	assertThrow(0 < _group && _group < _matchGroups.size(), OptimizerException, "Invalid match group.");
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
@@ -115,9 +108,10 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 		return false;
 	if (m_matchGroup)
 	{
-		if (!m_matchGroups->count(m_matchGroup))
-			(*m_matchGroups)[m_matchGroup] = &_expr;
-		else if ((*m_matchGroups)[m_matchGroup]->id != _expr.id)
+		Expression const*& match = (*m_matchGroups)[m_matchGroup];
+		if (!match)
+			match = &_expr;
+		else if (match->id != _expr.id)
 			return false;
 	}
 	assertThrow(m_arguments.size() == 0 || _expr.arguments.size() == m_arguments.size(), OptimizerException, "");
@@ -127,6 +121,28 @@ bool Pattern::matches(Expression const& _expr, ExpressionClasses const& _classes
 	return true;
 }
 
+Shape Pattern::shape() const
+{
+	if (m_type == Operation)
+		return uint8_t(m_instruction);
+	else if (m_type == Push)
+		return ConstantShape;
+	else
+		return AnyShape;
+}
+
+Shape Pattern::shapeOf(Expression const& _expr)
+{
+	if (!_expr.item)
+		return AnyShape;
+	else if (_expr.item->type() == Operation)
+		return uint8_t(_expr.item->instruction());
+	else if (_expr.item->type() == Push)
+		return ConstantShape;
+	else
+		return AnyShape;
+}
+
 AssemblyItem Pattern::toAssemblyItem(SourceLocation const& _location) const
 {
 	if (m_type == Operation)
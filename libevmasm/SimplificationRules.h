@@ -25,6 +25,7 @@
 
 #include <libevmasm/ExpressionClasses.h>
 #include <libevmasm/SimplificationRule.h>
+#include <libevmasm/SimplificationRuleIndex.h>
 
 #include <libsolutil/CommonData.h>
 
@@ -65,15 +66,12 @@ public:
 	bool isInitialized() const;
 
 private:
-	void addRules(std::vector<SimplificationRule<Pattern>> const& _rules);
-	void addRule(SimplificationRule<Pattern> const& _rule);
+	void resetMatchGroups() { m_matchGroups.fill(nullptr); }
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
-
-	std::map<unsigned, Expression const*> m_matchGroups;
+	MatchGroups<Expression> m_matchGroups{};
 	/// Pattern to match, replacement to be applied and flag indicating whether
 	/// the replacement might remove some elements (except constants).
-	std::vector<SimplificationRule<Pattern>> m_rules[256];
+	SimplificationRuleIndex<Pattern> m_rules;
 };
 
 /**
@@ -104,9 +102,13 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, MatchGroups<Expression>& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
 	bool matches(Expression const& _expr, ExpressionClasses const& _classes) const;
+	/// @returns the shape of the expressions this pattern can match.
+	Shape shape() const;
+	/// @returns the shape of @a _expr as far as patterns are concerned.
+	static Shape shapeOf(Expression const& _expr);
 
 	AssemblyItem toAssemblyItem(langutil::SourceLocation const& _location) const;
 	std::vector<Pattern> arguments() const { return m_arguments; }
@@ -136,7 +138,7 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_type is not Operation
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	MatchGroups<Expression>* m_matchGroups = nullptr;
 };
 
 /**
@@ -53,10 +53,51 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/MappedFile.h>
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
 
+struct CharStream::Storage
+{
+	explicit Storage(shared_ptr<void const> _owner): owner(move(_owner)) {}
+
+	/// A string or a mapped file.
+	shared_ptr<void const> owner;
+	once_flag lineStartsComputed;
+	/// Offsets of the first character of each line, in increasing order.
+	vector<size_t> lineStarts;
+};
+
+CharStream::CharStream(string _source, string _name):
+	m_name(move(_name))
+{
+	auto source = make_shared<string const>(move(_source));
+	m_source = *source;
+	m_storage = make_shared<Storage>(move(source));
+}
+
+CharStream::CharStream(shared_ptr<util::MappedFile const> _file, string _name):
+	m_source(_file->contents()),
+	m_name(move(_name))
+{
+	m_storage = make_shared<Storage>(move(_file));
+}
+
+CharStream CharStream::withName(string _name) const
+{
+	CharStream stream;
+	stream.m_storage = m_storage;
+	stream.m_source = m_source;
+	stream.m_name = move(_name);
+	return stream;
+}
+
 char CharStream::advanceAndGet(size_t _chars)
 {
 	if (isPastEndOfInput())
@@ -93,10 +134,10 @@ string CharStream::lineAtPosition(int _position) const
 		lineStart = 0;
 	else
 		lineStart++;
-	string line = m_source.substr(
+	string line(m_source.substr(
 		lineStart,
 		min(m_source.find('\n', lineStart), m_source.size()) - lineStart
-	);
+	));
 	if (!line.empty() && line.back() == '\r')
 		line.pop_back();
 	return line;
@@ -104,17 +145,17 @@ string CharStream::lineAtPosition(int _position) const
 
 tuple<int, int> CharStream::translatePositionToLineColumn(int _position) const
 {
-	using size_type = string::size_type;
-	using diff_type = string::difference_type;
-	size_type searchPosition = min<size_type>(m_source.size(), size_type(_position));
-	int lineNumber = static_cast<int>(count(m_source.begin(), m_source.begin() + diff_type(searchPosition), '\n'));
-	size_type lineStart;
-	if (searchPosition == 0)
-		lineStart = 0;
-	else
-	{
-		lineStart = m_source.rfind('\n', searchPosition - 1);
-		lineStart = lineStart == string::npos ? 0 : lineStart + 1;
-	}
-	return tuple<int, int>(lineNumber, searchPosition - lineStart);
+	size_t searchPosition = min<size_t>(m_source.size(), size_t(_position));
+	if (!m_storage)
+		return tuple<int, int>(0, searchPosition);
+
+	Storage& storage = *m_storage;
+	call_once(storage.lineStartsComputed, [&]() {
+		storage.lineStarts.push_back(0);
+		for (size_t i = m_source.find('\n'); i != string_view::npos; i = m_source.find('\n', i + 1))
+			storage.lineStarts.push_back(i + 1);
+	});
+	// The line is the last one that starts at or before the position.
+	auto line = upper_bound(storage.lineStarts.begin(), storage.lineStarts.end(), searchPosition) - 1;
+	return tuple<int, int>(line - storage.lineStarts.begin(), searchPosition - *line);
 }
@@ -53,10 +53,17 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
+namespace solidity::util
+{
+class MappedFile;
+}
+
 namespace solidity::langutil
 {
 
@@ -64,13 +71,19 @@ namespace solidity::langutil
  * Bidirectional stream of characters.
  *
  * This CharStream is used by lexical analyzers as the source.
+ * The characters are immutable and shared between copies, so copying a stream is cheap.
+ * Like in a std::string, the character after the end of the source can be read and is zero.
  */
 class CharStream
 {
 public:
 	CharStream() = default;
-	explicit CharStream(std::string  _source, std::string  name):
-		m_source(std::move(_source)), m_name(std::move(name)) {}
+	explicit CharStream(std::string _source, std::string _name);
+	/// Creates a character stream on the contents of @a _file without copying them.
+	explicit CharStream(std::shared_ptr<util::MappedFile const> _file, std::string _name);
+
+	/// @returns a stream at the start of the same characters with the name @a _name.
+	CharStream withName(std::string _name) const;
 
 	size_t position() const { return m_position; }
 	bool isPastEndOfInput(size_t _charsForward = 0) const { return (m_position + _charsForward) >= m_source.size(); }
@@ -87,19 +100,25 @@ public:
 
 	void reset() { m_position = 0; }
 
-	std::string const& source() const noexcept { return m_source; }
+	std::string_view source() const noexcept { return m_source; }
 	std::string const& name() const noexcept { return m_name; }
 
 	///@{
 	///@name Error printing helper functions
 	/// Functions that help pretty-printing parse errors
-	/// Do only use in error cases, they are quite expensive.
+	/// Do only use in error cases, lineAtPosition is quite expensive.
 	std::string lineAtPosition(int _position) const;
+	/// The first call computes the offsets of all line starts, which are shared between
+	/// copies of the stream, so that further calls only take logarithmic time.
 	std::tuple<int, int> translatePositionToLineColumn(int _position) const;
 	///@}
 
 private:
-	std::string m_source;
+	struct Storage;
+
+	/// Owner of the characters and the line start offsets computed from them.
+	std::shared_ptr<Storage> m_storage;
+	std::string_view m_source = "";
 	std::string m_name;
 	size_t m_position{0};
 };
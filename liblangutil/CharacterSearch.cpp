@@ -0,0 +1,200 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <liblangutil/CharacterSearch.h>
+
+#include <liblangutil/Common.h>
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SOL_CHARACTER_SEARCH_SIMD
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SOL_CHARACTER_SEARCH_SIMD
+#endif
+
+#if defined(SOL_CHARACTER_SEARCH_SIMD) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace
+{
+
+bool isLineTerminatorCandidate(char _c)
+{
+	uint8_t c = uint8_t(_c);
+	return (0x0a <= c && c <= 0x0d) || c == 0xc2 || c == 0xe2;
+}
+
+#if defined(__AVX2__)
+
+using Block = __m256i;
+size_t constexpr c_blockSize = 32;
+unsigned constexpr c_allCharacters = 0xffffffff;
+
+Block load(char const* _data) { return _mm256_loadu_si256(reinterpret_cast<Block const*>(_data)); }
+Block splat(char _c) { return _mm256_set1_epi8(_c); }
+Block either(Block _a, Block _b) { return _mm256_or_si256(_a, _b); }
+Block both(Block _a, Block _b) { return _mm256_and_si256(_a, _b); }
+Block equal(Block _a, Block _b) { return _mm256_cmpeq_epi8(_a, _b); }
+/// Signed comparison of the characters.
+Block greater(Block _a, Block _b) { return _mm256_cmpgt_epi8(_a, _b); }
+unsigned mask(Block _a) { return unsigned(_mm256_movemask_epi8(_a)); }
+
+#elif defined(__SSE2__)
+
+using Block = __m128i;
+size_t constexpr c_blockSize = 16;
+unsigned constexpr c_allCharacters = 0xffff;
+
+Block load(char const* _data) { return _mm_loadu_si128(reinterpret_cast<Block const*>(_data)); }
+Block splat(char _c) { return _mm_set1_epi8(_c); }
+Block either(Block _a, Block _b) { return _mm_or_si128(_a, _b); }
+Block both(Block _a, Block _b) { return _mm_and_si128(_a, _b); }
+Block equal(Block _a, Block _b) { return _mm_cmpeq_epi8(_a, _b); }
+/// Signed comparison of the characters.
+Block greater(Block _a, Block _b) { return _mm_cmpgt_epi8(_a, _b); }
+unsigned mask(Block _a) { return unsigned(_mm_movemask_epi8(_a)); }
+
+#endif
+
+#if defined(SOL_CHARACTER_SEARCH_SIMD)
+
+/// @returns the number of zero bits below the lowest set bit of @a _bits, which must not be zero.
+unsigned trailingZeros(unsigned _bits)
+{
+#if defined(_MSC_VER)
+	unsigned long index = 0;
+	_BitScanForward(&index, _bits);
+	return unsigned(index);
+#else
+	return unsigned(__builtin_ctz(_bits));
+#endif
+}
+
+/// @returns the characters of @a _block in the ASCII range [@a _first, @a _last].
+/// Non-ASCII characters are negative and never in the range.
+Block inRange(Block _block, char _first, char _last)
+{
+	return both(greater(_block, splat(char(_first - 1))), greater(splat(char(_last + 1)), _block));
+}
+
+Block decimalDigits(Block _block)
+{
+	return inRange(_block, '0', '9');
+}
+
+/// @returns the ASCII letters of @a _block up to @a _lastLowercase in lower case.
+Block letters(Block _block, char _lastLowercase)
+{
+	// Setting bit 5 maps upper case to lower case letters and no other character to a letter.
+	return inRange(either(_block, splat(0x20)), 'a', _lastLowercase);
+}
+
+/// @returns the first position at or after @a _position at which @a _stops finds a character,
+/// or the start of the last incomplete block of @a _text. Only whole blocks are loaded,
+/// so nothing is read past the end of the text.
+template <typename Stops>
+size_t skipBlocks(string_view _text, size_t _position, Stops _stops)
+{
+	for (; _position + c_blockSize <= _text.size(); _position += c_blockSize)
+		if (unsigned stops = _stops(load(_text.data() + _position)))
+			return _position + size_t(trailingZeros(stops));
+	return _position;
+}
+
+#endif
+
+/// @returns the first position at or after @a _position at which @a _isPart is false.
+template <typename IsPart>
+size_t skipCharacters(string_view _text, size_t _position, IsPart _isPart)
+{
+	while (_position < _text.size() && _isPart(_text[_position]))
+		++_position;
+	return min(_position, _text.size());
+}
+
+}
+
+size_t solidity::langutil::findEndOfWhitespace(string_view _text, size_t _position)
+{
+#if defined(SOL_CHARACTER_SEARCH_SIMD)
+	_position = skipBlocks(_text, _position, [](Block _block) {
+		Block whitespace = either(
+			either(equal(_block, splat(' ')), equal(_block, splat('\t'))),
+			either(equal(_block, splat('\n')), equal(_block, splat('\r')))
+		);
+		return mask(whitespace) ^ c_allCharacters;
+	});
+#endif
+	return skipCharacters(_text, _position, isWhiteSpace);
+}
+
+size_t solidity::langutil::findEndOfIdentifier(string_view _text, size_t _position)
+{
+#if defined(SOL_CHARACTER_SEARCH_SIMD)
+	_position = skipBlocks(_text, _position, [](Block _block) {
+		Block parts = either(
+			either(letters(_block, 'z'), decimalDigits(_block)),
+			either(equal(_block, splat('_')), equal(_block, splat('$')))
+		);
+		return mask(parts) ^ c_allCharacters;
+	});
+#endif
+	return skipCharacters(_text, _position, isIdentifierPart);
+}
+
+size_t solidity::langutil::findEndOfDecimalDigits(string_view _text, size_t _position)
+{
+#if defined(SOL_CHARACTER_SEARCH_SIMD)
+	_position = skipBlocks(_text, _position, [](Block _block) {
+		return mask(either(decimalDigits(_block), equal(_block, splat('_')))) ^ c_allCharacters;
+	});
+#endif
+	return skipCharacters(_text, _position, [](char _c) { return isDecimalDigit(_c) || _c == '_'; });
+}
+
+size_t solidity::langutil::findEndOfHexDigits(string_view _text, size_t _position)
+{
+#if defined(SOL_CHARACTER_SEARCH_SIMD)
+	_position = skipBlocks(_text, _position, [](Block _block) {
+		Block parts = either(either(letters(_block, 'f'), decimalDigits(_block)), equal(_block, splat('_')));
+		return mask(parts) ^ c_allCharacters;
+	});
+#endif
+	return skipCharacters(_text, _position, [](char _c) { return isHexDigit(_c) || _c == '_'; });
+}
+
+size_t solidity::langutil::findLineTerminatorCandidate(string_view _text, size_t _position)
+{
+#if defined(SOL_CHARACTER_SEARCH_SIMD)
+	_position = skipBlocks(_text, _position, [](Block _block) {
+		Block candidates = either(
+			inRange(_block, 0x0a, 0x0d),
+			either(equal(_block, splat(char(0xc2))), equal(_block, splat(char(0xe2))))
+		);
+		return mask(candidates);
+	});
+#endif
+	return skipCharacters(_text, _position, [](char _c) { return !isLineTerminatorCandidate(_c); });
+}
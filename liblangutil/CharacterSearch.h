@@ -0,0 +1,50 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Searches for the end of runs of characters of a class, used by the scanner to skip
+ * over whitespace, comments, identifiers and numbers.
+ *
+ * Where SSE2 or AVX2 are enabled at compile time, 16 or 32 characters are examined
+ * at once, otherwise one after the other.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace solidity::langutil
+{
+
+/// @returns the position of the first character at or after @a _position in @a _text that is
+/// not a space, tab, line feed or carriage return, or the size of @a _text if there is none.
+size_t findEndOfWhitespace(std::string_view _text, size_t _position);
+/// @returns the position of the first character at or after @a _position in @a _text that
+/// cannot be part of an identifier, i.e. is not a letter, a decimal digit, '_' or '$'.
+size_t findEndOfIdentifier(std::string_view _text, size_t _position);
+/// @returns the position of the first character at or after @a _position in @a _text that
+/// is neither a decimal digit nor '_'.
+size_t findEndOfDecimalDigits(std::string_view _text, size_t _position);
+/// @returns the position of the first character at or after @a _position in @a _text that
+/// is neither a hex digit nor '_'.
+size_t findEndOfHexDigits(std::string_view _text, size_t _position);
+/// @returns the position of the first character at or after @a _position in @a _text that
+/// might start a line terminator, i.e. '\n', '\v', '\f', '\r' or the first byte of the UTF-8
+/// encoding of NEL, LS or PS. This is a superset, the candidates have to be checked.
+size_t findLineTerminatorCandidate(std::string_view _text, size_t _position);
+
+}
@@ -0,0 +1,147 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <liblangutil/CompactSourceLocation.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace
+{
+
+/// Table of the character streams referred to by compact source locations. It only refers
+/// to them weakly, so that it does not keep the sources of finished compilations alive.
+/// Indices are never reused, so a stale index can only resolve to nullptr.
+struct CharStreamTable
+{
+	shared_mutex mutex;
+	/// Index zero is reserved for "no character stream".
+	uint32_t nextIndex = 1;
+	unordered_map<uint32_t, weak_ptr<CharStream>> streams;
+	unordered_map<CharStream const*, uint32_t> indices;
+	/// Number of streams at which the destroyed ones are removed next.
+	size_t sweepSize = 64;
+};
+
+CharStreamTable& table()
+{
+	static CharStreamTable table;
+	return table;
+}
+
+/// Most recent lookup of the current thread, since consecutive conversions almost always
+/// refer to the same character stream.
+struct CacheEntry
+{
+	CharStream const* pointer = nullptr;
+	weak_ptr<CharStream> stream;
+	uint32_t index = 0;
+};
+
+thread_local CacheEntry cache;
+
+/// @returns the index of @a _charStream if it is in the table. The caller has to hold the lock.
+uint32_t findIndex(CharStreamTable const& _streams, shared_ptr<CharStream> const& _charStream)
+{
+	auto it = _streams.indices.find(_charStream.get());
+	if (it == _streams.indices.end())
+		return 0;
+	// A destroyed stream might have been at the same address.
+	auto stream = _streams.streams.find(it->second);
+	if (stream == _streams.streams.end() || stream->second.lock() != _charStream)
+		return 0;
+	return it->second;
+}
+
+/// Removes the destroyed streams from the table. The caller has to hold the lock exclusively.
+void sweep(CharStreamTable& _streams)
+{
+	for (auto it = _streams.streams.begin(); it != _streams.streams.end();)
+		if (it->second.expired())
+			it = _streams.streams.erase(it);
+		else
+			++it;
+	for (auto it = _streams.indices.begin(); it != _streams.indices.end();)
+		if (!_streams.streams.count(it->second))
+			it = _streams.indices.erase(it);
+		else
+			++it;
+	_streams.sweepSize = max<size_t>(64, 2 * _streams.streams.size());
+}
+
+}
+
+uint32_t CompactSourceLocation::indexOf(shared_ptr<CharStream> const& _charStream)
+{
+	if (!_charStream)
+		return 0;
+	// An expired cache entry might refer to an earlier stream at the same address.
+	if (cache.pointer == _charStream.get() && !cache.stream.expired())
+		return cache.index;
+
+	CharStreamTable& streams = table();
+	uint32_t index = 0;
+	{
+		shared_lock<shared_mutex> lock(streams.mutex);
+		index = findIndex(streams, _charStream);
+	}
+	if (!index)
+	{
+		unique_lock<shared_mutex> lock(streams.mutex);
+		index = findIndex(streams, _charStream);
+		if (!index)
+		{
+			if (streams.streams.size() >= streams.sweepSize)
+				sweep(streams);
+			solAssert(streams.nextIndex < numeric_limits<uint32_t>::max(), "Too many character streams.");
+			index = streams.nextIndex++;
+			streams.streams[index] = _charStream;
+			streams.indices[_charStream.get()] = index;
+		}
+	}
+	cache = CacheEntry{_charStream.get(), _charStream, index};
+	return index;
+}
+
+shared_ptr<CharStream> CompactSourceLocation::charStream(uint32_t _index)
+{
+	if (!_index)
+		return nullptr;
+	if (cache.index == _index)
+		return cache.stream.lock();
+
+	CharStreamTable& streams = table();
+	shared_ptr<CharStream> stream;
+	{
+		shared_lock<shared_mutex> lock(streams.mutex);
+		solAssert(_index < streams.nextIndex, "Invalid character stream index.");
+		auto it = streams.streams.find(_index);
+		if (it != streams.streams.end())
+			stream = it->second.lock();
+	}
+	if (stream)
+		cache = CacheEntry{stream.get(), stream, _index};
+	return stream;
+}
@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Source location that refers to its character stream by an index.
+ */
+
+#pragma once
+
+#include <liblangutil/SourceLocation.h>
+
+#include <cstdint>
+#include <memory>
+
+namespace solidity::langutil
+{
+
+/**
+ * Interval of source positions like SourceLocation, but referring to its character stream by
+ * an index into a process-wide table instead of a shared pointer. It is trivially copyable and
+ * half the size of a SourceLocation, which makes it suitable for ASTs that are copied a lot.
+ * It converts implicitly from and to SourceLocation.
+ *
+ * The table only refers to the character streams weakly, so a location loses its source when
+ * the last owner of the stream is gone. The Yul AST is kept together with its source by the
+ * scanner or by yul::Object::charStream.
+ */
+struct CompactSourceLocation
+{
+	CompactSourceLocation() = default;
+	CompactSourceLocation(int _start, int _end, uint32_t _sourceIndex):
+		start(_start), end(_end), sourceIndex(_sourceIndex)
+	{}
+	CompactSourceLocation(SourceLocation const& _location):
+		start(_location.start), end(_location.end), sourceIndex(indexOf(_location.source))
+	{}
+
+	operator SourceLocation() const { return SourceLocation{start, end, charStream(sourceIndex)}; }
+
+	bool operator==(CompactSourceLocation const& _other) const
+	{
+		return sourceIndex == _other.sourceIndex && start == _other.start && end == _other.end;
+	}
+	bool operator!=(CompactSourceLocation const& _other) const { return !operator==(_other); }
+
+	bool isValid() const { return sourceIndex != 0 || start != -1 || end != -1; }
+
+	/// @returns the index of @a _charStream in the table, adding it if necessary.
+	/// Index zero denotes the absence of a character stream.
+	static uint32_t indexOf(std::shared_ptr<CharStream> const& _charStream);
+	/// @returns the character stream at @a _index or nullptr if it has been destroyed.
+	static std::shared_ptr<CharStream> charStream(uint32_t _index);
+
+	int start = -1;
+	int end = -1;
+	uint32_t sourceIndex = 0;
+};
+
+}
@@ -50,6 +50,7 @@
  * Solidity scanner.
  */
 
+#include <liblangutil/CharacterSearch.h>
 #include <liblangutil/Common.h>
 #include <liblangutil/Exceptions.h>
 #include <liblangutil/Scanner.h>
@@ -221,6 +222,13 @@ void Scanner::addUnicodeAsUTF8(unsigned codepoint)
 	}
 }
 
+void Scanner::addLiteralCharsAndAdvanceTo(size_t _end)
+{
+	solAssert(sourcePos() <= _end, "");
+	m_tokens[NextNext].literal.append(source().substr(sourcePos(), _end - sourcePos()));
+	m_char = m_source->setPosition(_end);
+}
+
 void Scanner::rescan()
 {
 	size_t rollbackTo = 0;
@@ -261,8 +269,10 @@ Token Scanner::selectToken(char _next, Token _then, Token _else)
 bool Scanner::skipWhitespace()
 {
 	size_t const startPosition = sourcePos();
-	while (isWhiteSpace(m_char))
-		advance();
+	// m_char is not necessarily the character at the current position (see skipMultiLineComment),
+	// so it is checked before searching the source.
+	if (isWhiteSpace(m_char) && advance())
+		m_char = m_source->setPosition(findEndOfWhitespace(source(), sourcePos()));
 	// Return whether or not we skipped any characters.
 	return sourcePos() != startPosition;
 }
@@ -280,8 +290,8 @@ Token Scanner::skipSingleLineComment()
 {
 	// Line terminator is not part of the comment. If it is a
 	// non-ascii line terminator, it will result in a parser error.
-	while (!isUnicodeLinebreak())
-		if (!advance()) break;
+	while (!isUnicodeLinebreak() && !isSourcePastEndOfInput())
+		m_char = m_source->setPosition(findLineTerminatorCandidate(source(), sourcePos() + 1));
 
 	return Token::Whitespace;
 }
@@ -356,13 +366,18 @@ Token Scanner::skipMultiLineComment()
 	advance();
 	while (!isSourcePastEndOfInput())
 	{
-		char ch = m_char;
+		if (m_char != '*')
+		{
+			size_t star = source().find('*', sourcePos());
+			m_char = m_source->setPosition(star == string_view::npos ? source().size() : star);
+			continue;
+		}
 		advance();
 
 		// If we have reached the end of the multi-line comment, we
 		// consume the '/' and insert a whitespace. This way all
 		// multi-line comments are treated as whitespace.
-		if (ch == '*' && m_char == '/')
+		if (m_char == '/')
 		{
 			m_char = ' ';
 			return Token::Whitespace;
@@ -833,9 +848,8 @@ void Scanner::scanDecimalDigits()
 		return;
 
 	// May continue with decimal digit or underscore for grouping.
-	do
-		addLiteralCharAndAdvance();
-	while (!m_source->isPastEndOfInput() && (isDecimalDigit(m_char) || m_char == '_'));
+	addLiteralCharAndAdvance();
+	addLiteralCharsAndAdvanceTo(findEndOfDecimalDigits(source(), sourcePos()));
 
 	// Defer further validation of underscore to SyntaxChecker.
 }
@@ -868,8 +882,8 @@ Token Scanner::scanNumber(char _charSeen)
 				if (!isHexDigit(m_char))
 					return setError(ScannerError::IllegalHexDigit); // we must have at least one hex digit after 'x'
 
-				while (isHexDigit(m_char) || m_char == '_') // We keep the underscores for later validation
-					addLiteralCharAndAdvance();
+				// We keep the underscores for later validation
+				addLiteralCharsAndAdvanceTo(findEndOfHexDigits(source(), sourcePos()));
 			}
 			else if (isDecimalDigit(m_char))
 				// We do not allow octal numbers
@@ -940,8 +954,13 @@ tuple<Token, unsigned, unsigned> Scanner::scanIdentifierOrKeyword()
 	LiteralScope literal(this, LITERAL_TYPE_STRING);
 	addLiteralCharAndAdvance();
 	// Scan the rest of the identifier characters.
-	while (isIdentifierPart(m_char) || (m_char == '.' && m_supportPeriodInIdentifier))
+	while (true)
+	{
+		addLiteralCharsAndAdvanceTo(findEndOfIdentifier(source(), sourcePos()));
+		if (m_char != '.' || !m_supportPeriodInIdentifier)
+			break;
 		addLiteralCharAndAdvance();
+	}
 	literal.complete();
 	return TokenTraits::fromIdentifierOrKeyword(m_tokens[NextNext].literal);
 }
@@ -95,7 +95,7 @@ public:
 	explicit Scanner(std::shared_ptr<CharStream> _source) { reset(std::move(_source)); }
 	explicit Scanner(CharStream _source = CharStream()) { reset(std::move(_source)); }
 
-	std::string const& source() const noexcept { return m_source->source(); }
+	std::string_view source() const noexcept { return m_source->source(); }
 
 	std::shared_ptr<CharStream> charStream() noexcept { return m_source; }
 	std::shared_ptr<CharStream const> charStream() const noexcept { return m_source; }
@@ -192,6 +192,8 @@ private:
 	inline void addLiteralChar(char c) { m_tokens[NextNext].literal.push_back(c); }
 	inline void addCommentLiteralChar(char c) { m_skippedComments[NextNext].literal.push_back(c); }
 	inline void addLiteralCharAndAdvance() { addLiteralChar(m_char); advance(); }
+	/// Adds the characters from the current position up to @a _end to the literal and advances to @a _end.
+	void addLiteralCharsAndAdvanceTo(size_t _end);
 	void addUnicodeAsUTF8(unsigned codepoint);
 	///@}
 
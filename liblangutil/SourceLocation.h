@@ -27,6 +27,7 @@
 
 #include <liblangutil/CharStream.h>
 
+#include <limits>
 #include <memory>
 #include <string>
 
@@ -85,7 +86,7 @@ struct SourceLocation
 		assertThrow(0 <= start, SourceLocationError, "Invalid source location.");
 		assertThrow(start <= end, SourceLocationError, "Invalid source location.");
 		assertThrow(end <= int(source->source().length()), SourceLocationError, "Invalid source location.");
-		return source->source().substr(size_t(start), size_t(end - start));
+		return std::string(source->source().substr(size_t(start), size_t(end - start)));
 	}
 
 	/// @returns the smallest SourceLocation that contains both @param _a and @param _b.
@@ -29,6 +29,9 @@ namespace solidity::smtutil
 class CHCSolverInterface
 {
 public:
+	/// @param _queryTimeout time limit in milliseconds for a single call to query(),
+	/// if the solver supports it.
+	explicit CHCSolverInterface(std::optional<unsigned> _queryTimeout = {}): m_queryTimeout(_queryTimeout) {}
 	virtual ~CHCSolverInterface() = default;
 
 	virtual void declareVariable(std::string const& _name, SortPointer const& _sort) = 0;
@@ -45,6 +48,9 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>> query(
 		Expression const& _expr
 	) = 0;
+
+protected:
+	std::optional<unsigned> m_queryTimeout;
 };
 
 }
@@ -19,6 +19,7 @@
 
 #include <libsolutil/CommonIO.h>
 
+#include <cvc4/base/configuration.h>
 #include <cvc4/util/bitvector.h>
 
 using namespace std;
@@ -26,18 +27,26 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::smtutil;
 
-CVC4Interface::CVC4Interface():
+CVC4Interface::CVC4Interface(optional<unsigned> _queryTimeout):
+	SolverInterface(_queryTimeout),
 	m_solver(&m_context)
 {
 	reset();
 }
 
+string CVC4Interface::version()
+{
+	return CVC4::Configuration::getVersionString();
+}
+
 void CVC4Interface::reset()
 {
 	m_variables.clear();
 	m_solver.reset();
 	m_solver.setOption("produce-models", true);
 	m_solver.setResourceLimit(resourceLimit);
+	if (m_queryTimeout)
+		m_solver.setTimeLimit(*m_queryTimeout);
 }
 
 void CVC4Interface::push()
@@ -84,6 +93,7 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 {
 	CheckResult result;
 	vector<string> values;
+	auto start = chrono::steady_clock::now();
 	try
 	{
 		switch (m_solver.checkSat().isSat())
@@ -95,7 +105,7 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 			result = CheckResult::UNSATISFIABLE;
 			break;
 		case CVC4::Result::SAT_UNKNOWN:
-			result = CheckResult::UNKNOWN;
+			result = timeoutResult(CheckResult::UNKNOWN, m_queryTimeout, start);
 			break;
 		default:
 			smtAssert(false, "");
@@ -116,6 +126,18 @@ pair<CheckResult, vector<string>> CVC4Interface::check(vector<Expression> const&
 	return make_pair(result, values);
 }
 
+void CVC4Interface::interrupt()
+{
+	try
+	{
+		m_solver.interrupt();
+	}
+	catch (CVC4::Exception const&)
+	{
+		// Thrown if no check is running.
+	}
+}
+
 CVC4::Expr CVC4Interface::toCVC4Expr(Expression const& _expr)
 {
 	// Variable
@@ -39,7 +39,7 @@ namespace solidity::smtutil
 class CVC4Interface: public SolverInterface, public boost::noncopyable
 {
 public:
-	CVC4Interface();
+	explicit CVC4Interface(std::optional<unsigned> _queryTimeout = {});
 
 	void reset() override;
 
@@ -50,6 +50,10 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
+
+	/// @returns the version of the linked CVC4 library.
+	static std::string version();
 
 private:
 	CVC4::Expr toCVC4Expr(Expression const& _expr);
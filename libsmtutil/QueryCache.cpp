@@ -0,0 +1,134 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Persistent cache for the answers of SMT solvers.
+ */
+
+#include <libsmtutil/QueryCache.h>
+
+#include <libsmtutil/SMTLib2Interface.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::smtutil;
+
+namespace fs = boost::filesystem;
+
+optional<QueryCache::Answer> QueryCache::load(string const& _query) const
+{
+	ifstream file(entryPath(_query).string(), ios::binary);
+	if (!file)
+		return nullopt;
+	stringstream content;
+	content << file.rdbuf();
+
+	Json::Value entry;
+	if (!file || !jsonParseStrict(content.str(), entry) || !entry.isObject())
+		return nullopt;
+	if (!entry["result"].isString() || !entry["values"].isArray())
+		return nullopt;
+
+	Answer answer;
+	if (entry["result"].asString() == "sat")
+		answer.first = CheckResult::SATISFIABLE;
+	else if (entry["result"].asString() == "unsat")
+		answer.first = CheckResult::UNSATISFIABLE;
+	else
+		return nullopt;
+	for (auto const& value: entry["values"])
+	{
+		if (!value.isString())
+			return nullopt;
+		answer.second.push_back(value.asString());
+	}
+	return answer;
+}
+
+void QueryCache::store(string const& _query, Answer const& _answer) const
+{
+	if (_answer.first != CheckResult::SATISFIABLE && _answer.first != CheckResult::UNSATISFIABLE)
+		return;
+
+	Json::Value entry(Json::objectValue);
+	entry["result"] = _answer.first == CheckResult::SATISFIABLE ? "sat" : "unsat";
+	entry["values"] = Json::arrayValue;
+	for (string const& value: _answer.second)
+		entry["values"].append(value);
+
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	writeFileAtomically(entryPath(_query).string(), jsonCompactPrint(entry));
+}
+
+string QueryCache::canonicalQuery(
+	map<string, SortPointer> const& _declarations,
+	vector<Expression> const& _assertions,
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	map<string, string> canonicalNames;
+	vector<pair<string, SortPointer>> usedDeclarations;
+	function<void(Expression&)> rename = [&](Expression& _expr)
+	{
+		// Sort expressions are named after types, not after declared symbols.
+		if (!dynamic_pointer_cast<SortSort>(_expr.sort))
+			if (auto declaration = _declarations.find(_expr.name); declaration != _declarations.end())
+			{
+				auto [name, inserted] = canonicalNames.emplace(_expr.name, "v" + to_string(canonicalNames.size()));
+				if (inserted)
+					usedDeclarations.emplace_back(name->second, declaration->second);
+				_expr.name = name->second;
+			}
+		for (auto& argument: _expr.arguments)
+			rename(argument);
+	};
+
+	vector<Expression> assertions = _assertions;
+	for (auto& assertion: assertions)
+		rename(assertion);
+	vector<Expression> expressionsToEvaluate = _expressionsToEvaluate;
+	for (auto& expression: expressionsToEvaluate)
+		rename(expression);
+
+	static map<h256, string> const noResponses;
+	SMTLib2Interface printer(noResponses, {});
+	for (auto const& [name, sort]: usedDeclarations)
+		printer.declareVariable(name, sort);
+	for (auto const& assertion: assertions)
+		printer.addAssertion(assertion);
+	printer.check(expressionsToEvaluate);
+	smtAssert(printer.unhandledQueries().size() == 1, "");
+	return printer.unhandledQueries().front();
+}
+
+fs::path QueryCache::entryPath(string const& _query) const
+{
+	return m_directory / (keccak256(_query).hex() + ".json");
+}
@@ -0,0 +1,79 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Persistent cache for the answers of SMT solvers.
+ */
+
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace solidity::smtutil
+{
+
+/**
+ * Stores the answers of SMT solvers in a directory, so that later runs of the model checker
+ * do not have to solve the same queries again. Every entry is named after the Keccak-256 hash
+ * of the query text, which has to contain everything that influences the answer, including
+ * the solvers that produced it.
+ *
+ * Only definite answers (satisfiable or unsatisfiable) are stored, since the other results
+ * may change with a higher time limit. Like the compilation cache, the cache never causes
+ * the analysis to fail and can be shared by several compiler processes.
+ */
+class QueryCache
+{
+public:
+	using Answer = std::pair<CheckResult, std::vector<std::string>>;
+
+	explicit QueryCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the answer stored for @a _query or an empty optional if there is no such
+	/// answer or it cannot be read.
+	std::optional<Answer> load(std::string const& _query) const;
+	/// Stores @a _answer for @a _query if it is a definite answer.
+	void store(std::string const& _query, Answer const& _answer) const;
+
+	/// @returns the SMT-LIB2 text of the query that checks @a _assertions and evaluates
+	/// @a _expressionsToEvaluate. Only the symbols of @a _declarations that occur in the query
+	/// are declared, and they are renamed in the order of their first occurrence, so the text
+	/// does not depend on unrelated declarations or on the AST IDs contained in the names.
+	static std::string canonicalQuery(
+		std::map<std::string, SortPointer> const& _declarations,
+		std::vector<Expression> const& _assertions,
+		std::vector<Expression> const& _expressionsToEvaluate
+	);
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(std::string const& _query) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
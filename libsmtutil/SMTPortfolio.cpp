@@ -25,6 +25,11 @@
 #endif
 #include <libsmtutil/SMTLib2Interface.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
@@ -34,36 +39,70 @@ using namespace solidity::smtutil;
 SMTPortfolio::SMTPortfolio(
 	map<h256, string> const& _smtlib2Responses,
 	frontend::ReadCallback::Callback const& _smtCallback,
-	[[maybe_unused]] SMTSolverChoice _enabledSolvers
-)
+	[[maybe_unused]] SMTSolverChoice _enabledSolvers,
+	PortfolioMode _mode,
+	optional<unsigned> _queryTimeout,
+	shared_ptr<QueryCache const> _queryCache
+):
+	SolverInterface(_queryTimeout),
+	m_mode(_mode),
+	m_queryCache(std::move(_queryCache))
 {
 	m_solvers.emplace_back(make_unique<SMTLib2Interface>(_smtlib2Responses, _smtCallback));
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3)
-		m_solvers.emplace_back(make_unique<Z3Interface>());
+	{
+		m_solvers.emplace_back(make_unique<Z3Interface>(m_queryTimeout));
+		m_queryCachePrefix += "; z3 " + Z3Interface::version() + "\n";
+	}
 #endif
 #ifdef HAVE_CVC4
 	if (_enabledSolvers.cvc4)
-		m_solvers.emplace_back(make_unique<CVC4Interface>());
+	{
+		m_solvers.emplace_back(make_unique<CVC4Interface>(m_queryTimeout));
+		m_queryCachePrefix += "; cvc4 " + CVC4Interface::version() + "\n";
+	}
 #endif
+	// Without a linked solver, the answers come from the host, which might not
+	// give the same answer next time.
+	if (m_solvers.size() == 1)
+		m_queryCache.reset();
+	m_queryCachePrefix += "; mode " + portfolioModeToString(m_mode) + "\n";
+	if (m_queryTimeout)
+		m_queryCachePrefix += "; timeout " + to_string(*m_queryTimeout) + "\n";
+	// SMTLib2Interface does not solve anything itself, so threads only pay off
+	// if there are at least two other solvers.
+	if (m_solvers.size() > 2)
+		m_threadPool = make_unique<ThreadPool>(m_solvers.size() - 1);
 }
 
 void SMTPortfolio::reset()
 {
 	for (auto const& s: m_solvers)
 		s->reset();
+	m_declarations.clear();
+	m_assertions.clear();
+	m_scopes.clear();
 }
 
 void SMTPortfolio::push()
 {
 	for (auto const& s: m_solvers)
 		s->push();
+	if (m_queryCache)
+		m_scopes.push_back(m_assertions.size());
 }
 
 void SMTPortfolio::pop()
 {
 	for (auto const& s: m_solvers)
 		s->pop();
+	if (m_queryCache)
+	{
+		smtAssert(!m_scopes.empty(), "");
+		m_assertions.erase(m_assertions.begin() + static_cast<ptrdiff_t>(m_scopes.back()), m_assertions.end());
+		m_scopes.pop_back();
+	}
 }
 
 void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort)
@@ -71,59 +110,107 @@ void SMTPortfolio::declareVariable(string const& _name, SortPointer const& _sort
 	smtAssert(_sort, "");
 	for (auto const& s: m_solvers)
 		s->declareVariable(_name, _sort);
+	if (m_queryCache)
+		m_declarations[_name] = _sort;
 }
 
 void SMTPortfolio::addAssertion(Expression const& _expr)
 {
 	for (auto const& s: m_solvers)
 		s->addAssertion(_expr);
+	if (m_queryCache)
+		m_assertions.push_back(_expr);
 }
 
 /*
  * Broadcasts the SMT query to all solvers and returns a single result.
  * This comment explains how this result is decided.
  *
- * When a solver is queried, there are four possible answers:
- *   SATISFIABLE (SAT), UNSATISFIABLE (UNSAT), UNKNOWN, CONFLICTING, ERROR
+ * When a solver is queried, there are six possible answers:
+ *   SATISFIABLE (SAT), UNSATISFIABLE (UNSAT), UNKNOWN, TIMEOUT, CONFLICTING, ERROR
  * We say that a solver _answered_ the query if it returns either:
  *   SAT or UNSAT
  * A solver did not answer the query if it returns either:
- *   UNKNOWN (it tried but couldn't solve it) or ERROR (crash, internal error, API error, etc).
+ *   UNKNOWN (it tried but couldn't solve it), TIMEOUT (it gave up because of the time limit)
+ *   or ERROR (crash, internal error, API error, etc).
  *
  * Ideally all solvers answer the query and agree on what the answer is
  * (all say SAT or all say UNSAT).
  *
- * The actual logic as as follows:
+ * The solvers run concurrently. In the Verify mode, all solvers finish and the actual logic
+ * is as follows:
  * 1) If at least one solver answers the query, all the non-answer results are ignored.
  *   Here SAT/UNSAT is preferred over UNKNOWN since it's an actual answer, and over ERROR
  *   because one buggy solver/integration shouldn't break the portfolio.
+ *   If several solvers answer, the values are taken from the first one in the order of
+ *   m_solvers, so the result does not depend on which solver was faster.
  *
  * 2) If at least one solver answers SAT and at least one answers UNSAT, at least one of them is buggy
  * and the result is CONFLICTING.
  *   In the future if we have more than 2 solvers enabled we could go with the majority.
  *
  * 3) If NO solver answers the query:
- *   If at least one solver returned UNKNOWN (where the rest returned ERROR), the result is UNKNOWN.
- *   This is preferred over ERROR since the SMTChecker might decide to abstract the query
- *   when it is told that this is a hard query to solve.
+ *   If at least one solver returned UNKNOWN or TIMEOUT (where the rest returned ERROR), the result
+ *   is UNKNOWN or TIMEOUT. This is preferred over ERROR since the SMTChecker might decide to abstract
+ *   the query when it is told that this is a hard query to solve.
+ *   TIMEOUT is preferred over UNKNOWN, since a higher time limit might lead to an answer.
  *
  *   If all solvers return ERROR, the result is ERROR.
+ *
+ * In the Race mode, the first solver that answers the query wins and the other solvers are
+ * interrupted, so the query takes as long as the fastest solver needs. Conflicts are not
+ * detected and the values of a satisfiable query depend on which solver won.
+ * If no solver answers, the result is decided as in 3).
+ *
+ * The query cache stores SAT and UNSAT results together with their values, so a cached
+ * query gets the same result as it got when it was solved.
 */
 pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const& _expressionsToEvaluate)
 {
+	string canonicalQuery;
+	if (m_queryCache)
+	{
+		canonicalQuery = m_queryCachePrefix + QueryCache::canonicalQuery(m_declarations, m_assertions, _expressionsToEvaluate);
+		auto answer = m_queryCache->load(canonicalQuery);
+		if (
+			answer &&
+			(answer->first == CheckResult::UNSATISFIABLE || answer->second.size() == _expressionsToEvaluate.size())
+		)
+		{
+			// SMTLib2Interface still sees the query, so the unhandled queries
+			// do not depend on the cache.
+			m_solvers.front()->check(_expressionsToEvaluate);
+			return *answer;
+		}
+	}
+
+	vector<Result> results;
+	vector<size_t> finishOrder;
+	if (m_threadPool)
+		tie(results, finishOrder) = checkConcurrently(_expressionsToEvaluate);
+	else
+		for (size_t i = 0; i < m_solvers.size(); ++i)
+		{
+			results.emplace_back(m_solvers[i]->check(_expressionsToEvaluate));
+			finishOrder.push_back(i);
+		}
+
+	if (m_mode == PortfolioMode::Verify)
+		sort(finishOrder.begin(), finishOrder.end());
+
 	CheckResult lastResult = CheckResult::ERROR;
 	vector<string> finalValues;
-	for (auto const& s: m_solvers)
+	for (size_t i: finishOrder)
 	{
-		CheckResult result;
-		vector<string> values;
-		tie(result, values) = s->check(_expressionsToEvaluate);
+		auto& [result, values] = results[i];
 		if (solverAnswered(result))
 		{
 			if (!solverAnswered(lastResult))
 			{
 				lastResult = result;
 				finalValues = std::move(values);
+				if (m_mode == PortfolioMode::Race)
+					break;
 			}
 			else if (lastResult != result)
 			{
@@ -131,12 +218,84 @@ pair<CheckResult, vector<string>> SMTPortfolio::check(vector<Expression> const&
 				break;
 			}
 		}
+		else if (result == CheckResult::TIMEOUT && !solverAnswered(lastResult))
+			lastResult = result;
 		else if (result == CheckResult::UNKNOWN && lastResult == CheckResult::ERROR)
 			lastResult = result;
 	}
+	if (m_queryCache)
+		m_queryCache->store(canonicalQuery, {lastResult, finalValues});
 	return make_pair(lastResult, finalValues);
 }
 
+pair<vector<SMTPortfolio::Result>, vector<size_t>> SMTPortfolio::checkConcurrently(
+	vector<Expression> const& _expressionsToEvaluate
+)
+{
+	vector<Result> results(m_solvers.size(), Result{CheckResult::ERROR, {}});
+	vector<size_t> finishOrder;
+	vector<bool> finished(m_solvers.size(), false);
+	bool answered = false;
+	mutex resultsMutex;
+	condition_variable solverFinished;
+
+	auto finish = [&](size_t _index, Result _result)
+	{
+		lock_guard<mutex> lock(resultsMutex);
+		answered = answered || solverAnswered(_result.first);
+		results[_index] = std::move(_result);
+		finished[_index] = true;
+		finishOrder.push_back(_index);
+		solverFinished.notify_all();
+	};
+	auto check = [&](size_t _index)
+	{
+		try
+		{
+			finish(_index, m_solvers[_index]->check(_expressionsToEvaluate));
+		}
+		catch (...)
+		{
+			finish(_index, Result{CheckResult::ERROR, {}});
+			throw;
+		}
+	};
+
+	for (size_t i = 1; i < m_solvers.size(); ++i)
+		m_threadPool->post([&, i]() { check(i); });
+	// SMTLib2Interface may call back into the host, so it has to run on this thread.
+	try
+	{
+		check(0);
+	}
+	catch (...)
+	{
+		m_threadPool->wait();
+		throw;
+	}
+
+	if (m_mode == PortfolioMode::Race)
+	{
+		unique_lock<mutex> lock(resultsMutex);
+		while (finishOrder.size() < m_solvers.size())
+			if (answered)
+			{
+				// A solver that has not started its check yet ignores the interrupt,
+				// so interrupt repeatedly until all solvers have finished.
+				for (size_t i = 0; i < m_solvers.size(); ++i)
+					if (!finished[i])
+						m_solvers[i]->interrupt();
+				solverFinished.wait_for(lock, chrono::milliseconds(10));
+			}
+			else
+				solverFinished.wait(lock);
+	}
+	// The solvers must not be used for the next command before all checks have returned.
+	m_threadPool->wait();
+
+	return {std::move(results), std::move(finishOrder)};
+}
+
 vector<string> SMTPortfolio::unhandledQueries()
 {
 	// This code assumes that the constructor guarantees that
@@ -18,12 +18,16 @@
 #pragma once
 
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolutil/FixedHash.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/noncopyable.hpp>
 #include <map>
+#include <memory>
+#include <optional>
 #include <vector>
 
 namespace solidity::smtutil
@@ -32,8 +36,11 @@ namespace solidity::smtutil
 /**
  * The SMTPortfolio wraps all available solvers within a single interface,
  * propagating the functionalities to all solvers.
- * It also checks whether different solvers give conflicting answers
- * to SMT queries.
+ * The solvers that are linked into the binary check each query concurrently.
+ * Depending on the mode, the portfolio either waits for all of them and checks
+ * whether they give conflicting answers, or uses the first answer.
+ * If a query cache is given, definite answers are stored in it and the solvers
+ * are not run for queries whose answer is found there.
  */
 class SMTPortfolio: public SolverInterface, public boost::noncopyable
 {
@@ -41,7 +48,10 @@ public:
 	SMTPortfolio(
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		frontend::ReadCallback::Callback const& _smtCallback,
-		SMTSolverChoice _enabledSolvers
+		SMTSolverChoice _enabledSolvers,
+		PortfolioMode _mode = PortfolioMode::Verify,
+		std::optional<unsigned> _queryTimeout = {},
+		std::shared_ptr<QueryCache const> _queryCache = nullptr
 	);
 
 	void reset() override;
@@ -58,11 +68,29 @@ public:
 	std::vector<std::string> unhandledQueries() override;
 	unsigned solvers() override { return m_solvers.size(); }
 private:
+	using Result = std::pair<CheckResult, std::vector<std::string>>;
+
+	/// Runs the check of every solver, all but the first one on the thread pool.
+	/// @returns the results in the order of the solvers and the indices of the solvers
+	/// in the order in which they finished.
+	std::pair<std::vector<Result>, std::vector<size_t>> checkConcurrently(std::vector<Expression> const& _expressionsToEvaluate);
+
 	static bool solverAnswered(CheckResult result);
 
 	std::vector<std::unique_ptr<SolverInterface>> m_solvers;
-
+	PortfolioMode m_mode;
+	/// Runs the solvers apart from SMTLib2Interface if there are several of them.
+	std::unique_ptr<util::ThreadPool> m_threadPool;
+
+	/// Answers of earlier runs. Only used if a solver is linked into the binary.
+	std::shared_ptr<QueryCache const> m_queryCache;
+	/// Describes the solvers and their settings, since the answers depend on them.
+	std::string m_queryCachePrefix;
+	/// The declarations and the assertions of all scopes, tracked to build the canonical
+	/// query for the cache.
+	std::map<std::string, SortPointer> m_declarations;
 	std::vector<Expression> m_assertions;
+	std::vector<size_t> m_scopes;
 };
 
 }
@@ -23,9 +23,11 @@
 #include <libsolutil/Common.h>
 
 #include <boost/noncopyable.hpp>
+#include <chrono>
 #include <cstdio>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -47,11 +49,50 @@ struct SMTSolverChoice
 	bool all() { return cvc4 && z3; }
 };
 
+/// How the answers of several solvers are combined into the result of a query.
+enum class PortfolioMode
+{
+	Verify, // wait for all solvers, report a conflict if they disagree
+	Race // use the first answer, interrupt the remaining solvers
+};
+
+inline std::string portfolioModeToString(PortfolioMode _mode)
+{
+	switch (_mode)
+	{
+	case PortfolioMode::Verify: return "verify";
+	case PortfolioMode::Race: return "race";
+	}
+	// Cannot reach this.
+	return "INVALID";
+}
+
+inline std::optional<PortfolioMode> portfolioModeFromString(std::string const& _mode)
+{
+	for (auto i: {PortfolioMode::Verify, PortfolioMode::Race})
+		if (portfolioModeToString(i) == _mode)
+			return i;
+	return std::nullopt;
+}
+
 enum class CheckResult
 {
-	SATISFIABLE, UNSATISFIABLE, UNKNOWN, CONFLICTING, ERROR
+	SATISFIABLE, UNSATISFIABLE, UNKNOWN, TIMEOUT, CONFLICTING, ERROR
 };
 
+/// @returns TIMEOUT if the solver gave up on a query that was started at @a _start
+/// and ran into the time limit @a _timeout (in milliseconds), otherwise @a _result.
+inline CheckResult timeoutResult(
+	CheckResult _result,
+	std::optional<unsigned> _timeout,
+	std::chrono::steady_clock::time_point _start
+)
+{
+	if (_result == CheckResult::UNKNOWN && _timeout && std::chrono::steady_clock::now() - _start >= std::chrono::milliseconds(*_timeout))
+		return CheckResult::TIMEOUT;
+	return _result;
+}
+
 /// C++ representation of an SMTLIB2 expression.
 class Expression
 {
@@ -320,6 +361,9 @@ DEV_SIMPLE_EXCEPTION(SolverError);
 class SolverInterface
 {
 public:
+	/// @param _queryTimeout time limit in milliseconds for a single call to check(),
+	/// if the solver supports it.
+	explicit SolverInterface(std::optional<unsigned> _queryTimeout = {}): m_queryTimeout(_queryTimeout) {}
 	virtual ~SolverInterface() = default;
 	virtual void reset() = 0;
 
@@ -342,11 +386,18 @@ public:
 	virtual std::pair<CheckResult, std::vector<std::string>>
 	check(std::vector<Expression> const& _expressionsToEvaluate) = 0;
 
+	/// Aborts a call to check() that is running on a different thread, which then returns UNKNOWN.
+	/// Has no effect if no check is running. Solvers that cannot be interrupted ignore this.
+	virtual void interrupt() {}
+
 	/// @returns a list of queries that the system was not able to respond to.
 	virtual std::vector<std::string> unhandledQueries() { return {}; }
 
 	/// @returns how many SMT solvers this interface has.
 	virtual unsigned solvers() { return 1; }
+
+protected:
+	std::optional<unsigned> m_queryTimeout;
 };
 
 }
@@ -23,10 +23,12 @@ using namespace std;
 using namespace solidity;
 using namespace solidity::smtutil;
 
-Z3CHCInterface::Z3CHCInterface():
-	m_z3Interface(make_unique<Z3Interface>()),
+Z3CHCInterface::Z3CHCInterface(optional<unsigned> _queryTimeout, shared_ptr<QueryCache const> _queryCache):
+	CHCSolverInterface(_queryTimeout),
+	m_z3Interface(make_unique<Z3Interface>(m_queryTimeout)),
 	m_context(m_z3Interface->context()),
-	m_solver(*m_context)
+	m_solver(*m_context),
+	m_queryCache(std::move(_queryCache))
 {
 	// These need to be set globally.
 	z3::set_param("rewriter.pull_cheap_ite", true);
@@ -42,6 +44,8 @@ Z3CHCInterface::Z3CHCInterface():
 	p.set("fp.spacer.mbqi", false);
 	// Ground pobs by using values from a model.
 	p.set("fp.spacer.ground_pobs", false);
+	if (m_queryTimeout)
+		p.set("timeout", *m_queryTimeout);
 	m_solver.set(p);
 }
 
@@ -49,6 +53,8 @@ void Z3CHCInterface::declareVariable(string const& _name, SortPointer const& _so
 {
 	smtAssert(_sort, "");
 	m_z3Interface->declareVariable(_name, _sort);
+	if (m_queryCache)
+		m_declarations[_name] = _sort;
 }
 
 void Z3CHCInterface::registerRelation(Expression const& _expr)
@@ -59,6 +65,8 @@ void Z3CHCInterface::registerRelation(Expression const& _expr)
 void Z3CHCInterface::addRule(Expression const& _expr, string const& _name)
 {
 	z3::expr rule = m_z3Interface->toZ3Expr(_expr);
+	if (m_queryCache)
+		m_rules.push_back(_expr);
 	if (m_z3Interface->constants().empty())
 		m_solver.add_rule(rule, m_context->str_symbol(_name.c_str()));
 	else
@@ -75,9 +83,24 @@ pair<CheckResult, vector<string>> Z3CHCInterface::query(Expression const& _expr)
 {
 	CheckResult result;
 	vector<string> values;
+	auto start = chrono::steady_clock::now();
 	try
 	{
 		z3::expr z3Expr = m_z3Interface->toZ3Expr(_expr);
+		string cacheQuery;
+		if (m_queryCache)
+		{
+			// The rules are universally quantified over their free variables and the query
+			// is the last assertion. Rule names do not influence the answer.
+			vector<Expression> assertions = m_rules;
+			assertions.push_back(_expr);
+			cacheQuery = "; z3 " + Z3Interface::version() + "\n; chc\n";
+			if (m_queryTimeout)
+				cacheQuery += "; timeout " + to_string(*m_queryTimeout) + "\n";
+			cacheQuery += QueryCache::canonicalQuery(m_declarations, assertions, {});
+			if (auto answer = m_queryCache->load(cacheQuery))
+				return *answer;
+		}
 		switch (m_solver.query(z3Expr))
 		{
 		case z3::check_result::sat:
@@ -94,11 +117,13 @@ pair<CheckResult, vector<string>> Z3CHCInterface::query(Expression const& _expr)
 		}
 		case z3::check_result::unknown:
 		{
-			result = CheckResult::UNKNOWN;
+			result = timeoutResult(CheckResult::UNKNOWN, m_queryTimeout, start);
 			break;
 		}
 		}
 		// TODO retrieve model / invariants
+		if (m_queryCache)
+			m_queryCache->store(cacheQuery, {result, values});
 	}
 	catch (z3::exception const&)
 	{
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/Z3Interface.h>
 
 namespace solidity::smtutil
@@ -30,7 +31,10 @@ namespace solidity::smtutil
 class Z3CHCInterface: public CHCSolverInterface
 {
 public:
-	Z3CHCInterface();
+	explicit Z3CHCInterface(
+		std::optional<unsigned> _queryTimeout = {},
+		std::shared_ptr<QueryCache const> _queryCache = nullptr
+	);
 
 	/// Forwards variable declaration to Z3Interface.
 	void declareVariable(std::string const& _name, SortPointer const& _sort) override;
@@ -50,6 +54,12 @@ private:
 	z3::context* m_context;
 	// Horn solver.
 	z3::fixedpoint m_solver;
+
+	/// Answers of earlier runs, keyed by the canonical text of the rules together with the query.
+	std::shared_ptr<QueryCache const> m_queryCache;
+	/// The declarations and the rules, tracked to build the canonical text if there is a cache.
+	std::map<std::string, SortPointer> m_declarations;
+	std::vector<Expression> m_rules;
 };
 
 }
@@ -22,12 +22,26 @@
 using namespace std;
 using namespace solidity::smtutil;
 
-Z3Interface::Z3Interface():
+Z3Interface::Z3Interface(optional<unsigned> _queryTimeout):
+	SolverInterface(_queryTimeout),
 	m_solver(m_context)
 {
 	// These need to be set globally.
 	z3::set_param("rewriter.pull_cheap_ite", true);
 	z3::set_param("rlimit", resourceLimit);
+
+	if (m_queryTimeout)
+		m_solver.set("timeout", *m_queryTimeout);
+}
+
+string Z3Interface::version()
+{
+	unsigned major = 0;
+	unsigned minor = 0;
+	unsigned build = 0;
+	unsigned revision = 0;
+	Z3_get_version(&major, &minor, &build, &revision);
+	return to_string(major) + "." + to_string(minor) + "." + to_string(build) + "." + to_string(revision);
 }
 
 void Z3Interface::reset()
@@ -77,6 +91,7 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 {
 	CheckResult result;
 	vector<string> values;
+	auto start = chrono::steady_clock::now();
 	try
 	{
 		switch (m_solver.check())
@@ -88,7 +103,7 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 			result = CheckResult::UNSATISFIABLE;
 			break;
 		case z3::check_result::unknown:
-			result = CheckResult::UNKNOWN;
+			result = timeoutResult(CheckResult::UNKNOWN, m_queryTimeout, start);
 			break;
 		}
 
@@ -108,6 +123,12 @@ pair<CheckResult, vector<string>> Z3Interface::check(vector<Expression> const& _
 	return make_pair(result, values);
 }
 
+void Z3Interface::interrupt()
+{
+	// Z3 ignores interrupts while no check is running, so this cannot affect later checks.
+	m_context.interrupt();
+}
+
 z3::expr Z3Interface::toZ3Expr(Expression const& _expr)
 {
 	if (_expr.arguments.empty() && m_constants.count(_expr.name))
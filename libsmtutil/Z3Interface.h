@@ -27,7 +27,7 @@ namespace solidity::smtutil
 class Z3Interface: public SolverInterface, public boost::noncopyable
 {
 public:
-	Z3Interface();
+	explicit Z3Interface(std::optional<unsigned> _queryTimeout = {});
 
 	void reset() override;
 
@@ -38,6 +38,7 @@ public:
 
 	void addAssertion(Expression const& _expr) override;
 	std::pair<CheckResult, std::vector<std::string>> check(std::vector<Expression> const& _expressionsToEvaluate) override;
+	void interrupt() override;
 
 	z3::expr toZ3Expr(Expression const& _expr);
 
@@ -46,6 +47,9 @@ public:
 
 	z3::context* context() { return &m_context; }
 
+	/// @returns the version of the linked Z3 library.
+	static std::string version();
+
 	// Z3 "basic resources" limit.
 	// This is used to make the runs more deterministic and platform/machine independent.
 	// The tests start failing for Z3 with less than 20000000,
@@ -136,10 +136,13 @@ bool ViewPureChecker::check()
 		contracts += source->filteredNodes<ContractDefinition>(source->nodes());
 	}
 
-	// Check modifiers first to infer their state mutability.
+	// Check modifiers first to infer their state mutability. This includes the modifiers
+	// of base contracts that are not part of the checked sources.
 	for (auto const& contract: contracts)
-		for (ModifierDefinition const* mod: contract->functionModifiers())
-			mod->accept(*this);
+		for (ContractDefinition const* base: contract->annotation().linearizedBaseContracts)
+			for (ModifierDefinition const* mod: base->functionModifiers())
+				if (!m_inferredMutability.count(mod))
+					mod->accept(*this);
 
 	for (auto const& contract: contracts)
 		contract->accept(*this);
@@ -154,6 +154,8 @@ private:
 	/// filepath to AST
 	std::map<std::string, ASTPointer<SourceUnit>> m_sourceUnits;
 	std::string m_currentSourceName;
+	/// Character stream shared by all source locations of the current source, only its name is set.
+	std::shared_ptr<langutil::CharStream> m_currentSource;
 	/// IDs already used by the nodes
 	std::set<int64_t> m_usedIDs;
 	/// Configured EVM version
@@ -46,18 +46,21 @@ SourceLocation const AsmJsonImporter::createSourceLocation(Json::Value const& _n
 {
 	astAssert(member(_node, "src").isString(), "'src' must be a string");
 
-	return solidity::langutil::parseSourceLocation(_node["src"].asString(), m_sourceName);
+	SourceLocation location = solidity::langutil::parseSourceLocation(_node["src"].asString(), m_source->name());
+	location.source = m_source;
+	return location;
 }
 
 template <class T>
 T AsmJsonImporter::createAsmNode(Json::Value const& _node)
 {
 	T r;
-	r.location = createSourceLocation(_node);
+	SourceLocation location = createSourceLocation(_node);
 	astAssert(
-		r.location.source && 0 <= r.location.start && r.location.start <= r.location.end,
+		location.source && 0 <= location.start && location.start <= location.end,
 		"Invalid source location in Asm AST"
 	);
+	r.location = location;
 	return r;
 }
 
@@ -37,7 +37,9 @@ namespace solidity::frontend
 class AsmJsonImporter
 {
 public:
-	explicit AsmJsonImporter(std::string _sourceName) : m_sourceName(std::move(_sourceName)) {}
+	/// @param _source character stream of the surrounding source, which has to outlive the
+	/// imported nodes, since their source locations only refer to it by index.
+	explicit AsmJsonImporter(std::shared_ptr<langutil::CharStream> _source): m_source(std::move(_source)) {}
 	yul::Block createBlock(Json::Value const& _node);
 
 private:
@@ -69,7 +71,7 @@ private:
 	yul::Break createBreak(Json::Value const& _node);
 	yul::Continue createContinue(Json::Value const& _node);
 
-	std::string m_sourceName;
+	std::shared_ptr<langutil::CharStream> m_source;
 
 };
 
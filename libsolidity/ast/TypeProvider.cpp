@@ -199,8 +199,12 @@ void TypeProvider::reset()
 template <typename T, typename... Args>
 inline T const* TypeProvider::createAndGet(Args&& ... _args)
 {
-	instance().m_generalTypes.emplace_back(make_unique<T>(std::forward<Args>(_args)...));
-	return static_cast<T const*>(instance().m_generalTypes.back().get());
+	auto type = make_unique<T>(std::forward<Args>(_args)...);
+	T const* result = type.get();
+
+	lock_guard<mutex> lock(instance().m_mutex);
+	instance().m_generalTypes.emplace_back(move(type));
+	return result;
 }
 
 Type const* TypeProvider::fromElementaryTypeName(ElementaryTypeNameToken const& _type, std::optional<StateMutability> _stateMutability)
@@ -305,6 +309,7 @@ TypePointer TypeProvider::fromElementaryTypeName(string const& _name)
 
 ArrayType const* TypeProvider::bytesStorage()
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	if (!m_bytesStorage)
 		m_bytesStorage = make_unique<ArrayType>(DataLocation::Storage, false);
 	return m_bytesStorage.get();
@@ -312,6 +317,7 @@ ArrayType const* TypeProvider::bytesStorage()
 
 ArrayType const* TypeProvider::bytesMemory()
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	if (!m_bytesMemory)
 		m_bytesMemory = make_unique<ArrayType>(DataLocation::Memory, false);
 	return m_bytesMemory.get();
@@ -319,6 +325,7 @@ ArrayType const* TypeProvider::bytesMemory()
 
 ArrayType const* TypeProvider::bytesCalldata()
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	if (!m_bytesCalldata)
 		m_bytesCalldata = make_unique<ArrayType>(DataLocation::CallData, false);
 	return m_bytesCalldata.get();
@@ -326,6 +333,7 @@ ArrayType const* TypeProvider::bytesCalldata()
 
 ArrayType const* TypeProvider::stringStorage()
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	if (!m_stringStorage)
 		m_stringStorage = make_unique<ArrayType>(DataLocation::Storage, true);
 	return m_stringStorage.get();
@@ -333,6 +341,7 @@ ArrayType const* TypeProvider::stringStorage()
 
 ArrayType const* TypeProvider::stringMemory()
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	if (!m_stringMemory)
 		m_stringMemory = make_unique<ArrayType>(DataLocation::Memory, true);
 	return m_stringMemory.get();
@@ -376,6 +385,7 @@ RationalNumberType const* TypeProvider::rationalNumber(Literal const& _literal)
 
 StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	auto i = instance().m_stringLiteralTypes.find(literal);
 	if (i != instance().m_stringLiteralTypes.end())
 		return i->second.get();
@@ -385,6 +395,7 @@ StringLiteralType const* TypeProvider::stringLiteral(string const& literal)
 
 FixedPointType const* TypeProvider::fixedPoint(unsigned m, unsigned n, FixedPointType::Modifier _modifier)
 {
+	lock_guard<mutex> lock(instance().m_mutex);
 	auto& map = _modifier == FixedPointType::Modifier::Unsigned ? instance().m_ufixedMxN : instance().m_fixedMxN;
 
 	auto i = map.find(make_pair(m, n));
@@ -410,8 +421,12 @@ ReferenceType const* TypeProvider::withLocation(ReferenceType const* _type, Data
 	if (_type->location() == _location && _type->isPointer() == _isPointer)
 		return _type;
 
-	instance().m_generalTypes.emplace_back(_type->copyForLocation(_location, _isPointer));
-	return static_cast<ReferenceType const*>(instance().m_generalTypes.back().get());
+	unique_ptr<ReferenceType> type = _type->copyForLocation(_location, _isPointer);
+	ReferenceType const* result = type.get();
+
+	lock_guard<mutex> lock(instance().m_mutex);
+	instance().m_generalTypes.emplace_back(move(type));
+	return result;
 }
 
 FunctionType const* TypeProvider::function(FunctionDefinition const& _function, FunctionType::Kind _kind)
@@ -22,6 +22,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
 
@@ -36,6 +37,9 @@ namespace solidity::frontend
  *
  * It is not recommended to explicitly instantiate types unless you really know what and why
  * you are doing it.
+ *
+ * Types can be requested from several threads concurrently, but reset() must only be called
+ * while no other thread uses the provider.
  */
 class TypeProvider
 {
@@ -230,6 +234,8 @@ private:
 	std::map<std::pair<unsigned, unsigned>, std::unique_ptr<FixedPointType>> m_fixedMxN{};
 	std::map<std::string, std::unique_ptr<StringLiteralType>> m_stringLiteralTypes{};
 	std::vector<std::unique_ptr<Type>> m_generalTypes{};
+	/// Guards the containers above and the lazily created string and bytes types.
+	std::mutex m_mutex;
 };
 
 }
@@ -43,6 +43,7 @@
 #include <boost/range/algorithm/copy.hpp>
 
 #include <limits>
+#include <mutex>
 #include <utility>
 
 using namespace std;
@@ -313,6 +314,7 @@ TypePointer Type::commonType(Type const* _a, Type const* _b)
 
 MemberList const& Type::members(ContractDefinition const* _currentScope) const
 {
+	lock_guard<recursive_mutex> lock(util::lazyInitMutex());
 	if (!m_members[_currentScope])
 	{
 		MemberList::MemberMap members = nativeMembers(_currentScope);
@@ -1908,6 +1910,7 @@ TypePointer ArrayType::decodingType() const
 
 TypeResult ArrayType::interfaceType(bool _inLibrary) const
 {
+	lock_guard<recursive_mutex> lock(util::lazyInitMutex());
 	if (_inLibrary && m_interfaceType_library.has_value())
 		return *m_interfaceType_library;
 
@@ -2076,6 +2079,7 @@ MemberList::MemberMap ContractType::nativeMembers(ContractDefinition const* _con
 
 FunctionType const* ContractType::newExpressionType() const
 {
+	lock_guard<recursive_mutex> lock(util::lazyInitMutex());
 	if (!m_constructorType)
 		m_constructorType = FunctionType::newExpressionType(m_contract);
 	return m_constructorType;
@@ -2263,6 +2267,7 @@ MemberList::MemberMap StructType::nativeMembers(ContractDefinition const*) const
 
 TypeResult StructType::interfaceType(bool _inLibrary) const
 {
+	lock_guard<recursive_mutex> lock(util::lazyInitMutex());
 	if (!_inLibrary)
 	{
 		if (!m_interfaceType.has_value())
@@ -275,24 +275,20 @@ public:
 	/// - Each named stack item is typed and contributes the stack slots given by the stack items of its type.
 	std::vector<std::tuple<std::string, TypePointer>> const& stackItems() const
 	{
-		if (!m_stackItems)
-			m_stackItems = makeStackItems();
-		return *m_stackItems;
+		return m_stackItems.init([&]{ return makeStackItems(); });
 	}
 	/// Total number of stack slots occupied by this type. This is the sum of ``sizeOnStack`` of all ``stackItems()``.
 	unsigned sizeOnStack() const
 	{
-		if (!m_stackSize)
-		{
+		return unsigned(m_stackSize.init([&]{
 			size_t sizeOnStack = 0;
 			for (auto const& slot: stackItems())
 				if (std::get<1>(slot))
 					sizeOnStack += std::get<1>(slot)->sizeOnStack();
 				else
 					++sizeOnStack;
-			m_stackSize = sizeOnStack;
-		}
-		return *m_stackSize;
+			return sizeOnStack;
+		}));
 	}
 	/// If it is possible to initialize such a value in memory by just writing zeros
 	/// of the size memoryHeadSize().
@@ -380,8 +376,8 @@ protected:
 
 	/// List of member types (parameterised by scape), will be lazy-initialized.
 	mutable std::map<ContractDefinition const*, std::unique_ptr<MemberList>> m_members;
-	mutable std::optional<std::vector<std::tuple<std::string, TypePointer>>> m_stackItems;
-	mutable std::optional<size_t> m_stackSize;
+	mutable util::LazyInit<std::vector<std::tuple<std::string, TypePointer>>> m_stackItems;
+	mutable util::LazyInit<size_t> m_stackSize;
 };
 
 /**
@@ -24,6 +24,7 @@
 
 #include <libsolidity/codegen/ContractCompiler.h>
 #include <libevmasm/Assembly.h>
+#include <libsolutil/Profiler.h>
 
 using namespace std;
 using namespace solidity;
@@ -35,6 +36,7 @@ void Compiler::compileContract(
 	bytes const& _metadata
 )
 {
+	util::ScopedTimer timer(m_profiler, "Code generation", _contract.fullyQualifiedName());
 	ContractCompiler runtimeCompiler(nullptr, m_runtimeContext, m_optimiserSettings);
 	runtimeCompiler.compileContract(_contract, _otherCompilers);
 	m_runtimeContext.appendAuxiliaryData(_metadata);
@@ -48,6 +50,7 @@ void Compiler::compileContract(
 	ContractCompiler creationCompiler(&runtimeCompiler, m_context, creationSettings);
 	m_runtimeSub = creationCompiler.compileConstructor(_contract, _otherCompilers);
 
+	timer.next("EVM assembly optimiser", _contract.fullyQualifiedName());
 	m_context.optimise(m_optimiserSettings);
 
 	solAssert(m_context.requestedYulFunctionsRan(), "requestedYulFunctions() was not called.");
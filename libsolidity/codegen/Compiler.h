@@ -30,6 +30,11 @@
 #include <functional>
 #include <ostream>
 
+namespace solidity::util
+{
+class Profiler;
+}
+
 namespace solidity::frontend {
 
 class Compiler
@@ -41,6 +46,16 @@ public:
 		m_context(_evmVersion, _revertStrings, &m_runtimeContext)
 	{ }
 
+	/// Adds statistics about the runs of the Yul optimiser steps to @a _profile.
+	void setOptimiserProfile(yul::OptimiserProfile* _profile)
+	{
+		m_runtimeContext.setOptimiserProfile(_profile);
+		m_context.setOptimiserProfile(_profile);
+	}
+
+	/// Records the time taken by code generation and the assembly optimiser in @a _profiler.
+	void setProfiler(util::Profiler* _profiler) { m_profiler = _profiler; }
+
 	/// Compiles a contract.
 	/// @arg _metadata contains the to be injected metadata CBOR
 	void compileContract(
@@ -79,6 +94,7 @@ public:
 
 private:
 	OptimiserSettings const m_optimiserSettings;
+	util::Profiler* m_profiler = nullptr;
 	CompilerContext m_runtimeContext;
 	size_t m_runtimeSub = size_t(-1); ///< Identifier of the runtime sub-assembly, if present.
 	CompilerContext m_context;
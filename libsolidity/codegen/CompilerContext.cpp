@@ -511,7 +511,9 @@ void CompilerContext::optimizeYul(yul::Object& _object, yul::EVMDialect const& _
 		_object,
 		_optimiserSettings.optimizeStackAllocation,
 		_optimiserSettings.yulOptimiserSteps,
-		_externalIdentifiers
+		_externalIdentifiers,
+		nullptr,
+		m_optimiserProfile
 	);
 
 #ifdef SOL_OUTPUT_ASM
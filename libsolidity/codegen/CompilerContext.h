@@ -38,6 +38,7 @@
 
 #include <libyul/AsmAnalysisInfo.h>
 #include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 
 #include <functional>
 #include <ostream>
@@ -264,6 +265,8 @@ public:
 	std::string revertReasonIfDebug(std::string const& _message = "");
 
 	void optimizeYul(yul::Object& _object, yul::EVMDialect const& _dialect, OptimiserSettings const& _optimiserSetting, std::set<yul::YulString> const& _externalIdentifiers = {});
+	/// Adds statistics about the optimiser steps run by optimizeYul to @a _profile if it is not null.
+	void setOptimiserProfile(yul::OptimiserProfile* _profile) { m_optimiserProfile = _profile; }
 
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendAuxiliaryData(bytes const& _data) { m_asm->appendAuxiliaryDataToEnd(_data); }
@@ -392,6 +395,8 @@ private:
 	std::queue<std::tuple<std::string, unsigned, unsigned, std::function<void(CompilerContext&)>>> m_lowLevelFunctionGenerationQueue;
 	/// Flag to check that requestedYulFunctions() was called exactly once
 	bool m_requestedYulFunctionsRan = false;
+	/// Statistics about the runs of the Yul optimiser steps, not collected if null.
+	yul::OptimiserProfile* m_optimiserProfile = nullptr;
 };
 
 }
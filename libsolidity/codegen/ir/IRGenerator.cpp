@@ -30,7 +30,9 @@
 #include <libsolidity/codegen/CompilerUtils.h>
 
 #include <libyul/AssemblyStack.h>
+#include <libyul/Object.h>
 #include <libyul/Utilities.h>
+#include <libyul/backends/evm/EVMDialect.h>
 
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Whiskers.h>
@@ -47,7 +49,20 @@ using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::frontend;
 
-pair<string, string> IRGenerator::run(
+namespace
+{
+
+string const irWarning =
+	"/*******************************************************\n"
+	" *                       WARNING                       *\n"
+	" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
+	" *       It can result in LOSS OF FUNDS or worse       *\n"
+	" *                !USE AT YOUR OWN RISK!               *\n"
+	" *******************************************************/\n\n";
+
+}
+
+pair<string, shared_ptr<yul::Object>> IRGenerator::run(
 	ContractDefinition const& _contract,
 	map<ContractDefinition const*, string const> const& _otherYulSources
 )
@@ -62,17 +77,21 @@ pair<string, string> IRGenerator::run(
 			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(*error);
 		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
+	asmStack.enableOptimiserProfile(m_optimiserProfile != nullptr);
+	asmStack.setParallelism(m_parallelism);
 	asmStack.optimize();
+	if (m_optimiserProfile)
+		m_optimiserProfile->merge(asmStack.optimiserProfile());
 
-	string warning =
-		"/*******************************************************\n"
-		" *                       WARNING                       *\n"
-		" *  Solidity to Yul compilation is still EXPERIMENTAL  *\n"
-		" *       It can result in LOSS OF FUNDS or worse       *\n"
-		" *                !USE AT YOUR OWN RISK!               *\n"
-		" *******************************************************/\n\n";
+	return {irWarning + ir, asmStack.parserResult()};
+}
 
-	return {warning + ir, warning + asmStack.print()};
+string IRGenerator::print(yul::Object const& _object, langutil::EVMVersion _evmVersion)
+{
+	return
+		irWarning +
+		_object.toString(&yul::EVMDialect::strictAssemblyForEVMObjects(_evmVersion)) +
+		"\n";
 }
 
 string IRGenerator::generate(
@@ -27,8 +27,16 @@
 #include <libsolidity/codegen/ir/IRGenerationContext.h>
 #include <libsolidity/codegen/YulUtilFunctions.h>
 #include <liblangutil/EVMVersion.h>
+
+#include <memory>
 #include <string>
 
+namespace solidity::yul
+{
+struct Object;
+struct OptimiserProfile;
+}
+
 namespace solidity::frontend
 {
 
@@ -40,21 +48,29 @@ public:
 	IRGenerator(
 		langutil::EVMVersion _evmVersion,
 		RevertStrings _revertStrings,
-		OptimiserSettings _optimiserSettings
+		OptimiserSettings _optimiserSettings,
+		yul::OptimiserProfile* _optimiserProfile = nullptr,
+		size_t _parallelism = 1
 	):
 		m_evmVersion(_evmVersion),
 		m_optimiserSettings(_optimiserSettings),
+		m_optimiserProfile(_optimiserProfile),
+		m_parallelism(_parallelism),
 		m_context(_evmVersion, _revertStrings, std::move(_optimiserSettings)),
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
-	/// Generates and returns the IR code, in unoptimized and optimized form
-	/// (or just pretty-printed, depending on the optimizer settings).
-	std::pair<std::string, std::string> run(
+	/// Generates and returns the IR code in unoptimized form, together with the analyzed
+	/// Yul object after running the optimizer on it (depending on the optimizer settings).
+	/// The object can be handed on to an AssemblyStack without printing and re-parsing it.
+	std::pair<std::string, std::shared_ptr<yul::Object>> run(
 		ContractDefinition const& _contract,
 		std::map<ContractDefinition const*, std::string const> const& _otherYulSources
 	);
 
+	/// @returns the text representation of an object returned by @a run.
+	static std::string print(yul::Object const& _object, langutil::EVMVersion _evmVersion);
+
 private:
 	std::string generate(
 		ContractDefinition const& _contract,
@@ -105,6 +121,10 @@ private:
 
 	langutil::EVMVersion const m_evmVersion;
 	OptimiserSettings const m_optimiserSettings;
+	/// Statistics about the runs of the Yul optimiser steps, not collected if null.
+	yul::OptimiserProfile* m_optimiserProfile = nullptr;
+	/// Maximum number of threads used to optimise the IR.
+	size_t const m_parallelism = 1;
 
 	IRGenerationContext m_context;
 	YulUtilFunctions m_utils;
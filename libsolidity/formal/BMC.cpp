@@ -22,23 +22,106 @@
 
 #include <libsmtutil/SMTPortfolio.h>
 
+#include <atomic>
+#include <mutex>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::util;
 using namespace solidity::langutil;
 using namespace solidity::frontend;
 
+namespace
+{
+
+/// Solver that forwards everything to a main solver and also records the declarations of
+/// variables, so that they can be declared in other solvers, which only check self-contained queries.
+class DeclarationRecorder: public smtutil::SolverInterface
+{
+public:
+	DeclarationRecorder(
+		smtutil::SolverInterface& _main,
+		map<string, smtutil::SortPointer>& _declarations
+	):
+		m_main(_main),
+		m_declarations(_declarations)
+	{}
+
+	void reset() override
+	{
+		m_main.reset();
+		m_declarations.clear();
+	}
+
+	void push() override { m_main.push(); }
+	void pop() override { m_main.pop(); }
+
+	void declareVariable(string const& _name, smtutil::SortPointer const& _sort) override
+	{
+		m_main.declareVariable(_name, _sort);
+		m_declarations[_name] = _sort;
+	}
+
+	void addAssertion(smtutil::Expression const& _expr) override { m_main.addAssertion(_expr); }
+
+	pair<smtutil::CheckResult, vector<string>> check(vector<smtutil::Expression> const& _expressionsToEvaluate) override
+	{
+		return m_main.check(_expressionsToEvaluate);
+	}
+
+	vector<string> unhandledQueries() override { return m_main.unhandledQueries(); }
+	unsigned solvers() override { return m_main.solvers(); }
+
+private:
+	smtutil::SolverInterface& m_main;
+	map<string, smtutil::SortPointer>& m_declarations;
+};
+
+}
+
 BMC::BMC(
 	smt::EncodingContext& _context,
 	ErrorReporter& _errorReporter,
 	map<h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
-	smtutil::SMTSolverChoice _enabledSolvers
+	smtutil::SMTSolverChoice _enabledSolvers,
+	ModelCheckerSettings const& _settings,
+	shared_ptr<smtutil::QueryCache const> _queryCache
 ):
 	SMTEncoder(_context),
-	m_interface(make_unique<smtutil::SMTPortfolio>(_smtlib2Responses, _smtCallback, _enabledSolvers)),
+	m_interface(make_unique<smtutil::SMTPortfolio>(
+		_smtlib2Responses,
+		_smtCallback,
+		_enabledSolvers,
+		_settings.portfolioMode,
+		_settings.timeout,
+		_queryCache
+	)),
 	m_outerErrorReporter(_errorReporter)
 {
+	// The target solvers cannot use the SMT callback, because it may not be called concurrently.
+	// Without a solver in this binary, the queries that are sent to the callback do not change.
+	// Checking on one thread, the queries are checked on m_interface, which is much faster than
+	// creating a new solver for each of them.
+	if (m_interface->solvers() > 1 && _settings.parallelism > 1)
+	{
+		m_newTargetSolver = [=, &_smtlib2Responses, mutex = make_shared<std::mutex>()]() {
+			// Z3 sets global parameters when a solver is created.
+			lock_guard<std::mutex> lock(*mutex);
+			return make_unique<smtutil::SMTPortfolio>(
+				_smtlib2Responses,
+				ReadCallback::Callback{},
+				_enabledSolvers,
+				_settings.portfolioMode,
+				_settings.timeout,
+				_queryCache
+			);
+		};
+		m_contextSolver = make_unique<DeclarationRecorder>(*m_interface, m_declarations);
+		m_parallelism = _settings.parallelism;
+		m_threadPool = make_unique<ThreadPool>(m_parallelism - 1);
+	}
+
 #if defined (HAVE_Z3) || defined (HAVE_CVC4)
 	if (_enabledSolvers.some())
 		if (!_smtlib2Responses.empty())
@@ -57,8 +140,9 @@ void BMC::analyze(SourceUnit const& _source, set<Expression const*> _safeAsserti
 	solAssert(_source.annotation().experimentalFeatures.count(ExperimentalFeature::SMTChecker), "");
 
 	m_safeAssertions += move(_safeAssertions);
-	m_context.setSolver(m_interface.get());
+	m_context.setSolver(m_contextSolver ? m_contextSolver.get() : m_interface.get());
 	m_context.clear();
+	m_declarations.clear();
 	m_context.setAssertionAccumulation(true);
 	m_variableUsage.setFunctionInlining(true);
 
@@ -86,6 +170,11 @@ void BMC::analyze(SourceUnit const& _source, set<Expression const*> _safeAsserti
 	m_errorReporter.clear();
 }
 
+vector<string> BMC::unhandledQueries()
+{
+	return m_interface->unhandledQueries() + m_unhandledTargetQueries;
+}
+
 bool BMC::shouldInlineFunctionCall(FunctionCall const& _funCall)
 {
 	FunctionDefinition const* funDef = functionCallToDefinition(_funCall);
@@ -552,8 +641,30 @@ pair<vector<smtutil::Expression>, vector<string>> BMC::modelExpressions()
 
 void BMC::checkVerificationTargets(smtutil::Expression const& _constraints)
 {
+	// The queries of constant conditions were already added while visiting the function.
 	for (auto& target: m_verificationTargets)
 		checkVerificationTarget(target, _constraints);
+
+	vector<vector<QueryResult>> results = solveTargetQueries();
+	solAssert(results.size() == m_targetQueries.size(), "");
+	size_t insertedErrors = 0;
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		size_t errorCount = m_smtErrors.size();
+		reportTargetQuery(m_targetQueries[i], move(results[i]));
+		if (m_targetQueries[i].constantCondition)
+		{
+			ErrorList errors(m_smtErrors.begin() + static_cast<ptrdiff_t>(errorCount), m_smtErrors.end());
+			m_smtErrors.resize(errorCount);
+			m_smtErrors.insert(
+				m_smtErrors.begin() + static_cast<ptrdiff_t>(m_targetQueries[i].errorPosition + insertedErrors),
+				errors.begin(),
+				errors.end()
+			);
+			insertedErrors += errors.size();
+		}
+	}
+	m_targetQueries.clear();
 }
 
 void BMC::checkVerificationTarget(BMCVerificationTarget& _target, smtutil::Expression const& _constraints)
@@ -732,21 +843,62 @@ void BMC::checkCondition(
 	smtutil::Expression const* _additionalValue
 )
 {
-	m_interface->push();
-	m_interface->addAssertion(_condition);
-
-	vector<smtutil::Expression> expressionsToEvaluate;
-	vector<string> expressionNames;
-	tie(expressionsToEvaluate, expressionNames) = _modelExpressions;
+	TargetQuery query{
+		{move(_condition)},
+		nullptr,
+		_callStack,
+		_modelExpressions.first,
+		_modelExpressions.second,
+		_location,
+		_errorHappens,
+		_errorMightHappen,
+		_description
+	};
 	if (_callStack.size())
 		if (_additionalValue)
 		{
-			expressionsToEvaluate.emplace_back(*_additionalValue);
-			expressionNames.push_back(_additionalValueName);
+			query.expressionsToEvaluate.emplace_back(*_additionalValue);
+			query.expressionNames.push_back(_additionalValueName);
 		}
-	smtutil::CheckResult result;
-	vector<string> values;
-	tie(result, values) = checkSatisfiableAndGenerateModel(expressionsToEvaluate);
+	m_targetQueries.emplace_back(move(query));
+}
+
+vector<vector<BMC::QueryResult>> BMC::solveTargetQueries()
+{
+	vector<vector<QueryResult>> results(m_targetQueries.size());
+	if (!m_newTargetSolver)
+	{
+		for (size_t i = 0; i < m_targetQueries.size(); ++i)
+			results[i] = solve(*m_interface, m_targetQueries[i]);
+		return results;
+	}
+
+	// Every query is checked on a fresh solver, so it does not matter which thread checks it.
+	atomic<size_t> nextQuery{0};
+	auto solveQueries = [&]() {
+		for (size_t i = nextQuery++; i < m_targetQueries.size(); i = nextQuery++)
+			results[i] = solveFresh(*m_newTargetSolver(), m_declarations, m_targetQueries[i]);
+	};
+	m_threadPool->run(vector<function<void()>>(m_parallelism, solveQueries));
+
+	return results;
+}
+
+void BMC::reportTargetQuery(TargetQuery const& _query, vector<QueryResult> _results)
+{
+	for (QueryResult& result: _results)
+	{
+		if (!result.solverError.empty())
+			m_errorReporter.warning(8140_error, result.solverError);
+		m_unhandledTargetQueries += move(result.unhandledQueries);
+	}
+	if (_query.constantCondition)
+	{
+		reportConstantCondition(_query, _results);
+		return;
+	}
+	solAssert(_results.size() == 1, "");
+	QueryResult const& result = _results.front();
 
 	string extraComment = SMTEncoder::extraComment();
 	if (m_loopExecutionHappened)
@@ -763,54 +915,55 @@ void BMC::checkCondition(
 	SecondarySourceLocation secondaryLocation{};
 	secondaryLocation.append(extraComment, SourceLocation{});
 
-	switch (result)
+	switch (result.result)
 	{
 	case smtutil::CheckResult::SATISFIABLE:
 	{
 		std::ostringstream message;
-		message << _description << " happens here";
-		if (_callStack.size())
+		message << _query.description << " happens here";
+		if (_query.callStack.size())
 		{
 			std::ostringstream modelMessage;
 			modelMessage << "  for:\n";
-			solAssert(values.size() == expressionNames.size(), "");
+			solAssert(result.values.size() == _query.expressionNames.size(), "");
 			map<string, string> sortedModel;
-			for (size_t i = 0; i < values.size(); ++i)
-				if (expressionsToEvaluate.at(i).name != values.at(i))
-					sortedModel[expressionNames.at(i)] = values.at(i);
+			for (size_t i = 0; i < result.values.size(); ++i)
+				if (_query.expressionsToEvaluate.at(i).name != result.values.at(i))
+					sortedModel[_query.expressionNames.at(i)] = result.values.at(i);
 
 			for (auto const& eval: sortedModel)
 				modelMessage << "  " << eval.first << " = " << eval.second << "\n";
 			m_errorReporter.warning(
-				_errorHappens,
-				_location,
+				_query.errorHappens,
+				_query.location,
 				message.str(),
 				SecondarySourceLocation().append(modelMessage.str(), SourceLocation{})
-				.append(SMTEncoder::callStackMessage(_callStack))
+				.append(SMTEncoder::callStackMessage(_query.callStack))
 				.append(move(secondaryLocation))
 			);
 		}
 		else
 		{
 			message << ".";
-			m_errorReporter.warning(6084_error, _location, message.str(), secondaryLocation);
+			m_errorReporter.warning(6084_error, _query.location, message.str(), secondaryLocation);
 		}
 		break;
 	}
 	case smtutil::CheckResult::UNSATISFIABLE:
 		break;
 	case smtutil::CheckResult::UNKNOWN:
-		m_errorReporter.warning(_errorMightHappen, _location, _description + " might happen here.", secondaryLocation);
+		m_errorReporter.warning(_query.errorMightHappen, _query.location, _query.description + " might happen here.", secondaryLocation);
+		break;
+	case smtutil::CheckResult::TIMEOUT:
+		m_errorReporter.warning(_query.errorMightHappen, _query.location, _query.description + " might happen here: unknown (timeout).", secondaryLocation);
 		break;
 	case smtutil::CheckResult::CONFLICTING:
-		m_errorReporter.warning(1584_error, _location, "At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		m_errorReporter.warning(1584_error, _query.location, "At least two SMT solvers provided conflicting answers. Results might not be sound.");
 		break;
 	case smtutil::CheckResult::ERROR:
-		m_errorReporter.warning(1823_error, _location, "Error trying to invoke SMT solver.");
+		m_errorReporter.warning(1823_error, _query.location, "Error trying to invoke SMT solver.");
 		break;
 	}
-
-	m_interface->pop();
 }
 
 void BMC::checkBooleanNotConstant(
@@ -824,30 +977,38 @@ void BMC::checkBooleanNotConstant(
 	if (dynamic_cast<Literal const*>(&_condition))
 		return;
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && _value);
-	auto positiveResult = checkSatisfiable();
-	m_interface->pop();
+	TargetQuery query;
+	query.conditions = {_constraints && _value, _constraints && !_value};
+	query.constantCondition = &_condition;
+	query.errorPosition = m_smtErrors.size();
+	query.callStack = _callStack;
+	query.location = _condition.location();
+	m_targetQueries.emplace_back(move(query));
+}
 
-	m_interface->push();
-	m_interface->addAssertion(_constraints && !_value);
-	auto negatedResult = checkSatisfiable();
-	m_interface->pop();
+void BMC::reportConstantCondition(TargetQuery const& _query, vector<QueryResult> const& _results)
+{
+	solAssert(_results.size() == 2, "");
+	smtutil::CheckResult positiveResult = _results[0].result;
+	smtutil::CheckResult negatedResult = _results[1].result;
 
 	if (positiveResult == smtutil::CheckResult::ERROR || negatedResult == smtutil::CheckResult::ERROR)
-		m_errorReporter.warning(8592_error, _condition.location(), "Error trying to invoke SMT solver.");
+		m_errorReporter.warning(8592_error, _query.location, "Error trying to invoke SMT solver.");
 	else if (positiveResult == smtutil::CheckResult::CONFLICTING || negatedResult == smtutil::CheckResult::CONFLICTING)
-		m_errorReporter.warning(3356_error, _condition.location(), "At least two SMT solvers provided conflicting answers. Results might not be sound.");
+		m_errorReporter.warning(3356_error, _query.location, "At least two SMT solvers provided conflicting answers. Results might not be sound.");
 	else if (positiveResult == smtutil::CheckResult::SATISFIABLE && negatedResult == smtutil::CheckResult::SATISFIABLE)
 	{
 		// everything fine.
 	}
-	else if (positiveResult == smtutil::CheckResult::UNKNOWN || negatedResult == smtutil::CheckResult::UNKNOWN)
+	else if (
+		positiveResult == smtutil::CheckResult::UNKNOWN || negatedResult == smtutil::CheckResult::UNKNOWN ||
+		positiveResult == smtutil::CheckResult::TIMEOUT || negatedResult == smtutil::CheckResult::TIMEOUT
+	)
 	{
 		// can't do anything.
 	}
 	else if (positiveResult == smtutil::CheckResult::UNSATISFIABLE && negatedResult == smtutil::CheckResult::UNSATISFIABLE)
-		m_errorReporter.warning(2512_error, _condition.location(), "Condition unreachable.", SMTEncoder::callStackMessage(_callStack));
+		m_errorReporter.warning(2512_error, _query.location, "Condition unreachable.", SMTEncoder::callStackMessage(_query.callStack));
 	else
 	{
 		string description;
@@ -864,32 +1025,71 @@ void BMC::checkBooleanNotConstant(
 		}
 		m_errorReporter.warning(
 			6838_error,
-			_condition.location(),
+			_query.location,
 			description,
-			SMTEncoder::callStackMessage(_callStack)
+			SMTEncoder::callStackMessage(_query.callStack)
 		);
 	}
 }
 
-pair<smtutil::CheckResult, vector<string>>
-BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expressionsToEvaluate)
+vector<BMC::QueryResult> BMC::solve(smtutil::SolverInterface& _solver, TargetQuery const& _query)
+{
+	vector<QueryResult> results;
+	for (smtutil::Expression const& condition: _query.conditions)
+	{
+		_solver.push();
+		_solver.addAssertion(condition);
+		results.emplace_back(checkSatisfiableAndGenerateModel(_solver, _query.expressionsToEvaluate));
+		_solver.pop();
+	}
+	return results;
+}
+
+vector<BMC::QueryResult> BMC::solveFresh(
+	smtutil::SolverInterface& _solver,
+	map<string, smtutil::SortPointer> const& _declarations,
+	TargetQuery const& _query
+)
+{
+	set<string> usedNames;
+	function<void(smtutil::Expression const&)> collectNames = [&](smtutil::Expression const& _expr)
+	{
+		usedNames.insert(_expr.name);
+		for (auto const& argument: _expr.arguments)
+			collectNames(argument);
+	};
+	for (smtutil::Expression const& condition: _query.conditions)
+		collectNames(condition);
+	for (smtutil::Expression const& expression: _query.expressionsToEvaluate)
+		collectNames(expression);
+	for (string const& name: usedNames)
+		if (auto declaration = _declarations.find(name); declaration != _declarations.end())
+			_solver.declareVariable(name, declaration->second);
+	vector<QueryResult> results = solve(_solver, _query);
+	solAssert(!results.empty(), "");
+	results.back().unhandledQueries = _solver.unhandledQueries();
+	return results;
+}
+
+BMC::QueryResult BMC::checkSatisfiableAndGenerateModel(
+	smtutil::SolverInterface& _solver,
+	vector<smtutil::Expression> const& _expressionsToEvaluate
+)
 {
-	smtutil::CheckResult result;
-	vector<string> values;
+	QueryResult result;
 	try
 	{
-		tie(result, values) = m_interface->check(_expressionsToEvaluate);
+		tie(result.result, result.values) = _solver.check(_expressionsToEvaluate);
 	}
 	catch (smtutil::SolverError const& _e)
 	{
-		string description("Error querying SMT solver");
+		result.solverError = "Error querying SMT solver";
 		if (_e.comment())
-			description += ": " + *_e.comment();
-		m_errorReporter.warning(8140_error, description);
-		result = smtutil::CheckResult::ERROR;
+			result.solverError += ": " + *_e.comment();
+		result.result = smtutil::CheckResult::ERROR;
 	}
 
-	for (string& value: values)
+	for (string& value: result.values)
 	{
 		try
 		{
@@ -899,11 +1099,5 @@ BMC::checkSatisfiableAndGenerateModel(vector<smtutil::Expression> const& _expres
 		catch (...) { }
 	}
 
-	return make_pair(result, values);
+	return result;
 }
-
-smtutil::CheckResult BMC::checkSatisfiable()
-{
-	return checkSatisfiableAndGenerateModel({}).first;
-}
-
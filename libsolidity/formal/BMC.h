@@ -23,19 +23,28 @@
  * - Underflow/Overflow
  * - Constant conditions
  * - Assertions
+ * The targets of a function are checked after the function has been visited,
+ * optionally by several solvers concurrently.
  */
 
 #pragma once
 
 
 #include <libsolidity/formal/EncodingContext.h>
+#include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/SMTEncoder.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
+#include <libsmtutil/QueryCache.h>
 #include <libsmtutil/SolverInterface.h>
 #include <liblangutil/ErrorReporter.h>
 
+#include <libsolutil/ThreadPool.h>
+
+#include <functional>
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -60,7 +69,9 @@ public:
 		langutil::ErrorReporter& _errorReporter,
 		std::map<h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
-		smtutil::SMTSolverChoice _enabledSolvers
+		smtutil::SMTSolverChoice _enabledSolvers,
+		ModelCheckerSettings const& _settings,
+		std::shared_ptr<smtutil::QueryCache const> _queryCache
 	);
 
 	void analyze(SourceUnit const& _sources, std::set<Expression const*> _safeAssertions);
@@ -68,7 +79,7 @@ public:
 	/// This is used if the SMT solver is not directly linked into this binary.
 	/// @returns a list of inputs to the SMT solver that were not part of the argument to
 	/// the constructor.
-	std::vector<std::string> unhandledQueries() { return m_interface->unhandledQueries(); }
+	std::vector<std::string> unhandledQueries();
 
 	/// @returns true if _funCall should be inlined, otherwise false.
 	static bool shouldInlineFunctionCall(FunctionCall const& _funCall);
@@ -126,7 +137,40 @@ private:
 		std::pair<std::vector<smtutil::Expression>, std::vector<std::string>> modelExpressions;
 	};
 
+	/// A query of a verification target. Most targets are violated if their only condition is
+	/// satisfiable. A constant condition has its negation as a second condition and is
+	/// reported if either of them is unsatisfiable.
+	struct TargetQuery
+	{
+		std::vector<smtutil::Expression> conditions;
+		/// The expression of a constant condition target, null for other targets.
+		Expression const* constantCondition = nullptr;
+		std::vector<CallStackEntry> callStack;
+		std::vector<smtutil::Expression> expressionsToEvaluate;
+		std::vector<std::string> expressionNames;
+		langutil::SourceLocation location;
+		langutil::ErrorId errorHappens;
+		langutil::ErrorId errorMightHappen;
+		std::string description;
+		/// For a constant condition, the number of errors that had been reported when it was
+		/// encountered. Its errors are inserted there, as if it had been checked right away.
+		size_t errorPosition = 0;
+	};
+
+	/// Result of checking one condition of a target query.
+	struct QueryResult
+	{
+		smtutil::CheckResult result = smtutil::CheckResult::ERROR;
+		std::vector<std::string> values;
+		/// Description of an error thrown by the solver, empty if there was none.
+		std::string solverError;
+		/// Queries the SMT-LIB2 interface of a target solver could not answer.
+		std::vector<std::string> unhandledQueries;
+	};
+
+	/// Checks all targets in m_verificationTargets and reports the results in the order of the targets.
 	void checkVerificationTargets(smtutil::Expression const& _constraints);
+	/// Adds the queries of @a _target to m_targetQueries.
 	void checkVerificationTarget(BMCVerificationTarget& _target, smtutil::Expression const& _constraints = smtutil::Expression(true));
 	void checkConstantCondition(BMCVerificationTarget& _target);
 	void checkUnderflow(BMCVerificationTarget& _target, smtutil::Expression const& _constraints);
@@ -143,7 +187,7 @@ private:
 
 	/// Solver related.
 	//@{
-	/// Check that a condition can be satisfied.
+	/// Adds a query that checks whether the condition can be satisfied to m_targetQueries.
 	void checkCondition(
 		smtutil::Expression _condition,
 		std::vector<CallStackEntry> const& _callStack,
@@ -155,21 +199,59 @@ private:
 		std::string const& _additionalValueName = "",
 		smtutil::Expression const* _additionalValue = nullptr
 	);
-	/// Checks that a boolean condition is not constant. Do not warn if the expression
-	/// is a literal constant.
+	/// Adds a query that checks that a boolean condition is not constant to m_targetQueries.
+	/// Do not warn if the expression is a literal constant.
 	void checkBooleanNotConstant(
 		Expression const& _condition,
 		smtutil::Expression const& _constraints,
 		smtutil::Expression const& _value,
 		std::vector<CallStackEntry> const& _callStack
 	);
-	std::pair<smtutil::CheckResult, std::vector<std::string>>
-	checkSatisfiableAndGenerateModel(std::vector<smtutil::Expression> const& _expressionsToEvaluate);
+	/// Solves the queries in m_targetQueries, concurrently if there is a thread pool.
+	/// @returns the results of the conditions of each query.
+	std::vector<std::vector<QueryResult>> solveTargetQueries();
+	/// Reports the results of a query in m_targetQueries.
+	void reportTargetQuery(TargetQuery const& _query, std::vector<QueryResult> _results);
+	/// Reports the results of the query of a constant condition.
+	void reportConstantCondition(TargetQuery const& _query, std::vector<QueryResult> const& _results);
 
-	smtutil::CheckResult checkSatisfiable();
+	/// Checks whether the conditions of @a _query are satisfiable, using @a _solver. Does not
+	/// access any state of the BMC, so it can run on any thread.
+	static std::vector<QueryResult> solve(smtutil::SolverInterface& _solver, TargetQuery const& _query);
+	/// Checks @a _query like solve() on the fresh solver @a _solver, after declaring the
+	/// variables of @a _declarations that the query uses in it.
+	static std::vector<QueryResult> solveFresh(
+		smtutil::SolverInterface& _solver,
+		std::map<std::string, smtutil::SortPointer> const& _declarations,
+		TargetQuery const& _query
+	);
+	/// Checks whether the assertions of @a _solver are satisfiable and evaluates
+	/// @a _expressionsToEvaluate if they are.
+	static QueryResult checkSatisfiableAndGenerateModel(
+		smtutil::SolverInterface& _solver,
+		std::vector<smtutil::Expression> const& _expressionsToEvaluate
+	);
 	//@}
 
 	std::unique_ptr<smtutil::SolverInterface> m_interface;
+	/// Creates the solver that checks a target query if the queries are checked concurrently.
+	/// Every query is then checked on a new solver, so that the answers and the counterexamples
+	/// do not depend on the thread that checks it. Null if the queries are checked on one thread
+	/// or if there is no SMT solver in this binary, in which case m_interface checks the queries.
+	std::function<std::unique_ptr<smtutil::SolverInterface>()> m_newTargetSolver;
+	/// Variables declared in m_interface while analysing the current source. The ones a query
+	/// uses are declared in its target solver.
+	std::map<std::string, smtutil::SortPointer> m_declarations;
+	/// Solver used by the encoding context. If the queries are checked on new solvers, it records the
+	/// declarations of variables in m_declarations in addition to forwarding them to m_interface.
+	std::unique_ptr<smtutil::SolverInterface> m_contextSolver;
+	/// Pool that checks the target queries together with the calling thread, null if they are
+	/// checked on m_interface.
+	std::unique_ptr<util::ThreadPool> m_threadPool;
+	/// Number of threads that check the target queries, including the calling thread.
+	size_t m_parallelism = 1;
+	/// Queries that the new solvers could not answer, in the order of the targets.
+	std::vector<std::string> m_unhandledTargetQueries;
 
 	/// Flags used for better warning messages.
 	bool m_loopExecutionHappened = false;
@@ -179,6 +261,8 @@ private:
 	langutil::ErrorReporter& m_outerErrorReporter;
 
 	std::vector<BMCVerificationTarget> m_verificationTargets;
+	/// Queries of the targets in m_verificationTargets, in the order of the targets.
+	std::vector<TargetQuery> m_targetQueries;
 
 	/// Assertions that are known to be safe.
 	std::set<Expression const*> m_safeAssertions;
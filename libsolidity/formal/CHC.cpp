@@ -40,7 +40,9 @@ CHC::CHC(
 	ErrorReporter& _errorReporter,
 	map<util::h256, string> const& _smtlib2Responses,
 	ReadCallback::Callback const& _smtCallback,
-	[[maybe_unused]] smtutil::SMTSolverChoice _enabledSolvers
+	[[maybe_unused]] smtutil::SMTSolverChoice _enabledSolvers,
+	[[maybe_unused]] ModelCheckerSettings const& _settings,
+	[[maybe_unused]] shared_ptr<smtutil::QueryCache const> _queryCache
 ):
 	SMTEncoder(_context),
 	m_outerErrorReporter(_errorReporter),
@@ -48,7 +50,7 @@ CHC::CHC(
 {
 #ifdef HAVE_Z3
 	if (_enabledSolvers.z3)
-		m_interface = make_unique<smtutil::Z3CHCInterface>();
+		m_interface = make_unique<smtutil::Z3CHCInterface>(_settings.timeout, _queryCache);
 #endif
 	if (!m_interface)
 		m_interface = make_unique<smtutil::CHCSmtLib2Interface>(_smtlib2Responses, _smtCallback);
@@ -125,6 +127,8 @@ void CHC::analyze(SourceUnit const& _source)
 				string msg = "Empty array \"pop\" ";
 				if (result == smtutil::CheckResult::SATISFIABLE)
 					msg += "detected here.";
+				else if (result == smtutil::CheckResult::TIMEOUT)
+					msg += "might happen here: unknown (timeout).";
 				else
 					msg += "might happen here.";
 				m_unsafeTargets.insert(scope);
@@ -1018,6 +1022,8 @@ pair<smtutil::CheckResult, vector<string>> CHC::query(smtutil::Expression const&
 		break;
 	case smtutil::CheckResult::UNKNOWN:
 		break;
+	case smtutil::CheckResult::TIMEOUT:
+		break;
 	case smtutil::CheckResult::CONFLICTING:
 		m_outerErrorReporter.warning(1988_error, _location, "At least two SMT solvers provided conflicting answers. Results might not be sound.");
 		break;
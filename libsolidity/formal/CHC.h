@@ -30,11 +30,13 @@
 
 #pragma once
 
+#include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/formal/SMTEncoder.h>
 
 #include <libsolidity/interface/ReadFile.h>
 
 #include <libsmtutil/CHCSolverInterface.h>
+#include <libsmtutil/QueryCache.h>
 
 #include <set>
 
@@ -49,7 +51,9 @@ public:
 		langutil::ErrorReporter& _errorReporter,
 		std::map<util::h256, std::string> const& _smtlib2Responses,
 		ReadCallback::Callback const& _smtCallback,
-		smtutil::SMTSolverChoice _enabledSolvers
+		smtutil::SMTSolverChoice _enabledSolvers,
+		ModelCheckerSettings const& _settings,
+		std::shared_ptr<smtutil::QueryCache const> _queryCache
 	);
 
 	void analyze(SourceUnit const& _sources);
@@ -0,0 +1,44 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Settings of the model checking engines.
+ */
+
+#pragma once
+
+#include <libsmtutil/SolverInterface.h>
+
+#include <cstddef>
+#include <optional>
+
+namespace solidity::frontend
+{
+
+struct ModelCheckerSettings
+{
+	/// How the answers of the enabled SMT solvers are combined.
+	smtutil::PortfolioMode portfolioMode = smtutil::PortfolioMode::Verify;
+	/// Time limit in milliseconds for a single SMT query. Queries that run into it
+	/// are reported as unknown (timeout). Without it, only the deterministic resource
+	/// limits of the solvers apply.
+	std::optional<unsigned> timeout;
+	/// Number of solvers that check the verification targets of BMC concurrently.
+	/// The warnings are reported in the same order for any number.
+	size_t parallelism = 1;
+};
+
+}
@@ -0,0 +1,64 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Persistent cache for the artifacts of compiled contracts.
+ */
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <boost/filesystem.hpp>
+
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+
+namespace fs = boost::filesystem;
+
+optional<Json::Value> CompilationCache::load(util::h256 const& _key) const
+{
+	ifstream file(entryPath(_key).string(), ios::binary);
+	if (!file)
+		return nullopt;
+	stringstream content;
+	content << file.rdbuf();
+
+	Json::Value entry;
+	if (!file || !util::jsonParseStrict(content.str(), entry) || !entry.isObject())
+		return nullopt;
+	return entry;
+}
+
+void CompilationCache::store(util::h256 const& _key, Json::Value const& _entry) const
+{
+	boost::system::error_code error;
+	fs::create_directories(m_directory, error);
+	if (error)
+		return;
+
+	util::writeFileAtomically(entryPath(_key).string(), util::jsonCompactPrint(_entry));
+}
+
+fs::path CompilationCache::entryPath(util::h256 const& _key) const
+{
+	return m_directory / (_key.hex() + ".json");
+}
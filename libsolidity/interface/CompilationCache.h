@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Persistent cache for the artifacts of compiled contracts.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <json/json.h>
+
+#include <boost/filesystem/path.hpp>
+
+#include <optional>
+
+namespace solidity::frontend
+{
+
+/**
+ * Stores the artifacts of compiled contracts in a directory, so that they can be reused
+ * by later compiler runs. Every entry is a JSON file named after its key, which has to be
+ * the hash of everything that influences the artifacts.
+ *
+ * The cache never causes a compilation to fail: entries that cannot be read or written
+ * are treated as missing. Entries are written to a temporary file that is renamed
+ * afterwards, so several compiler processes can share the directory.
+ */
+class CompilationCache
+{
+public:
+	explicit CompilationCache(boost::filesystem::path _directory): m_directory(std::move(_directory)) {}
+
+	/// @returns the entry stored under @a _key or an empty optional if there is no such entry
+	/// or it cannot be read.
+	std::optional<Json::Value> load(util::h256 const& _key) const;
+	/// Stores @a _entry under @a _key, replacing any previous entry.
+	void store(util::h256 const& _key, Json::Value const& _entry) const;
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+
+	boost::filesystem::path m_directory;
+};
+
+}
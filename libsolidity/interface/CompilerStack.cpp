@@ -44,6 +44,7 @@
 #include <libsolidity/codegen/Compiler.h>
 #include <libsolidity/formal/ModelChecker.h>
 #include <libsolidity/interface/ABI.h>
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/Natspec.h>
 #include <libsolidity/interface/GasEstimator.h>
 #include <libsolidity/interface/StorageLayout.h>
@@ -64,10 +65,15 @@
 #include <libsolutil/SwarmHash.h>
 #include <libsolutil/IpfsHash.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <json/json.h>
 
 #include <boost/algorithm/string/replace.hpp>
+
+#include <algorithm>
+#include <mutex>
 #include <utility>
 
 using namespace std;
@@ -143,6 +149,31 @@ void CompilerStack::setSMTSolverChoice(smtutil::SMTSolverChoice _enabledSMTSolve
 	m_enabledSMTSolvers = _enabledSMTSolvers;
 }
 
+void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
+{
+	if (m_stackState >= ParsingPerformed)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set model checker settings before parsing."));
+	m_modelCheckerSettings = _settings;
+}
+
+void CompilerStack::setParallelism(size_t _parallelism)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set parallelism before compiling."));
+	solAssert(_parallelism > 0, "");
+	m_parallelism = _parallelism;
+}
+
+void CompilerStack::setCacheDirectory(string const& _directory)
+{
+	if (m_stackState >= CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set cache directory before compiling."));
+	if (_directory.empty())
+		m_cache.reset();
+	else
+		m_cache = make_shared<CompilationCache const>(_directory);
+}
+
 void CompilerStack::setLibraries(std::map<std::string, util::h160> const& _libraries)
 {
 	if (m_stackState >= ParsingPerformed)
@@ -206,14 +237,21 @@ void CompilerStack::reset(bool _keepSettings)
 		m_libraries.clear();
 		m_evmVersion = langutil::EVMVersion();
 		m_enabledSMTSolvers = smtutil::SMTSolverChoice::All();
+		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_generateIR = false;
 		m_generateEwasm = false;
+		m_profileOptimiser = false;
+		m_profiler = nullptr;
+		m_parallelism = 1;
+		m_cache.reset();
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
 		m_metadataHash = MetadataHash::IPFS;
 	}
 	m_globalContext.reset();
+	m_resolver.reset();
+	m_retiredASTs.clear();
 	m_sourceOrder.clear();
 	m_contracts.clear();
 	m_errorReporter.clear();
@@ -226,9 +264,77 @@ void CompilerStack::setSources(StringMap _sources)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
 	if (m_stackState != Empty)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
-	for (auto source: _sources)
-		m_sources[source.first].scanner = make_shared<Scanner>(CharStream(/*content*/std::move(source.second), /*name*/source.first));
+	for (auto& [name, content]: _sources)
+		m_sources[name].scanner = make_shared<Scanner>(CharStream(/*content*/std::move(content), /*name*/name));
+	m_stackState = SourcesSet;
+}
+
+void CompilerStack::setSourceStreams(map<string, CharStream> _sources)
+{
+	if (m_stackState == SourcesSet)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Cannot change sources once set."));
+	if (m_stackState != Empty)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must set sources before parsing."));
+	for (auto const& [name, stream]: _sources)
+		m_sources[name].scanner = make_shared<Scanner>(stream.withName(name));
+	m_stackState = SourcesSet;
+}
+
+void CompilerStack::updateSources(StringMap _sources)
+{
+	// Only the analysis of unchanged sources that only import unchanged sources is reused.
+	set<string> unchangedSources;
+	if (m_stackState >= AnalysisPerformed && !m_hasError && !m_importedSources)
+		for (auto const& [name, source]: m_sources)
+			if (source.analysed && _sources.count(name) && _sources.at(name) == source.scanner->source())
+				unchangedSources.insert(name);
+	map<string, set<string>> importers;
+	for (string const& name: unchangedSources)
+		for (auto const* import: ASTNode::filteredNodes<ImportDirective>(m_sources.at(name).ast->nodes()))
+			importers[import->annotation().absolutePath].insert(name);
+	vector<string> invalidated;
+	for (auto const& source: m_sources)
+		if (!unchangedSources.count(source.first))
+			invalidated.push_back(source.first);
+	while (!invalidated.empty())
+	{
+		string name = move(invalidated.back());
+		invalidated.pop_back();
+		for (string const& importer: importers[name])
+			if (unchangedSources.erase(importer))
+				invalidated.push_back(importer);
+	}
+
+	// The retired ASTs are released by a full analysis, which is done once they outnumber the
+	// current sources.
+	bool incremental = !unchangedSources.empty() && m_retiredASTs.size() + m_sources.size() - unchangedSources.size() <= _sources.size();
+
+	for (auto it = m_sources.begin(); it != m_sources.end();)
+		if (incremental && unchangedSources.count(it->first))
+			++it;
+		else
+		{
+			if (incremental && it->second.ast)
+				m_retiredASTs.emplace_back(move(it->second.ast));
+			it = m_sources.erase(it);
+		}
+	if (!incremental)
+	{
+		m_globalContext.reset();
+		m_resolver.reset();
+		m_retiredASTs.clear();
+		TypeProvider::reset();
+	}
+	for (auto& [name, content]: _sources)
+		if (!m_sources.count(name))
+			m_sources[name].scanner = make_shared<Scanner>(CharStream(move(content), name));
+
 	m_stackState = SourcesSet;
+	m_hasError = false;
+	m_importedSources = false;
+	m_sourceOrder.clear();
+	m_contracts.clear();
+	m_unhandledSMTLib2Queries.clear();
 }
 
 bool CompilerStack::parse()
@@ -244,26 +350,45 @@ bool CompilerStack::parse()
 
 	vector<string> sourcesToParse;
 	for (auto const& s: m_sources)
+	{
+		if (s.second.ast)
+			// Kept by updateSources, new nodes must not reuse its node IDs.
+			parser.continueNodeIDsAfter(s.second.ast->id());
 		sourcesToParse.push_back(s.first);
+	}
+	for (auto const& ast: m_retiredASTs)
+		parser.continueNodeIDsAfter(ast->id());
 	for (size_t i = 0; i < sourcesToParse.size(); ++i)
 	{
 		string const& path = sourcesToParse[i];
 		Source& source = m_sources[path];
+		if (source.analysed)
+		{
+			m_errorReporter.append(source.errors["Parser"]);
+			continue;
+		}
+		size_t errorCount = m_errorReporter.errors().size();
+		util::ScopedTimer timer(m_profiler, "Parsing", path);
 		source.scanner->reset();
 		source.ast = parser.parse(source.scanner);
+		if (m_profiler)
+			m_profiler->count("Parsed sources");
 		if (!source.ast)
 			solAssert(!Error::containsOnlyWarnings(m_errorReporter.errors()), "Parser returned null but did not report error.");
 		else
 		{
 			source.ast->annotation().path = path;
-			for (auto const& newSource: loadMissingSources(*source.ast, path))
+			timer.next("Import resolution", path);
+			for (auto& [newPath, newContents]: loadMissingSources(*source.ast, path))
 			{
-				string const& newPath = newSource.first;
-				string const& newContents = newSource.second;
-				m_sources[newPath].scanner = make_shared<Scanner>(CharStream(newContents, newPath));
+				m_sources[newPath].scanner = make_shared<Scanner>(move(newContents));
 				sourcesToParse.push_back(newPath);
 			}
 		}
+		source.errors["Parser"] = ErrorList(
+			m_errorReporter.errors().begin() + static_cast<ptrdiff_t>(errorCount),
+			m_errorReporter.errors().end()
+		);
 	}
 
 	m_stackState = ParsingPerformed;
@@ -296,76 +421,109 @@ bool CompilerStack::analyze()
 {
 	if (m_stackState != ParsingPerformed || m_stackState >= AnalysisPerformed)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Must call analyze only after parsing was performed."));
-	resolveImports();
+	{
+		util::ScopedTimer timer(m_profiler, "Import resolution");
+		resolveImports();
+	}
+
+	// Sources kept by updateSources have been analysed before, together with their imports.
+	bool incremental = any_of(m_sourceOrder.begin(), m_sourceOrder.end(), [](Source const* _source) {
+		return _source->analysed;
+	});
+	solAssert(!incremental || m_resolver, "");
 
 	bool noErrors = true;
 
 	try
 	{
+		util::ScopedTimer timer(m_profiler, "SyntaxChecker");
 		SyntaxChecker syntaxChecker(m_errorReporter, m_optimiserSettings.runYulOptimiser);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !syntaxChecker.checkSyntax(*source->ast))
-				noErrors = false;
+		if (!analyseSources("SyntaxChecker", false, [&](Source const& _source) {
+			return syntaxChecker.checkSyntax(*_source.ast);
+		}))
+			noErrors = false;
 
+		timer.next("DocStringAnalyser");
 		DocStringAnalyser docStringAnalyser(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !docStringAnalyser.analyseDocStrings(*source->ast))
-				noErrors = false;
+		if (!analyseSources("DocStringAnalyser", false, [&](Source const& _source) {
+			return docStringAnalyser.analyseDocStrings(*_source.ast);
+		}))
+			noErrors = false;
 
-		m_globalContext = make_shared<GlobalContext>();
-		// We need to keep the same resolver during the whole process.
-		NameAndTypeResolver resolver(*m_globalContext, m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.registerDeclarations(*source->ast))
-				return false;
+		timer.next("NameAndTypeResolver");
+		if (!incremental)
+		{
+			m_globalContext = make_shared<GlobalContext>();
+			// We need to keep the same resolver during the whole process.
+			m_resolver = make_shared<NameAndTypeResolver>(*m_globalContext, m_evmVersion, m_errorReporter);
+		}
+		NameAndTypeResolver& resolver = *m_resolver;
+		if (!analyseSources("registerDeclarations", true, [&](Source const& _source) {
+			return resolver.registerDeclarations(*_source.ast);
+		}))
+			return false;
 
 		map<string, SourceUnit const*> sourceUnitsByName;
 		for (auto& source: m_sources)
 			sourceUnitsByName[source.first] = source.second.ast.get();
-		for (Source const* source: m_sourceOrder)
-			if (source->ast && !resolver.performImports(*source->ast, sourceUnitsByName))
-				return false;
+		if (!analyseSources("performImports", true, [&](Source const& _source) {
+			return resolver.performImports(*_source.ast, sourceUnitsByName);
+		}))
+			return false;
 
 		// This is the main name and type resolution loop. Needs to be run for every contract, because
 		// the special variables "this" and "super" must be set appropriately.
-		for (Source const* source: m_sourceOrder)
-			if (source->ast)
-				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+		if (!analyseSources("resolveNamesAndTypes", true, [&](Source const& _source) {
+			for (ASTPointer<ASTNode> const& node: _source.ast->nodes())
+			{
+				if (!resolver.resolveNamesAndTypes(*node))
+					return false;
+				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
 				{
-					if (!resolver.resolveNamesAndTypes(*node))
-						return false;
-					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-					{
-						// Note that we now reference contracts by their fully qualified names, and
-						// thus contracts can only conflict if declared in the same source file. This
-						// should already cause a double-declaration error elsewhere.
-						if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
-							m_contracts[contract->fullyQualifiedName()].contract = contract;
-						else
-							solAssert(
-								m_errorReporter.hasErrors(),
-								"Contract already present (name clash?), but no error was reported."
-							);
-					}
-
+					// Note that we now reference contracts by their fully qualified names, and
+					// thus contracts can only conflict if declared in the same source file. This
+					// should already cause a double-declaration error elsewhere.
+					if (m_contracts.find(contract->fullyQualifiedName()) == m_contracts.end())
+						m_contracts[contract->fullyQualifiedName()].contract = contract;
+					else
+						solAssert(
+							m_errorReporter.hasErrors(),
+							"Contract already present (name clash?), but no error was reported."
+						);
 				}
+			}
+			return true;
+		}))
+			return false;
 
-		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
+		// The contracts of the sources that are not analysed again.
 		for (Source const* source: m_sourceOrder)
-			if (source->ast && !declarationTypeChecker.check(*source->ast))
-				return false;
+			if (source->analysed)
+				for (auto const* contract: ASTNode::filteredNodes<ContractDefinition>(source->ast->nodes()))
+					m_contracts[contract->fullyQualifiedName()].contract = contract;
+
+		timer.next("DeclarationTypeChecker");
+		DeclarationTypeChecker declarationTypeChecker(m_errorReporter, m_evmVersion);
+		if (!analyseSources("DeclarationTypeChecker", true, [&](Source const& _source) {
+			return declarationTypeChecker.check(*_source.ast);
+		}))
+			return false;
 
 		// Next, we check inheritance, overrides, function collisions and other things at
 		// contract or function level.
 		// This also calculates whether a contract is abstract, which is needed by the
 		// type checker.
+		timer.next("ContractLevelChecker");
 		ContractLevelChecker contractLevelChecker(m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast)
-				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-						if (!contractLevelChecker.check(*contract))
-							noErrors = false;
+		if (!analyseSources("ContractLevelChecker", false, [&](Source const& _source) {
+			bool success = true;
+			for (ASTPointer<ASTNode> const& node: _source.ast->nodes())
+				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+					if (!contractLevelChecker.check(*contract))
+						success = false;
+			return success;
+		}))
+			noErrors = false;
 
 		// New we run full type checks that go down to the expression level. This
 		// cannot be done earlier, because we need cross-contract types and information
@@ -374,77 +532,125 @@ bool CompilerStack::analyze()
 		//
 		// Note: this does not resolve overloaded functions. In order to do that, types of arguments are needed,
 		// which is only done one step later.
+		timer.next("TypeChecker");
 		TypeChecker typeChecker(m_evmVersion, m_errorReporter);
-		for (Source const* source: m_sourceOrder)
-			if (source->ast)
-				for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-						if (!typeChecker.checkTypeRequirements(*contract))
-							noErrors = false;
+		if (!analyseSources("TypeChecker", false, [&](Source const& _source) {
+			bool success = true;
+			for (ASTPointer<ASTNode> const& node: _source.ast->nodes())
+				if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+					if (!typeChecker.checkTypeRequirements(*contract))
+						success = false;
+			return success;
+		}))
+			noErrors = false;
 
 		if (noErrors)
 		{
 			// Checks that can only be done when all types of all AST nodes are known.
+			timer.next("PostTypeChecker");
 			PostTypeChecker postTypeChecker(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast && !postTypeChecker.check(*source->ast))
-					noErrors = false;
+			if (!analyseSources("PostTypeChecker", false, [&](Source const& _source) {
+				return postTypeChecker.check(*_source.ast);
+			}))
+				noErrors = false;
 		}
 
 		// Check that immutable variables are never read in c'tors and assigned
 		// exactly once
 		if (noErrors)
-			for (Source const* source: m_sourceOrder)
-				if (source->ast)
-					for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-						if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
-							ImmutableValidator(m_errorReporter, *contract).analyze();
+		{
+			timer.next("ImmutableValidator");
+			analyseSources("ImmutableValidator", false, [&](Source const& _source) {
+				for (ASTPointer<ASTNode> const& node: _source.ast->nodes())
+					if (ContractDefinition* contract = dynamic_cast<ContractDefinition*>(node.get()))
+						ImmutableValidator(m_errorReporter, *contract).analyze();
+				return true;
+			});
+		}
 
 		if (noErrors)
 		{
 			// Control flow graph generator and analyzer. It can check for issues such as
 			// variable is used before it is assigned to.
+			timer.next("ControlFlowAnalyzer");
 			CFG cfg(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast && !cfg.constructFlow(*source->ast))
-					noErrors = false;
+			if (!analyseSources("CFG", false, [&](Source const& _source) {
+				return cfg.constructFlow(*_source.ast);
+			}))
+				noErrors = false;
 
 			if (noErrors)
 			{
 				ControlFlowAnalyzer controlFlowAnalyzer(cfg, m_errorReporter);
-				for (Source const* source: m_sourceOrder)
-					if (source->ast && !controlFlowAnalyzer.analyze(*source->ast))
-						noErrors = false;
+				if (!analyseSources("ControlFlowAnalyzer", false, [&](Source const& _source) {
+					return controlFlowAnalyzer.analyze(*_source.ast);
+				}))
+					noErrors = false;
 			}
 		}
 
 		if (noErrors)
 		{
 			// Checks for common mistakes. Only generates warnings.
+			timer.next("StaticAnalyzer");
 			StaticAnalyzer staticAnalyzer(m_errorReporter);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast && !staticAnalyzer.analyze(*source->ast))
-					noErrors = false;
+			if (!analyseSources("StaticAnalyzer", false, [&](Source const& _source) {
+				return staticAnalyzer.analyze(*_source.ast);
+			}))
+				noErrors = false;
 		}
 
 		if (noErrors)
 		{
 			// Check for state mutability in every function.
+			timer.next("ViewPureChecker");
 			vector<ASTPointer<ASTNode>> ast;
 			for (Source const* source: m_sourceOrder)
-				if (source->ast)
+				if (source->ast && !source->analysed)
 					ast.push_back(source->ast);
 
+			size_t errorCount = m_errorReporter.errors().size();
 			if (!ViewPureChecker(ast, m_errorReporter).check())
 				noErrors = false;
+
+			// The checker visits all sources at once, its errors are attributed to the sources
+			// by their location.
+			map<string, ErrorList> errorsBySource;
+			ErrorList otherErrors;
+			for (size_t i = errorCount; i < m_errorList.size(); ++i)
+				if (
+					SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*m_errorList[i]);
+					location && location->source && m_sources.count(location->source->name())
+				)
+					errorsBySource[location->source->name()].push_back(m_errorList[i]);
+				else
+					otherErrors.push_back(m_errorList[i]);
+			m_errorList.resize(errorCount);
+			analyseSources("ViewPureChecker", false, [&](Source const& _source) {
+				m_errorReporter.append(errorsBySource[_source.scanner->charStream()->name()]);
+				return true;
+			});
+			m_errorReporter.append(otherErrors);
 		}
 
 		if (noErrors)
 		{
-			ModelChecker modelChecker(m_errorReporter, m_smtlib2Responses, m_readFile, m_enabledSMTSolvers);
-			for (Source const* source: m_sourceOrder)
-				if (source->ast)
-					modelChecker.analyze(*source->ast);
+			timer.next("ModelChecker");
+			shared_ptr<smtutil::QueryCache const> queryCache;
+			if (m_cache)
+				queryCache = make_shared<smtutil::QueryCache const>(m_cache->directory() / "smt");
+			ModelChecker modelChecker(
+				m_errorReporter,
+				m_smtlib2Responses,
+				m_readFile,
+				m_enabledSMTSolvers,
+				m_modelCheckerSettings,
+				queryCache
+			);
+			analyseSources("ModelChecker", false, [&](Source const& _source) {
+				modelChecker.analyze(*_source.ast);
+				return true;
+			});
 			m_unhandledSMTLib2Queries += modelChecker.unhandledQueries();
 		}
 	}
@@ -458,6 +664,13 @@ bool CompilerStack::analyze()
 	m_stackState = AnalysisPerformed;
 	if (!noErrors)
 		m_hasError = true;
+	else
+	{
+		set<Source const*> analysedSources(m_sourceOrder.begin(), m_sourceOrder.end());
+		for (auto& source: m_sources)
+			if (analysedSources.count(&source.second))
+				source.second.analysed = true;
+	}
 
 	return !m_hasError;
 }
@@ -505,18 +718,43 @@ bool CompilerStack::compile()
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called compile with errors."));
 
 	// Only compile contracts individually which have been requested.
-	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
-	for (Source const* source: m_sourceOrder)
-		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
-			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
-				if (isRequestedContract(*contract))
-				{
-					compileContract(*contract, otherCompilers);
-					if (m_generateIR || m_generateEwasm)
-						generateIR(*contract);
-					if (m_generateEwasm)
-						generateEwasm(*contract);
-				}
+	vector<ContractDefinition const*> contracts = contractsToCompile();
+	// Restored contracts would have no optimiser statistics.
+	vector<ContractDefinition const*> contractsToGenerate =
+		m_cache && !m_profileOptimiser ? restoreFromCache(contracts) : contracts;
+	if (m_profiler)
+	{
+		m_profiler->count("Compiled contracts", contractsToGenerate.size());
+		m_profiler->count("Contracts restored from cache", contracts.size() - contractsToGenerate.size());
+	}
+	if (m_parallelism > 1 && contractsToGenerate.size() > 1)
+	{
+		compileContractsInParallel(contractsToGenerate);
+		for (ContractDefinition const* contract: contracts)
+			checkContractCodeSize(*contract);
+	}
+	else
+	{
+		// The same order as in a sequential run without the cache, so that the warnings
+		// are reported in the same order.
+		set<ContractDefinition const*> generate(contractsToGenerate.begin(), contractsToGenerate.end());
+		map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+		for (ContractDefinition const* contract: contracts)
+		{
+			if (generate.count(contract))
+			{
+				compileContract(*contract, otherCompilers);
+				if (m_generateIR || m_generateEwasm)
+					generateIR(*contract, m_parallelism);
+				if (m_generateEwasm && isRequestedContract(*contract))
+					generateEwasm(*contract, m_parallelism);
+			}
+			checkContractCodeSize(*contract);
+		}
+	}
+	if (m_cache)
+		for (ContractDefinition const* contract: contractsToGenerate)
+			storeInCache(*contract);
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
@@ -561,7 +799,7 @@ evmasm::AssemblyItems const* CompilerStack::assemblyItems(string const& _contrac
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
 	Contract const& currentContract = contract(_contractName);
-	return currentContract.compiler ? &contract(_contractName).compiler->assemblyItems() : nullptr;
+	return contractCompiler(currentContract) ? &currentContract.compiler->assemblyItems() : nullptr;
 }
 
 evmasm::AssemblyItems const* CompilerStack::runtimeAssemblyItems(string const& _contractName) const
@@ -570,7 +808,7 @@ evmasm::AssemblyItems const* CompilerStack::runtimeAssemblyItems(string const& _
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
 	Contract const& currentContract = contract(_contractName);
-	return currentContract.compiler ? &contract(_contractName).compiler->runtimeAssemblyItems() : nullptr;
+	return contractCompiler(currentContract) ? &currentContract.compiler->runtimeAssemblyItems() : nullptr;
 }
 
 string const* CompilerStack::sourceMapping(string const& _contractName) const
@@ -676,13 +914,13 @@ evmasm::LinkerObject const& CompilerStack::runtimeObject(string const& _contract
 }
 
 /// TODO: cache this string
-string CompilerStack::assemblyString(string const& _contractName, StringMap _sourceCodes) const
+string CompilerStack::assemblyString(string const& _contractName, StringMap const& _sourceCodes) const
 {
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
 	Contract const& currentContract = contract(_contractName);
-	if (currentContract.compiler)
+	if (contractCompiler(currentContract))
 		return currentContract.compiler->assemblyString(_sourceCodes);
 	else
 		return string();
@@ -695,7 +933,7 @@ Json::Value CompilerStack::assemblyJSON(string const& _contractName) const
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
 	Contract const& currentContract = contract(_contractName);
-	if (currentContract.compiler)
+	if (contractCompiler(currentContract))
 		return currentContract.compiler->assemblyJSON(sourceIndices());
 	else
 		return Json::Value();
@@ -853,7 +1091,7 @@ size_t CompilerStack::functionEntryPoint(
 	if (m_stackState != CompilationSuccessful)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
 
-	shared_ptr<Compiler> const& compiler = contract(_contractName).compiler;
+	shared_ptr<Compiler> const& compiler = contractCompiler(contract(_contractName));
 	if (!compiler)
 		return 0;
 	evmasm::AssemblyItem tag = compiler->functionEntryLabel(_function);
@@ -882,14 +1120,20 @@ tuple<int, int, int, int> CompilerStack::positionFromSourceLocation(SourceLocati
 h256 const& CompilerStack::Source::keccak256() const
 {
 	if (keccak256HashCached == h256{})
-		keccak256HashCached = util::keccak256(scanner->source());
+	{
+		string_view source = scanner->source();
+		keccak256HashCached = util::keccak256(bytesConstRef(reinterpret_cast<uint8_t const*>(source.data()), source.size()));
+	}
 	return keccak256HashCached;
 }
 
 h256 const& CompilerStack::Source::swarmHash() const
 {
 	if (swarmHashCached == h256{})
-		swarmHashCached = util::bzzr1Hash(scanner->source());
+	{
+		string_view source = scanner->source();
+		swarmHashCached = util::bzzr1Hash(bytesConstRef(reinterpret_cast<uint8_t const*>(source.data()), source.size()));
+	}
 	return swarmHashCached;
 }
 
@@ -900,10 +1144,10 @@ string const& CompilerStack::Source::ipfsUrl() const
 	return ipfsUrlCached;
 }
 
-StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
+map<string, CharStream> CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string const& _sourcePath)
 {
 	solAssert(m_stackState < ParsingPerformed, "");
-	StringMap newSources;
+	map<string, CharStream> newSources;
 	try
 	{
 		for (auto const& node: _ast.nodes())
@@ -925,7 +1169,12 @@ StringMap CompilerStack::loadMissingSources(SourceUnit const& _ast, std::string
 					result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), importPath);
 
 				if (result.success)
-					newSources[importPath] = result.responseOrErrorMessage;
+					newSources.emplace(
+						importPath,
+						result.contents ?
+						result.contents->withName(importPath) :
+						CharStream(move(result.responseOrErrorMessage), importPath)
+					);
 				else
 				{
 					m_errorReporter.parserError(
@@ -1018,6 +1267,38 @@ void CompilerStack::resolveImports()
 	swap(m_sourceOrder, sourceOrder);
 }
 
+bool CompilerStack::analyseSources(
+	string const& _stepName,
+	bool _stopOnFailure,
+	function<bool(Source const&)> const& _step
+)
+{
+	bool success = true;
+	for (Source const* source: m_sourceOrder)
+	{
+		if (!source->ast)
+			continue;
+		if (source->analysed)
+		{
+			m_errorReporter.append(source->errors[_stepName]);
+			continue;
+		}
+		size_t errorCount = m_errorReporter.errors().size();
+		bool sourceSuccess = _step(*source);
+		source->errors[_stepName] = ErrorList(
+			m_errorReporter.errors().begin() + static_cast<ptrdiff_t>(errorCount),
+			m_errorReporter.errors().end()
+		);
+		if (!sourceSuccess)
+		{
+			success = false;
+			if (_stopOnFailure)
+				break;
+		}
+	}
+	return success;
+}
+
 namespace
 {
 bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& features)
@@ -1029,6 +1310,164 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 }
 }
 
+vector<ContractDefinition const*> CompilerStack::contractsToCompile() const
+{
+	vector<ContractDefinition const*> contracts;
+	set<ContractDefinition const*> visited;
+	function<void(ContractDefinition const&)> addDependencies;
+	function<void(ContractDefinition const&)> addContract = [&](ContractDefinition const& _contract)
+	{
+		if (!_contract.canBeDeployed() || !visited.insert(&_contract).second)
+			return;
+		addDependencies(_contract);
+		contracts.push_back(&_contract);
+	};
+	// Contracts created by base contracts are only dependencies of the base contract, so the
+	// dependencies of base contracts that cannot be deployed are needed, too. They are only
+	// added before the contracts that inherit them, which keeps the order of the contracts
+	// for which this was already the case.
+	set<ContractDefinition const*> visitedBases;
+	addDependencies = [&](ContractDefinition const& _contract)
+	{
+		for (auto const* dependency: _contract.annotation().contractDependencies)
+			if (dependency->canBeDeployed())
+				addContract(*dependency);
+			else if (visitedBases.insert(dependency).second)
+				addDependencies(*dependency);
+	};
+
+	for (Source const* source: m_sourceOrder)
+		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
+			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
+				if (isRequestedContract(*contract))
+					addContract(*contract);
+	return contracts;
+}
+
+void CompilerStack::compileContractsInParallel(vector<ContractDefinition const*> const& _contracts)
+{
+	// The hashes of the sources are computed lazily and used by the metadata of every contract.
+	for (auto const& source: m_sources)
+	{
+		source.second.keccak256();
+		if (!m_metadataLiteralSources)
+		{
+			source.second.swarmHash();
+			source.second.ipfsUrl();
+		}
+	}
+
+	struct Job
+	{
+		/// Indices of the jobs that have to wait for this job.
+		vector<size_t> dependents;
+		/// Number of dependencies that have not finished yet.
+		size_t pendingDependencies = 0;
+		/// Indices of the jobs of all direct and indirect dependencies.
+		set<size_t> embeddedContracts;
+		exception_ptr failure;
+	};
+
+	map<ContractDefinition const*, size_t> jobIndices;
+	for (size_t i = 0; i < _contracts.size(); ++i)
+		jobIndices[_contracts[i]] = i;
+
+	vector<Job> jobs(_contracts.size());
+	// For each job, the last job so far that embeds its contract.
+	map<size_t, size_t> lastEmbeddingJob;
+	for (size_t i = 0; i < _contracts.size(); ++i)
+	{
+		set<size_t> dependencies;
+		set<ContractDefinition const*> visited;
+		function<void(ContractDefinition const&)> addDependencies = [&](ContractDefinition const& _contract)
+		{
+			for (auto const* dependency: _contract.annotation().contractDependencies)
+				if (jobIndices.count(dependency))
+					dependencies.insert(jobIndices.at(dependency));
+				else if (visited.insert(dependency).second)
+					addDependencies(*dependency);
+		};
+		addDependencies(*_contracts[i]);
+
+		for (size_t dependencyIndex: dependencies)
+		{
+			set<size_t> const& indirect = jobs[dependencyIndex].embeddedContracts;
+			jobs[i].embeddedContracts.insert(dependencyIndex);
+			jobs[i].embeddedContracts.insert(indirect.begin(), indirect.end());
+		}
+		// The legacy optimiser modifies the assemblies of embedded contracts, so the jobs
+		// that embed the same contract run one after the other in the order of a sequential
+		// run. Otherwise the result would depend on the order in which they happen to run.
+		for (size_t embedded: jobs[i].embeddedContracts)
+		{
+			if (lastEmbeddingJob.count(embedded))
+				dependencies.insert(lastEmbeddingJob.at(embedded));
+			lastEmbeddingJob[embedded] = i;
+		}
+
+		for (size_t dependencyIndex: dependencies)
+		{
+			solAssert(dependencyIndex < i, "");
+			jobs[dependencyIndex].dependents.push_back(i);
+			jobs[i].pendingDependencies++;
+		}
+	}
+
+	mutex schedulingMutex;
+	map<ContractDefinition const*, shared_ptr<Compiler const>> compilers;
+
+	util::ThreadPool pool(min(m_parallelism, _contracts.size()));
+	function<void(size_t)> schedule = [&](size_t _job)
+	{
+		pool.post([&, _job]()
+		{
+			ContractDefinition const& contract = *_contracts[_job];
+			try
+			{
+				map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+				{
+					lock_guard<mutex> lock(schedulingMutex);
+					for (size_t embedded: jobs[_job].embeddedContracts)
+						otherCompilers[_contracts[embedded]] = compilers.at(_contracts[embedded]);
+				}
+				compileContract(contract, otherCompilers);
+				// The threads are already used by the contracts.
+				if (m_generateIR || m_generateEwasm)
+					generateIR(contract, 1);
+				if (m_generateEwasm && isRequestedContract(contract))
+					generateEwasm(contract, 1);
+			}
+			catch (...)
+			{
+				jobs[_job].failure = current_exception();
+			}
+
+			lock_guard<mutex> lock(schedulingMutex);
+			// Contracts depending on a failed one are not compiled at all.
+			if (jobs[_job].failure)
+				return;
+			compilers[&contract] = m_contracts.at(contract.fullyQualifiedName()).compiler;
+			for (size_t dependent: jobs[_job].dependents)
+				if (--jobs[dependent].pendingDependencies == 0)
+					schedule(dependent);
+		});
+	};
+
+	{
+		// Finished jobs schedule their dependents, so a job whose dependencies finished
+		// already must not be scheduled here again.
+		lock_guard<mutex> lock(schedulingMutex);
+		for (size_t i = 0; i < jobs.size(); ++i)
+			if (jobs[i].pendingDependencies == 0)
+				schedule(i);
+	}
+	pool.wait();
+
+	for (Job const& job: jobs)
+		if (job.failure)
+			rethrow_exception(job.failure);
+}
+
 void CompilerStack::compileContract(
 	ContractDefinition const& _contract,
 	map<ContractDefinition const*, shared_ptr<Compiler const>>& _otherCompilers
@@ -1046,12 +1485,19 @@ void CompilerStack::compileContract(
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
 	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	if (m_profileOptimiser)
+		compiler->setOptimiserProfile(&compiledContract.optimiserProfile);
+	compiler->setProfiler(m_profiler);
 	compiledContract.compiler = compiler;
 
-	bytes cborEncodedMetadata = createCBORMetadata(
-		metadata(compiledContract),
-		!onlySafeExperimentalFeaturesActivated(_contract.sourceUnit().annotation().experimentalFeatures)
-	);
+	bytes cborEncodedMetadata;
+	{
+		util::ScopedTimer timer(m_profiler, "Metadata", _contract.fullyQualifiedName());
+		cborEncodedMetadata = createCBORMetadata(
+			metadata(compiledContract),
+			!onlySafeExperimentalFeaturesActivated(_contract.sourceUnit().annotation().experimentalFeatures)
+		);
+	}
 
 	try
 	{
@@ -1063,6 +1509,7 @@ void CompilerStack::compileContract(
 		solAssert(false, "Optimizer exception during compilation");
 	}
 
+	util::ScopedTimer timer(m_profiler, "Assembly", _contract.fullyQualifiedName());
 	try
 	{
 		// Assemble deployment (incl. runtime)  object.
@@ -1083,6 +1530,13 @@ void CompilerStack::compileContract(
 		solAssert(false, "Assembly exception for deployed bytecode");
 	}
 
+	_otherCompilers[compiledContract.contract] = compiler;
+}
+
+void CompilerStack::checkContractCodeSize(ContractDefinition const& _contract)
+{
+	Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+
 	// Throw a warning if EIP-170 limits are exceeded:
 	//   If contract creation initialization returns data with length of more than 0x6000 (214 + 213) bytes,
 	//   contract creation fails with an out of gas error.
@@ -1098,11 +1552,266 @@ void CompilerStack::compileContract(
 			"Consider enabling the optimizer (with a low \"runs\" value!), "
 			"turning off revert strings, or using libraries."
 		);
+}
 
-	_otherCompilers[compiledContract.contract] = compiler;
+namespace
+{
+
+Json::Value linkerObjectToJson(evmasm::LinkerObject const& _object)
+{
+	Json::Value ret(Json::objectValue);
+	ret["bytecode"] = util::toHex(_object.bytecode);
+	ret["linkReferences"] = Json::objectValue;
+	for (auto const& [offset, library]: _object.linkReferences)
+		ret["linkReferences"][to_string(offset)] = library;
+	ret["immutableReferences"] = Json::arrayValue;
+	for (auto const& [hash, immutable]: _object.immutableReferences)
+	{
+		Json::Value reference(Json::objectValue);
+		reference["hash"] = hash.str();
+		reference["name"] = immutable.first;
+		reference["offsets"] = Json::arrayValue;
+		for (size_t offset: immutable.second)
+			reference["offsets"].append(Json::LargestUInt(offset));
+		ret["immutableReferences"].append(reference);
+	}
+	return ret;
+}
+
+bool isDecimalNumber(string const& _value)
+{
+	return !_value.empty() && all_of(_value.begin(), _value.end(), [](char _c) { return '0' <= _c && _c <= '9'; });
 }
 
-void CompilerStack::generateIR(ContractDefinition const& _contract)
+optional<evmasm::LinkerObject> linkerObjectFromJson(Json::Value const& _object)
+{
+	if (
+		!_object.isObject() ||
+		!_object["bytecode"].isString() ||
+		!_object["linkReferences"].isObject() ||
+		!_object["immutableReferences"].isArray()
+	)
+		return nullopt;
+
+	evmasm::LinkerObject ret;
+	string const& bytecode = _object["bytecode"].asString();
+	ret.bytecode = util::fromHex(bytecode);
+	if (ret.bytecode.size() * 2 != bytecode.size())
+		return nullopt;
+	for (string const& offset: _object["linkReferences"].getMemberNames())
+	{
+		if (!isDecimalNumber(offset) || !_object["linkReferences"][offset].isString())
+			return nullopt;
+		ret.linkReferences[stoul(offset)] = _object["linkReferences"][offset].asString();
+	}
+	for (Json::Value const& reference: _object["immutableReferences"])
+	{
+		if (
+			!reference["hash"].isString() ||
+			!isDecimalNumber(reference["hash"].asString()) ||
+			!reference["name"].isString() ||
+			!reference["offsets"].isArray()
+		)
+			return nullopt;
+		auto& immutable = ret.immutableReferences[u256(reference["hash"].asString())];
+		immutable.first = reference["name"].asString();
+		for (Json::Value const& offset: reference["offsets"])
+		{
+			if (!offset.isUInt64())
+				return nullopt;
+			immutable.second.push_back(offset.asUInt64());
+		}
+	}
+	return ret;
+}
+
+/// Artifacts of a contract that are stored in the compilation cache.
+struct CachedContract
+{
+	evmasm::LinkerObject object;
+	evmasm::LinkerObject runtimeObject;
+	string sourceMapping;
+	string runtimeSourceMapping;
+	string yulIR;
+	string yulIROptimized;
+	string ewasm;
+	evmasm::LinkerObject ewasmObject;
+};
+
+optional<CachedContract> cachedContractFromJson(Json::Value const& _entry)
+{
+	for (char const* member: {"sourceMap", "runtimeSourceMap", "ir", "irOptimized", "ewasm"})
+		if (!_entry[member].isString())
+			return nullopt;
+
+	optional<evmasm::LinkerObject> object = linkerObjectFromJson(_entry["object"]);
+	optional<evmasm::LinkerObject> runtimeObject = linkerObjectFromJson(_entry["runtimeObject"]);
+	optional<evmasm::LinkerObject> ewasmObject = linkerObjectFromJson(_entry["ewasmObject"]);
+	if (!object || !runtimeObject || !ewasmObject)
+		return nullopt;
+
+	return CachedContract{
+		move(*object),
+		move(*runtimeObject),
+		_entry["sourceMap"].asString(),
+		_entry["runtimeSourceMap"].asString(),
+		_entry["ir"].asString(),
+		_entry["irOptimized"].asString(),
+		_entry["ewasm"].asString(),
+		move(*ewasmObject)
+	};
+}
+
+}
+
+vector<ContractDefinition const*> CompilerStack::restoreFromCache(vector<ContractDefinition const*> const& _contracts)
+{
+	solAssert(m_cache, "");
+
+	map<ContractDefinition const*, CachedContract> cachedContracts;
+	for (ContractDefinition const* contract: _contracts)
+		if (optional<Json::Value> entry = m_cache->load(cacheKey(m_contracts.at(contract->fullyQualifiedName()))))
+			if (optional<CachedContract> cachedContract = cachedContractFromJson(*entry))
+				cachedContracts.emplace(contract, move(*cachedContract));
+
+	// The code generator needs the compilers of all contracts created by a contract it compiles,
+	// so these are compiled, too. Contracts are listed after their dependencies, which are
+	// therefore visited after the contracts that create them.
+	for (auto it = _contracts.rbegin(); it != _contracts.rend(); ++it)
+		if (!cachedContracts.count(*it))
+		{
+			set<ContractDefinition const*> visited;
+			function<void(ContractDefinition const&)> compileDependencies = [&](ContractDefinition const& _contract)
+			{
+				for (auto const* dependency: _contract.annotation().contractDependencies)
+					if (visited.insert(dependency).second)
+					{
+						cachedContracts.erase(dependency);
+						compileDependencies(*dependency);
+					}
+			};
+			compileDependencies(**it);
+		}
+
+	vector<ContractDefinition const*> remainingContracts;
+	for (ContractDefinition const* contract: _contracts)
+	{
+		auto cachedContract = cachedContracts.find(contract);
+		if (cachedContract == cachedContracts.end())
+		{
+			remainingContracts.push_back(contract);
+			continue;
+		}
+
+		Contract& compiledContract = m_contracts.at(contract->fullyQualifiedName());
+		CachedContract& artifacts = cachedContract->second;
+		compiledContract.restoredFromCache = true;
+		compiledContract.object = move(artifacts.object);
+		compiledContract.runtimeObject = move(artifacts.runtimeObject);
+		compiledContract.sourceMapping.emplace(move(artifacts.sourceMapping));
+		compiledContract.runtimeSourceMapping.emplace(move(artifacts.runtimeSourceMapping));
+		compiledContract.yulIR = move(artifacts.yulIR);
+		compiledContract.yulIROptimized = move(artifacts.yulIROptimized);
+		compiledContract.ewasm = move(artifacts.ewasm);
+		compiledContract.ewasmObject = move(artifacts.ewasmObject);
+	}
+	return remainingContracts;
+}
+
+void CompilerStack::storeInCache(ContractDefinition const& _contract) const
+{
+	solAssert(m_cache, "");
+
+	Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	solAssert(compiledContract.compiler, "");
+	Compiler const& compiler = *compiledContract.compiler;
+	if (!compiledContract.sourceMapping)
+		compiledContract.sourceMapping.emplace(
+			evmasm::AssemblyItem::computeSourceMapping(compiler.assemblyItems(), sourceIndices())
+		);
+	if (!compiledContract.runtimeSourceMapping)
+		compiledContract.runtimeSourceMapping.emplace(
+			evmasm::AssemblyItem::computeSourceMapping(compiler.runtimeAssemblyItems(), sourceIndices())
+		);
+
+	Json::Value entry(Json::objectValue);
+	entry["object"] = linkerObjectToJson(compiledContract.object);
+	entry["runtimeObject"] = linkerObjectToJson(compiledContract.runtimeObject);
+	entry["sourceMap"] = *compiledContract.sourceMapping;
+	entry["runtimeSourceMap"] = *compiledContract.runtimeSourceMapping;
+	entry["ir"] = compiledContract.yulIR;
+	entry["irOptimized"] = compiledContract.yulIROptimized;
+	entry["ewasm"] = compiledContract.ewasm;
+	entry["ewasmObject"] = linkerObjectToJson(compiledContract.ewasmObject);
+	m_cache->store(cacheKey(compiledContract), entry);
+}
+
+util::h256 CompilerStack::cacheKey(Contract const& _contract) const
+{
+	Json::Value key(Json::objectValue);
+	key["compiler"] = VersionString;
+	// The metadata covers the sources, the settings and the ABI of the contract.
+	key["metadata"] = metadata(_contract);
+	// Source mappings refer to sources by their index in the whole compilation.
+	key["sources"] = Json::arrayValue;
+	for (auto const& source: sourceIndices())
+		key["sources"].append(source.first);
+
+	Json::Value& optimizer = key["optimizer"];
+	optimizer["orderLiterals"] = m_optimiserSettings.runOrderLiterals;
+	optimizer["jumpdestRemover"] = m_optimiserSettings.runJumpdestRemover;
+	optimizer["peephole"] = m_optimiserSettings.runPeephole;
+	optimizer["deduplicate"] = m_optimiserSettings.runDeduplicate;
+	optimizer["cse"] = m_optimiserSettings.runCSE;
+	optimizer["constantOptimizer"] = m_optimiserSettings.runConstantOptimiser;
+	optimizer["yul"] = m_optimiserSettings.runYulOptimiser;
+	optimizer["stackAllocation"] = m_optimiserSettings.optimizeStackAllocation;
+	optimizer["optimizerSteps"] = m_optimiserSettings.yulOptimiserSteps;
+	optimizer["runs"] = Json::LargestUInt(m_optimiserSettings.expectedExecutionsPerDeployment);
+	key["evmVersion"] = m_evmVersion.name();
+	key["revertStrings"] = revertStringsToString(m_revertStrings);
+
+	key["ir"] = m_generateIR || m_generateEwasm;
+	key["ewasm"] = m_generateEwasm && isRequestedContract(*_contract.contract);
+	return util::keccak256(util::jsonCompactPrint(key));
+}
+
+shared_ptr<Compiler> const& CompilerStack::contractCompiler(Contract const& _contract) const
+{
+	if (_contract.compiler || !_contract.restoredFromCache)
+		return _contract.compiler;
+
+	// The contracts created by this contract might have been restored from the cache, too.
+	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	set<ContractDefinition const*> visited;
+	function<void(ContractDefinition const&)> addDependencies = [&](ContractDefinition const& _contract)
+	{
+		for (auto const* dependency: _contract.annotation().contractDependencies)
+			if (visited.insert(dependency).second)
+			{
+				if (dependency->canBeDeployed())
+					otherCompilers[dependency] = contractCompiler(m_contracts.at(dependency->fullyQualifiedName()));
+				addDependencies(*dependency);
+			}
+	};
+	addDependencies(*_contract.contract);
+
+	auto compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	compiler->compileContract(
+		*_contract.contract,
+		otherCompilers,
+		createCBORMetadata(
+			metadata(_contract),
+			!onlySafeExperimentalFeaturesActivated(_contract.contract->sourceUnit().annotation().experimentalFeatures)
+		)
+	);
+	// Assembling determines the positions of the tags, which the gas estimator relies on.
+	compiler->assembledObject();
+	_contract.compiler = move(compiler);
+	return _contract.compiler;
+}
+
+void CompilerStack::generateIR(ContractDefinition const& _contract, size_t _parallelism)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 	if (m_hasError)
@@ -1120,32 +1829,47 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 	string dependenciesSource;
 	for (auto const* dependency: _contract.annotation().contractDependencies)
 	{
-		generateIR(*dependency);
+		generateIR(*dependency, _parallelism);
 		otherYulSources.emplace(dependency, m_contracts.at(dependency->fullyQualifiedName()).yulIR);
 	}
 
-	IRGenerator generator(m_evmVersion, m_revertStrings, m_optimiserSettings);
-	tie(compiledContract.yulIR, compiledContract.yulIROptimized) = generator.run(_contract, otherYulSources);
+	util::ScopedTimer timer(m_profiler, "IR generation", _contract.fullyQualifiedName());
+	IRGenerator generator(
+		m_evmVersion,
+		m_revertStrings,
+		m_optimiserSettings,
+		m_profileOptimiser ? &compiledContract.optimiserProfile : nullptr,
+		_parallelism
+	);
+	shared_ptr<yul::Object> optimizedObject;
+	tie(compiledContract.yulIR, optimizedObject) = generator.run(_contract, otherYulSources);
+	compiledContract.yulIROptimized = IRGenerator::print(*optimizedObject, m_evmVersion);
+	if (m_generateEwasm && isRequestedContract(_contract))
+		compiledContract.yulIROptimizedObject = move(optimizedObject);
 }
 
-void CompilerStack::generateEwasm(ContractDefinition const& _contract)
+void CompilerStack::generateEwasm(ContractDefinition const& _contract, size_t _parallelism)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 	if (m_hasError)
 		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Called generateEwasm with errors."));
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
 	if (!compiledContract.ewasm.empty())
 		return;
+	solAssert(compiledContract.yulIROptimizedObject, "");
 
-	// Re-parse the Yul IR in EVM dialect
+	util::ScopedTimer timer(m_profiler, "Ewasm generation", _contract.fullyQualifiedName());
 	yul::AssemblyStack stack(m_evmVersion, yul::AssemblyStack::Language::StrictAssembly, m_optimiserSettings);
-	stack.parseAndAnalyze("", compiledContract.yulIROptimized);
+	bool analysisSuccessful = stack.analyze(move(compiledContract.yulIROptimizedObject));
+	solAssert(analysisSuccessful, "");
 
+	stack.enableOptimiserProfile(m_profileOptimiser);
+	stack.setParallelism(_parallelism);
 	stack.optimize();
 	stack.translate(yul::AssemblyStack::Language::Ewasm);
 	stack.optimize();
+	compiledContract.optimiserProfile.merge(stack.optimiserProfile());
 
 	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
 
@@ -1219,7 +1943,7 @@ string CompilerStack::createMetadata(Contract const& _contract) const
 		if (optional<string> licenseString = s.second.ast->licenseString())
 			meta["sources"][s.first]["license"] = *licenseString;
 		if (m_metadataLiteralSources)
-			meta["sources"][s.first]["content"] = s.second.scanner->source();
+			meta["sources"][s.first]["content"] = string(s.second.scanner->source());
 		else
 		{
 			meta["sources"][s.first]["urls"] = Json::arrayValue;
@@ -1375,7 +2099,7 @@ private:
 	bytes m_data;
 };
 
-bytes CompilerStack::createCBORMetadata(string const& _metadata, bool _experimentalMode)
+bytes CompilerStack::createCBORMetadata(string const& _metadata, bool _experimentalMode) const
 {
 	MetadataCBOREncoder encoder;
 
@@ -1408,6 +2132,14 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 }
 
+Json::Value CompilerStack::optimiserProfile(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		BOOST_THROW_EXCEPTION(CompilerError() << errinfo_comment("Compilation was not successful."));
+
+	return contract(_contractName).optimiserProfile.toJson();
+}
+
 Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include <libsolidity/formal/ModelCheckerSettings.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/Version.h>
@@ -30,12 +31,15 @@
 
 #include <libsmtutil/SolverInterface.h>
 
+#include <liblangutil/CharStream.h>
 #include <liblangutil/ErrorReporter.h>
 #include <liblangutil/EVMVersion.h>
 #include <liblangutil/SourceLocation.h>
 
 #include <libevmasm/LinkerObject.h>
 
+#include <libyul/optimiser/OptimiserProfile.h>
+
 #include <libsolutil/Common.h>
 #include <libsolutil/FixedHash.h>
 #include <libsolutil/LazyInit.h>
@@ -63,16 +67,28 @@ class AssemblyItem;
 using AssemblyItems = std::vector<AssemblyItem>;
 }
 
+namespace solidity::yul
+{
+struct Object;
+}
+
+namespace solidity::util
+{
+class Profiler;
+}
+
 namespace solidity::frontend
 {
 
 // forward declarations
 class ASTNode;
+class CompilationCache;
 class ContractDefinition;
 class FunctionDefinition;
 class SourceUnit;
 class Compiler;
 class GlobalContext;
+class NameAndTypeResolver;
 class Natspec;
 class DeclarationContainer;
 
@@ -166,6 +182,10 @@ public:
 	/// Set which SMT solvers should be enabled.
 	void setSMTSolverChoice(smtutil::SMTSolverChoice _enabledSolvers);
 
+	/// Set the settings of the model checker.
+	/// Must be set before parsing.
+	void setModelCheckerSettings(ModelCheckerSettings _settings);
+
 	/// Sets the requested contract names by source.
 	/// If empty, no filtering is performed and every contract
 	/// found in the supplied sources is compiled.
@@ -175,12 +195,32 @@ public:
 		m_requestedContractNames = _contractNames;
 	}
 
+	/// Sets the maximum number of contracts that are compiled concurrently.
+	/// Contracts are only compiled after the contracts they depend on, so that
+	/// the output does not depend on this setting.
+	/// Must be set before compiling.
+	void setParallelism(size_t _parallelism);
+
+	/// Enables reusing the artifacts of contracts compiled by earlier runs, which are stored in
+	/// the directory @a _directory. Outputs that need the assembly of a contract (assembly,
+	/// gas estimates) compile it again on demand.
+	/// Cleared iff @a _directory is empty. Must be set before compiling.
+	void setCacheDirectory(std::string const& _directory = std::string{});
+
 	/// Enable experimental generation of Yul IR code.
 	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
 
 	/// Enable experimental generation of Ewasm code. If enabled, IR is also generated.
 	void enableEwasmGeneration(bool _enable = true) { m_generateEwasm = _enable; }
 
+	/// Enables collecting statistics about the runs of the Yul optimiser steps for each contract.
+	/// Contracts are not restored from the compilation cache if this is enabled.
+	void enableOptimiserProfile(bool _enable = true) { m_profileOptimiser = _enable; }
+
+	/// Records the time and memory taken by the phases of the compilation in @a _profiler,
+	/// which has to outlive the compiler stack. Recording is disabled if it is null.
+	void setProfiler(util::Profiler* _profiler) { m_profiler = _profiler; }
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
 	/// Must be set before parsing.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
@@ -192,6 +232,20 @@ public:
 
 	/// Sets the sources. Must be set before parsing.
 	void setSources(StringMap _sources);
+	/// Sets the sources without copying their contents, e.g. from mapped files.
+	/// The character streams are renamed to the source unit names. Must be set before parsing.
+	void setSourceStreams(std::map<std::string, langutil::CharStream> _sources);
+
+	/// Replaces the sources after a previous analysis, keeping all settings. The next call to
+	/// parse() and analyze() only parses and analyses the sources whose content changed
+	/// and the sources that import them directly or indirectly, the ASTs and annotations of
+	/// the other sources are reused. Sources that were loaded through the import callback
+	/// are treated like removed sources unless they are part of @a _sources.
+	/// Everything is parsed and analysed again if the previous analysis was not successful.
+	/// Can be called in any state.
+	/// Note that the node IDs of the reused ASTs are kept, so they can differ from the IDs
+	/// assigned by a fresh compilation.
+	void updateSources(StringMap _sources);
 
 	/// Adds a response to an SMTLib2 query (identified by the hash of the query input).
 	/// Must be set before parsing.
@@ -284,7 +338,7 @@ public:
 	/// @return a verbose text representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
 	/// Prerequisite: Successful compilation.
-	std::string assemblyString(std::string const& _contractName, StringMap _sourceCodes = StringMap()) const;
+	std::string assemblyString(std::string const& _contractName, StringMap const& _sourceCodes = StringMap()) const;
 
 	/// @returns a JSON representation of the assembly.
 	/// @arg _sourceCodes is the map of input files to source code strings
@@ -316,6 +370,10 @@ public:
 	/// @returns a JSON representing the estimated gas usage for contract creation, internal and external functions
 	Json::Value gasEstimates(std::string const& _contractName) const;
 
+	/// @returns a JSON object with statistics about the runs of the Yul optimiser steps while compiling
+	/// the contract, see yul::OptimiserProfile::toJson. Empty unless enabled before compiling.
+	Json::Value optimiserProfile(std::string const& _contractName) const;
+
 	/// Overwrites the release/prerelease flag. Should only be used for testing.
 	void overwriteReleaseFlag(bool release) { m_release = release; }
 private:
@@ -324,6 +382,11 @@ private:
 	{
 		std::shared_ptr<langutil::Scanner> scanner;
 		std::shared_ptr<SourceUnit> ast;
+		/// True if the analysis of the AST succeeded and can be reused by updateSources.
+		bool analysed = false;
+		/// The errors reported for this source by each step of parsing and analysis. They are
+		/// reported again at the same place if the source is kept by updateSources.
+		std::map<std::string, langutil::ErrorList> mutable errors;
 		util::h256 mutable keccak256HashCached;
 		util::h256 mutable swarmHashCached;
 		std::string mutable ipfsUrlCached;
@@ -337,11 +400,15 @@ private:
 	struct Contract
 	{
 		ContractDefinition const* contract = nullptr;
-		std::shared_ptr<Compiler> compiler;
+		/// Null for contracts restored from the compilation cache until their assembly is needed.
+		mutable std::shared_ptr<Compiler> compiler;
+		bool restoredFromCache = false;
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Experimental Yul IR code.
 		std::string yulIROptimized; ///< Optimized experimental Yul IR code.
+		/// Optimized experimental Yul IR, only kept if it is translated to Ewasm.
+		std::shared_ptr<yul::Object> yulIROptimizedObject;
 		std::string ewasm; ///< Experimental Ewasm text representation
 		evmasm::LinkerObject ewasmObject; ///< Experimental Ewasm code
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
@@ -351,21 +418,44 @@ private:
 		util::LazyInit<Json::Value const> devDocumentation;
 		mutable std::optional<std::string const> sourceMapping;
 		mutable std::optional<std::string const> runtimeSourceMapping;
+		yul::OptimiserProfile optimiserProfile; ///< Statistics about the Yul optimiser steps, if enabled.
 	};
 
 	/// Loads the missing sources from @a _ast (named @a _path) using the callback
 	/// @a m_readFile and stores the absolute paths of all imports in the AST annotations.
 	/// @returns the newly loaded sources.
-	StringMap loadMissingSources(SourceUnit const& _ast, std::string const& _path);
+	std::map<std::string, langutil::CharStream> loadMissingSources(SourceUnit const& _ast, std::string const& _path);
 	std::string applyRemapping(std::string const& _path, std::string const& _context);
 	void resolveImports();
 
+	/// Runs the analysis step @a _step on the sources in @a m_sourceOrder. For the sources
+	/// kept by updateSources, the errors that @a _step reported for them before are reported
+	/// again instead, so that the errors are in the same order as in a full analysis.
+	/// If @a _stopOnFailure, the sources after the first one for which @a _step fails are skipped.
+	/// @returns false if @a _step failed for any source.
+	bool analyseSources(
+		std::string const& _stepName,
+		bool _stopOnFailure,
+		std::function<bool(Source const&)> const& _step
+	);
+
 	/// @returns true if the source is requested to be compiled.
 	bool isRequestedSource(std::string const& _sourceName) const;
 
 	/// @returns true if the contract is requested to be compiled.
 	bool isRequestedContract(ContractDefinition const& _contract) const;
 
+	/// @returns the requested contracts that can be deployed, together with all the deployable
+	/// contracts they depend on. Every contract is listed after its dependencies, otherwise
+	/// in the order of the sources.
+	std::vector<ContractDefinition const*> contractsToCompile() const;
+
+	/// Compiles the contracts in @a _contracts, which have to be in the order returned by
+	/// contractsToCompile(), on m_parallelism worker threads. A contract is only compiled
+	/// after all its dependencies. If compilation fails for some contracts, the error of
+	/// the first of those contracts in @a _contracts is rethrown.
+	void compileContractsInParallel(std::vector<ContractDefinition const*> const& _contracts);
+
 	/// Compile a single contract.
 	/// @param _otherCompilers provides access to compilers of other contracts, to get
 	///                        their bytecode if needed. Only filled after they have been compiled.
@@ -374,12 +464,31 @@ private:
 		std::map<ContractDefinition const*, std::shared_ptr<Compiler const>>& _otherCompilers
 	);
 
-	/// Generate Yul IR for a single contract.
+	/// Warns if the runtime code of a compiled contract exceeds the limit of EIP-170.
+	void checkContractCodeSize(ContractDefinition const& _contract);
+
+	/// Restores the contracts in @a _contracts that are found in the compilation cache, unless
+	/// a contract that has to be compiled creates them. @returns the remaining contracts in
+	/// their original order.
+	std::vector<ContractDefinition const*> restoreFromCache(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Stores the artifacts of @a _contract in the compilation cache.
+	void storeInCache(ContractDefinition const& _contract) const;
+
+	/// @returns the key of @a _contract in the compilation cache.
+	util::h256 cacheKey(Contract const& _contract) const;
+
+	/// @returns the compiler of @a _contract, which is run first if the contract was
+	/// restored from the compilation cache.
+	std::shared_ptr<Compiler> const& contractCompiler(Contract const& _contract) const;
+
+	/// Generate Yul IR for a single contract, optimising it on up to @a _parallelism threads.
 	/// The IR is stored but otherwise unused.
-	void generateIR(ContractDefinition const& _contract);
+	void generateIR(ContractDefinition const& _contract, size_t _parallelism);
 
-	/// Generate Ewasm representation for a single contract.
-	void generateEwasm(ContractDefinition const& _contract);
+	/// Generate Ewasm representation for a single contract, optimising it on up to
+	/// @a _parallelism threads.
+	void generateEwasm(ContractDefinition const& _contract, size_t _parallelism);
 
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
@@ -401,7 +510,7 @@ private:
 	std::string createMetadata(Contract const& _contract) const;
 
 	/// @returns the metadata CBOR for the given serialised metadata JSON.
-	bytes createCBORMetadata(std::string const& _metadata, bool _experimentalMode);
+	bytes createCBORMetadata(std::string const& _metadata, bool _experimentalMode) const;
 
 	/// @returns the contract ABI as a JSON object.
 	/// This will generate the JSON object and store it in the Contract object if it is not present yet.
@@ -435,9 +544,14 @@ private:
 	RevertStrings m_revertStrings = RevertStrings::Default;
 	langutil::EVMVersion m_evmVersion;
 	smtutil::SMTSolverChoice m_enabledSMTSolvers;
+	ModelCheckerSettings m_modelCheckerSettings;
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateIR;
 	bool m_generateEwasm;
+	bool m_profileOptimiser = false;
+	util::Profiler* m_profiler = nullptr;
+	size_t m_parallelism = 1;
+	std::shared_ptr<CompilationCache const> m_cache;
 	std::map<std::string, util::h160> m_libraries;
 	/// list of path prefix remappings, e.g. mylibrary: github.com/ethereum = /usr/local/ethereum
 	/// "context:prefix=target"
@@ -448,6 +562,12 @@ private:
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<util::h256, std::string> m_smtlib2Responses;
 	std::shared_ptr<GlobalContext> m_globalContext;
+	/// The resolver that registered the declarations of all analysed sources. It is reused
+	/// for the changed sources after updateSources.
+	std::shared_ptr<NameAndTypeResolver> m_resolver;
+	/// ASTs replaced by updateSources. They are kept until the next full analysis because
+	/// the analysis state refers to AST nodes by their address.
+	std::vector<std::shared_ptr<SourceUnit>> m_retiredASTs;
 	std::vector<Source const*> m_sourceOrder;
 	std::map<std::string const, Contract> m_contracts;
 	langutil::ErrorList m_errorList;
@@ -17,10 +17,12 @@
 
 #pragma once
 
+#include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
 #include <boost/noncopyable.hpp>
 #include <functional>
+#include <optional>
 #include <string>
 
 namespace solidity::frontend
@@ -34,6 +36,9 @@ public:
 	{
 		bool success;
 		std::string responseOrErrorMessage;
+		/// Contents of a successfully read file that the callback can provide without copying
+		/// them, e.g. from a mapped file. Used instead of responseOrErrorMessage if set.
+		std::optional<langutil::CharStream> contents = std::nullopt;
 	};
 
 	enum class Kind
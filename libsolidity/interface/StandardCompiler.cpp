@@ -36,7 +36,12 @@
 #include <boost/algorithm/string/predicate.hpp>
 
 #include <algorithm>
+#include <cctype>
+#include <istream>
+#include <iterator>
 #include <optional>
+#include <ostream>
+#include <set>
 
 using namespace std;
 using namespace solidity;
@@ -170,11 +175,13 @@ bool hashMatchesContent(string const& _hash, string const& _content)
 bool isArtifactRequested(Json::Value const& _outputSelection, string const& _artifact, bool _wildcardMatchesExperimental)
 {
 	static set<string> experimental{"ir", "irOptimized", "wast", "ewasm", "ewasm.wast"};
+	// The optimizer profile contains timings and slows down the optimizer, so it is never matched by "*".
+	static set<string> explicitOnly{"evm.optimizerProfile"};
 	for (auto const& artifact: _outputSelection)
 		/// @TODO support sub-matching, e.g "evm" matches "evm.assembly"
 		if (artifact == _artifact)
 			return true;
-		else if (artifact == "*")
+		else if (artifact == "*" && explicitOnly.count(_artifact) == 0)
 		{
 			// "ir", "irOptimized", "wast" and "ewasm.wast" can only be matched by "*" if activated.
 			if (experimental.count(_artifact) == 0 || _wildcardMatchesExperimental)
@@ -245,7 +252,7 @@ bool isBinaryRequested(Json::Value const& _outputSelection)
 		"evm.deployedBytecode.immutableReferences",
 		"evm.bytecode", "evm.bytecode.object", "evm.bytecode.opcodes", "evm.bytecode.sourceMap",
 		"evm.bytecode.linkReferences",
-		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly"
+		"evm.gasEstimates", "evm.legacyAssembly", "evm.assembly", "evm.optimizerProfile"
 	};
 
 	for (auto const& fileRequests: _outputSelection)
@@ -291,6 +298,21 @@ bool isIRRequested(Json::Value const& _outputSelection)
 	return false;
 }
 
+/// @returns true if the optimizer profile was requested for any contract.
+bool isOptimizerProfileRequested(Json::Value const& _outputSelection)
+{
+	if (!_outputSelection.isObject())
+		return false;
+
+	for (auto const& fileRequests: _outputSelection)
+		for (auto const& requests: fileRequests)
+			for (auto const& request: requests)
+				if (request == "evm.optimizerProfile")
+					return true;
+
+	return false;
+}
+
 Json::Value formatLinkReferences(std::map<size_t, std::string> const& linkReferences)
 {
 	Json::Value ret(Json::objectValue);
@@ -383,7 +405,7 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "optimizer", "outputSelection", "remappings"};
+	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "parallelism", "remappings"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -557,8 +579,293 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 	return { std::move(settings) };
 }
 
+/// Reads a JSON object from a stream one member at a time, so that only the text of the
+/// current member has to be held in memory. Errors are reported in the format of jsoncpp.
+class JsonObjectReader
+{
+public:
+	explicit JsonObjectReader(istream& _stream): m_stream(_stream) {}
+
+	/// Skips whitespace and @returns the next character without consuming it, or EOF.
+	int peek()
+	{
+		skipWhitespace();
+		return m_stream.peek();
+	}
+
+	/// Skips whitespace and @returns it.
+	string skipWhitespace()
+	{
+		string whitespace;
+		while (isWhitespace(m_stream.peek()))
+			whitespace.push_back(char(get()));
+		return whitespace;
+	}
+
+	/// Reads the next value.
+	/// @returns nullopt and sets the error if it is not valid.
+	optional<Json::Value> readValue()
+	{
+		peek();
+		size_t line = m_line;
+		size_t column = m_column;
+		string text = readValueText();
+		Json::Value value;
+		string errors;
+		static Json::CharReaderBuilder const builder = []() {
+			Json::CharReaderBuilder builder;
+			Json::CharReaderBuilder::strictMode(&builder.settings_);
+			builder.settings_["strictRoot"] = false;
+			return builder;
+		}();
+		unique_ptr<Json::CharReader> reader(builder.newCharReader());
+		if (reader->parse(text.data(), text.data() + text.size(), &value, &errors))
+			return value;
+		m_error = relocateErrors(errors, line, column);
+		return nullopt;
+	}
+
+	/// Reads the members of an object, calling @a _readMember with the name of each member
+	/// to read its value. @returns false and sets the error if the object is not valid or
+	/// @a _readMember returns false.
+	bool readMembers(function<bool(string const&)> const& _readMember)
+	{
+		if (!consume('{'))
+			return fail("Syntax error: value, object or array expected.");
+		set<string> names;
+		if (consume('}'))
+			return true;
+		do
+		{
+			if (peek() != '"')
+				return fail("Missing '}' or object member name");
+			size_t line = m_line;
+			size_t column = m_column;
+			optional<Json::Value> name = readValue();
+			if (!name)
+				return false;
+			if (!names.insert(name->asString()).second)
+				return fail("Duplicate key: '" + name->asString() + "'", line, column);
+			if (!consume(':'))
+				return fail("Missing ':' after object member name");
+			if (!_readMember(name->asString()))
+				return false;
+		}
+		while (consume(','));
+		if (!consume('}'))
+			return fail("Missing ',' or '}' in object declaration");
+		return true;
+	}
+
+	/// @returns false and sets the error if anything but whitespace is left.
+	bool expectEnd()
+	{
+		return peek() == EOF || fail("Extra non-whitespace after JSON value.");
+	}
+
+	std::string const& error() const { return m_error; }
+
+private:
+	/// @returns true if @a _c is whitespace in JSON, which unlike isspace excludes \v and \f.
+	static bool isWhitespace(int _c)
+	{
+		return _c == ' ' || _c == '\t' || _c == '\n' || _c == '\r';
+	}
+
+	int get()
+	{
+		int c = m_stream.get();
+		if (c == '\n')
+		{
+			++m_line;
+			m_column = 1;
+		}
+		else if (c != EOF)
+			++m_column;
+		return c;
+	}
+
+	bool consume(char _c)
+	{
+		if (peek() != _c)
+			return false;
+		get();
+		return true;
+	}
+
+	bool fail(string const& _message)
+	{
+		return fail(_message, m_line, m_column);
+	}
+
+	bool fail(string const& _message, size_t _line, size_t _column)
+	{
+		m_error = "* Line " + to_string(_line) + ", Column " + to_string(_column) + "\n  " + _message + "\n";
+		return false;
+	}
+
+	/// @returns the text of the next value, which is delimited by matching the brackets and
+	/// quotes and is checked by the JSON parser afterwards.
+	string readValueText()
+	{
+		string text;
+		size_t depth = 0;
+		bool inString = false;
+		bool escaped = false;
+		for (int c = m_stream.peek(); c != EOF; c = m_stream.peek())
+		{
+			if (inString)
+			{
+				text.push_back(char(get()));
+				if (escaped)
+					escaped = false;
+				else if (c == '\\')
+					escaped = true;
+				else if (c == '"')
+				{
+					inString = false;
+					if (depth == 0)
+						break;
+				}
+				continue;
+			}
+			if (depth == 0 && !text.empty() && (c == ',' || c == '}' || c == ']' || c == ':' || isWhitespace(c)))
+				break;
+			text.push_back(char(get()));
+			if (c == '"')
+				inString = true;
+			else if (c == '{' || c == '[')
+				++depth;
+			else if ((c == '}' || c == ']') && (depth == 0 || --depth == 0))
+				break;
+		}
+		return text;
+	}
+
+	/// @returns the jsoncpp errors @a _errors about the text of a value at @a _line and
+	/// @a _column with the positions relative to the whole input.
+	static string relocateErrors(string const& _errors, size_t _line, size_t _column)
+	{
+		static string const linePrefix = "* Line ";
+		static string const columnPrefix = ", Column ";
+		string relocated;
+		size_t last = 0;
+		for (size_t pos = _errors.find(linePrefix); pos != string::npos; pos = _errors.find(linePrefix, pos + 1))
+		{
+			size_t lineEnd = pos + linePrefix.size();
+			size_t line = readNumber(_errors, lineEnd);
+			if (lineEnd == pos + linePrefix.size() || _errors.compare(lineEnd, columnPrefix.size(), columnPrefix) != 0)
+				continue;
+			size_t columnEnd = lineEnd + columnPrefix.size();
+			size_t column = readNumber(_errors, columnEnd);
+			if (columnEnd == lineEnd + columnPrefix.size())
+				continue;
+			relocated.append(_errors, last, pos - last);
+			relocated +=
+				"* Line " + to_string(_line + line - 1) +
+				", Column " + to_string(line == 1 ? _column + column - 1 : column);
+			last = columnEnd;
+		}
+		relocated.append(_errors, last, string::npos);
+		return relocated;
+	}
+
+	/// @returns the decimal number at @a _pos in @a _text and advances @a _pos past it.
+	static size_t readNumber(string const& _text, size_t& _pos)
+	{
+		size_t number = 0;
+		for (; _pos < _text.size() && '0' <= _text[_pos] && _text[_pos] <= '9'; ++_pos)
+			number = number * 10 + size_t(_text[_pos] - '0');
+		return number;
+	}
+
+	istream& m_stream;
+	size_t m_line = 1;
+	size_t m_column = 1;
+	string m_error;
+};
+
 }
 
+/// Writes the output object to a stream while it is produced. The members have to be added
+/// in the order in which jsoncpp prints them, i.e. sorted by their names, so that the output
+/// is the same as when the whole object is printed at once.
+class StandardCompiler::StreamedOutput
+{
+public:
+	explicit StreamedOutput(ostream& _stream): m_stream(_stream) {}
+
+	/// Adds the member at @a _path, e.g. {"contracts", "a.sol", "C"}, creating the objects on the way.
+	void add(vector<string> const& _path, Json::Value const& _value)
+	{
+		solAssert(!_path.empty(), "");
+		if (!m_started)
+			m_stream << "{";
+		m_started = true;
+
+		size_t common = 0;
+		while (common < m_openObjects.size() && common + 1 < _path.size() && m_openObjects[common] == _path[common])
+			++common;
+		while (m_openObjects.size() > common)
+		{
+			m_stream << "}";
+			m_openObjects.pop_back();
+			m_hasMembers = true;
+		}
+		for (size_t i = common; i < _path.size(); ++i)
+		{
+			if (m_hasMembers)
+				m_stream << ",";
+			m_stream << util::jsonCompactPrint(Json::Value(_path[i])) << ":";
+			m_hasMembers = false;
+			if (i + 1 < _path.size())
+			{
+				m_stream << "{";
+				m_openObjects.push_back(_path[i]);
+			}
+		}
+		m_stream << util::jsonCompactPrint(_value);
+		m_hasMembers = true;
+		if (_path.front() == "errors")
+			m_errorsWritten = true;
+	}
+
+	/// Closes the output object after the compilation failed with the output @a _output,
+	/// whose errors are added as the errors member unless that has already been written.
+	/// @returns false in that case.
+	bool fail(Json::Value const& _output)
+	{
+		if (m_errorsWritten)
+		{
+			finish();
+			return false;
+		}
+		add({"errors"}, _output["errors"]);
+		finish();
+		return true;
+	}
+
+	/// Closes the output object.
+	void finish()
+	{
+		if (!m_started)
+			m_stream << "{";
+		m_stream << string(m_openObjects.size() + 1, '}');
+		m_openObjects.clear();
+	}
+
+	bool started() const { return m_started; }
+
+private:
+	ostream& m_stream;
+	bool m_started = false;
+	bool m_errorsWritten = false;
+	/// True if the innermost open object already has members.
+	bool m_hasMembers = false;
+	/// Names of the open objects below the output object, from the outside in.
+	vector<string> m_openObjects;
+};
+
 std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(Json::Value const& _input)
 {
 	InputsAndSettings ret;
@@ -582,75 +889,182 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 	ret.errors = Json::arrayValue;
 
 	for (auto const& sourceName: sources.getMemberNames())
-	{
-		string hash;
-
-		if (auto result = checkSourceKeys(sources[sourceName], sourceName))
+		if (auto result = parseSource(sourceName, sources[sourceName], ret))
 			return *result;
 
-		if (sources[sourceName]["keccak256"].isString())
-			hash = sources[sourceName]["keccak256"].asString();
+	return parseSettings(_input, std::move(ret));
+}
+
+std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseInput(istream& _input)
+{
+	JsonObjectReader reader(_input);
+	InputsAndSettings ret;
+
+	string whitespace = reader.skipWhitespace();
+	if (reader.peek() != '{')
+	{
+		// Parse the whole input, so that the errors are the same as those of jsonParseStrict.
+		Json::Value input;
+		string errors;
+		if (!util::jsonParseStrict(whitespace + string(istreambuf_iterator<char>(_input), {}), input, &errors))
+			return formatFatalError("JSONError", errors);
+		return formatFatalError("JSONError", "Input is not a JSON object.");
+	}
 
-		if (sources[sourceName]["content"].isString())
+	// All members but the sources, which are only listed with an empty object.
+	Json::Value input = Json::objectValue;
+	// The sources with contents are added to ret as soon as they are read, but their errors
+	// are reported in the order of their names, like when parsing the whole input at once.
+	map<string, pair<optional<Json::Value>, Json::Value>> sourceResults;
+	// The other sources are only parsed once the rest of the input is known to be valid,
+	// so that their URLs are not read before.
+	map<string, Json::Value> deferredSources;
+	bool valid = reader.readMembers([&](string const& _key) {
+		if (_key != "sources" || reader.peek() != '{')
 		{
-			string content = sources[sourceName]["content"].asString();
-			if (!hash.empty() && !hashMatchesContent(hash, content))
-				ret.errors.append(formatError(
-					false,
-					"IOError",
-					"general",
-					"Mismatch between content and supplied hash for \"" + sourceName + "\""
-				));
-			else
-				ret.sources[sourceName] = content;
+			optional<Json::Value> value = reader.readValue();
+			if (value)
+				input[_key] = std::move(*value);
+			return value.has_value();
 		}
-		else if (sources[sourceName]["urls"].isArray())
+		input[_key] = Json::objectValue;
+		return reader.readMembers([&](string const& _sourceName) {
+			optional<Json::Value> source = reader.readValue();
+			if (!source)
+				return false;
+			if (source->isObject() && !(*source)["content"].isString())
+			{
+				sourceResults[_sourceName] = {};
+				deferredSources[_sourceName] = std::move(*source);
+				return true;
+			}
+			InputsAndSettings sourceInput;
+			sourceInput.errors = Json::arrayValue;
+			optional<Json::Value> fatalError = parseSource(_sourceName, *source, sourceInput);
+			for (auto& [sourceName, content]: sourceInput.sources)
+				ret.sources[sourceName] = std::move(content);
+			sourceResults[_sourceName] = {std::move(fatalError), std::move(sourceInput.errors)};
+			return true;
+		});
+	});
+	if (!valid || !reader.expectEnd())
+		return formatFatalError("JSONError", reader.error());
+
+	if (auto result = checkRootKeys(input))
+		return *result;
+
+	ret.language = input["language"].asString();
+
+	if (!input["sources"].isObject() && !input["sources"].isNull())
+		return formatFatalError("JSONError", "\"sources\" is not a JSON object.");
+
+	if (sourceResults.empty())
+		return formatFatalError("JSONError", "No input sources specified.");
+
+	ret.errors = Json::arrayValue;
+
+	for (auto& [sourceName, result]: sourceResults)
+	{
+		if (deferredSources.count(sourceName))
 		{
-			if (!m_readFile)
-				return formatFatalError("JSONError", "No import callback supplied, but URL is requested.");
+			if (auto fatalError = parseSource(sourceName, deferredSources[sourceName], ret))
+				return *fatalError;
+			continue;
+		}
+		if (result.first)
+			return std::move(*result.first);
+		for (auto& error: result.second)
+			ret.errors.append(std::move(error));
+	}
+
+	return parseSettings(input, std::move(ret));
+}
+
+std::optional<Json::Value> StandardCompiler::parseSource(
+	string const& _name,
+	Json::Value const& _source,
+	InputsAndSettings& _inputsAndSettings
+)
+{
+	string hash;
+
+	if (auto result = checkSourceKeys(_source, _name))
+		return *result;
+
+	if (_source["keccak256"].isString())
+		hash = _source["keccak256"].asString();
+
+	if (_source["content"].isString())
+	{
+		string content = _source["content"].asString();
+		if (!hash.empty() && !hashMatchesContent(hash, content))
+			_inputsAndSettings.errors.append(formatError(
+				false,
+				"IOError",
+				"general",
+				"Mismatch between content and supplied hash for \"" + _name + "\""
+			));
+		else
+			_inputsAndSettings.sources[_name] = std::move(content);
+	}
+	else if (_source["urls"].isArray())
+	{
+		if (!m_readFile)
+			return formatFatalError("JSONError", "No import callback supplied, but URL is requested.");
 
-			bool found = false;
-			vector<string> failures;
+		bool found = false;
+		vector<string> failures;
 
-			for (auto const& url: sources[sourceName]["urls"])
+		for (auto const& url: _source["urls"])
+		{
+			if (!url.isString())
+				return formatFatalError("JSONError", "URL must be a string.");
+			ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), url.asString());
+			if (result.success && result.contents)
+				result.responseOrErrorMessage = string(result.contents->source());
+			if (result.success)
 			{
-				if (!url.isString())
-					return formatFatalError("JSONError", "URL must be a string.");
-				ReadCallback::Result result = m_readFile(ReadCallback::kindString(ReadCallback::Kind::ReadFile), url.asString());
-				if (result.success)
+				if (!hash.empty() && !hashMatchesContent(hash, result.responseOrErrorMessage))
+					_inputsAndSettings.errors.append(formatError(
+						false,
+						"IOError",
+						"general",
+						"Mismatch between content and supplied hash for \"" + _name + "\" at \"" + url.asString() + "\""
+					));
+				else
 				{
-					if (!hash.empty() && !hashMatchesContent(hash, result.responseOrErrorMessage))
-						ret.errors.append(formatError(
-							false,
-							"IOError",
-							"general",
-							"Mismatch between content and supplied hash for \"" + sourceName + "\" at \"" + url.asString() + "\""
-						));
-					else
-					{
-						ret.sources[sourceName] = result.responseOrErrorMessage;
-						found = true;
-						break;
-					}
+					_inputsAndSettings.sources[_name] = std::move(result.responseOrErrorMessage);
+					found = true;
+					break;
 				}
-				else
-					failures.push_back("Cannot import url (\"" + url.asString() + "\"): " + result.responseOrErrorMessage);
 			}
+			else
+				failures.push_back("Cannot import url (\"" + url.asString() + "\"): " + result.responseOrErrorMessage);
+		}
 
-			for (auto const& failure: failures)
-			{
-				/// If the import succeeded, let mark all the others as warnings, otherwise all of them are errors.
-				ret.errors.append(formatError(
-					found ? true : false,
-					"IOError",
-					"general",
-					failure
-				));
-			}
+		for (auto const& failure: failures)
+		{
+			/// If the import succeeded, let mark all the others as warnings, otherwise all of them are errors.
+			_inputsAndSettings.errors.append(formatError(
+				found ? true : false,
+				"IOError",
+				"general",
+				failure
+			));
 		}
-		else
-			return formatFatalError("JSONError", "Invalid input source specified.");
 	}
+	else
+		return formatFatalError("JSONError", "Invalid input source specified.");
+
+	return std::nullopt;
+}
+
+std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler::parseSettings(
+	Json::Value const& _input,
+	InputsAndSettings _inputsAndSettings
+)
+{
+	InputsAndSettings ret = std::move(_inputsAndSettings);
 
 	Json::Value const& auxInputs = _input["auxiliaryInput"];
 
@@ -700,6 +1114,13 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.parserErrorRecovery = settings["parserErrorRecovery"].asBool();
 	}
 
+	if (settings.isMember("parallelism"))
+	{
+		if (!settings["parallelism"].isUInt() || settings["parallelism"].asUInt() == 0)
+			return formatFatalError("JSONError", "\"settings.parallelism\" must be a positive integer.");
+		ret.parallelism = settings["parallelism"].asUInt();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -731,6 +1152,36 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		}
 	}
 
+	if (settings.isMember("modelChecker"))
+	{
+		if (auto result = checkKeys(settings["modelChecker"], {"parallelism", "portfolio", "timeout"}, "settings.modelChecker"))
+			return *result;
+
+		if (settings["modelChecker"].isMember("portfolio"))
+		{
+			if (!settings["modelChecker"]["portfolio"].isString())
+				return formatFatalError("JSONError", "settings.modelChecker.portfolio must be a string.");
+			std::optional<smtutil::PortfolioMode> mode = smtutil::portfolioModeFromString(settings["modelChecker"]["portfolio"].asString());
+			if (!mode)
+				return formatFatalError("JSONError", "Invalid value for settings.modelChecker.portfolio.");
+			ret.modelCheckerSettings.portfolioMode = *mode;
+		}
+
+		if (settings["modelChecker"].isMember("timeout"))
+		{
+			if (!settings["modelChecker"]["timeout"].isUInt() || settings["modelChecker"]["timeout"].asUInt() == 0)
+				return formatFatalError("JSONError", "settings.modelChecker.timeout must be a positive integer.");
+			ret.modelCheckerSettings.timeout = settings["modelChecker"]["timeout"].asUInt();
+		}
+
+		if (settings["modelChecker"].isMember("parallelism"))
+		{
+			if (!settings["modelChecker"]["parallelism"].isUInt() || settings["modelChecker"]["parallelism"].asUInt() == 0)
+				return formatFatalError("JSONError", "settings.modelChecker.parallelism must be a positive integer.");
+			ret.modelCheckerSettings.parallelism = settings["modelChecker"]["parallelism"].asUInt();
+		}
+	}
+
 	if (settings.isMember("remappings") && !settings["remappings"].isArray())
 		return formatFatalError("JSONError", "\"settings.remappings\" must be an array of strings.");
 
@@ -818,30 +1269,56 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 
 	ret.outputSelection = std::move(outputSelection);
 
+	ret.inputWithoutSources = Json::objectValue;
+	for (string const& member: _input.getMemberNames())
+		if (member != "sources")
+			ret.inputWithoutSources[member] = _input[member];
+
 	return { std::move(ret) };
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+Json::Value StandardCompiler::compileSolidity(
+	StandardCompiler::InputsAndSettings _inputsAndSettings,
+	StreamedOutput* _streamedOutput
+)
 {
-	CompilerStack compilerStack(m_readFile);
-
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	compilerStack.setSources(sourceList);
-	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
-		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
-	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
-	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
-	compilerStack.setRemappings(_inputsAndSettings.remappings);
-	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
-	compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
-	compilerStack.setLibraries(_inputsAndSettings.libraries);
-	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
-	compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
-	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
-
-	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
-
-	compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+
+	// The stack is taken over by the next compilation only if this one does not throw.
+	unique_ptr<CompilerStack> compilerStackPtr;
+	if (m_compilerStack && m_compilerStackInput == _inputsAndSettings.inputWithoutSources)
+	{
+		compilerStackPtr = std::move(m_compilerStack);
+		compilerStackPtr->updateSources(sourceList);
+	}
+	else
+	{
+		m_compilerStack.reset();
+		compilerStackPtr = make_unique<CompilerStack>(m_readFile);
+		CompilerStack& compilerStack = *compilerStackPtr;
+		compilerStack.setSources(sourceList);
+		for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
+			compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
+		compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
+		compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
+		compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
+		compilerStack.setParallelism(_inputsAndSettings.parallelism);
+		compilerStack.setCacheDirectory(m_cacheDirectory);
+		compilerStack.setRemappings(_inputsAndSettings.remappings);
+		compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
+		compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
+		compilerStack.setLibraries(_inputsAndSettings.libraries);
+		compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
+		compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
+		compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
+
+		compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+
+		compilerStack.enableEwasmGeneration(isEwasmRequested(_inputsAndSettings.outputSelection));
+
+		compilerStack.enableOptimiserProfile(isOptimizerProfileRequested(_inputsAndSettings.outputSelection));
+	}
+	CompilerStack& compilerStack = *compilerStackPtr;
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
@@ -978,36 +1455,42 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		return formatFatalError("InternalCompilerError", "No error reported, but compilation failed.");
 
 	Json::Value output = Json::objectValue;
-
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
+	// Adds a member to the output or writes it to the streamed output. The members are
+	// added in the order in which they are printed.
+	auto addOutput = [&](vector<string> const& _path, Json::Value _value)
+	{
+		if (_streamedOutput)
+		{
+			_streamedOutput->add(_path, _value);
+			return;
+		}
+		Json::Value* member = &output;
+		for (string const& name: _path)
+			member = &(*member)[name];
+		*member = std::move(_value);
+	};
 
 	if (!compilerStack.unhandledSMTLib2Queries().empty())
+	{
+		Json::Value queries = Json::objectValue;
 		for (string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+			queries["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+		addOutput({"auxiliaryInputRequested"}, std::move(queries));
+	}
 
 	bool const wildcardMatchesExperimental = false;
 
-	output["sources"] = Json::objectValue;
-	unsigned sourceIndex = 0;
-	for (string const& sourceName: analysisPerformed ? compilerStack.sourceNames() : vector<string>())
-	{
-		Json::Value sourceResult = Json::objectValue;
-		sourceResult["id"] = sourceIndex++;
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-			sourceResult["ast"] = ASTJsonConverter(false, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesExperimental))
-			sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-		output["sources"][sourceName] = sourceResult;
-	}
-
-	Json::Value contractsOutput = Json::objectValue;
+	vector<pair<string, string>> contracts;
 	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
+		contracts.emplace_back(contractName.substr(0, colon), contractName.substr(colon + 1));
+	}
+	sort(contracts.begin(), contracts.end());
+	for (auto const& [file, name]: contracts)
+	{
+		string const contractName = file + ":" + name;
 
 		// ABI, storage layout, documentation and metadata
 		Json::Value contractData(Json::objectValue);
@@ -1044,6 +1527,8 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			evmData["methodIdentifiers"] = compilerStack.methodIdentifiers(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
 			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.optimizerProfile", wildcardMatchesExperimental))
+			evmData["optimizerProfile"] = compilerStack.optimiserProfile(contractName);
 
 		if (compilationSuccess && isArtifactRequested(
 			_inputsAndSettings.outputSelection,
@@ -1075,15 +1560,37 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			contractData["evm"] = evmData;
 
 		if (!contractData.empty())
-		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
-		}
+			addOutput({"contracts", file, name}, std::move(contractData));
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
 
+	if (errors.size() > 0)
+		addOutput({"errors"}, std::move(errors));
+
+	vector<string> sourceNames = analysisPerformed ? compilerStack.sourceNames() : vector<string>();
+	if (sourceNames.empty())
+		addOutput({"sources"}, Json::objectValue);
+	unsigned sourceIndex = 0;
+	for (string const& sourceName: sourceNames)
+	{
+		Json::Value sourceResult = Json::objectValue;
+		sourceResult["id"] = sourceIndex++;
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+			sourceResult["ast"] = ASTJsonConverter(false, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+		if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "legacyAST", wildcardMatchesExperimental))
+			sourceResult["legacyAST"] = ASTJsonConverter(true, compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
+		addOutput({"sources", sourceName}, std::move(sourceResult));
+	}
+
+	if (m_incrementalCompilation)
+	{
+		if (!m_compilerStackYulStrings)
+			m_compilerStackYulStrings = make_unique<YulStringRepository::Scope>();
+		m_compilerStack = std::move(compilerStackPtr);
+		m_compilerStackInput = std::move(_inputsAndSettings.inputWithoutSources);
+	}
+
+	if (_streamedOutput)
+		return Json::Value();
 	return output;
 }
 
@@ -1108,6 +1615,7 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		AssemblyStack::Language::StrictAssembly,
 		_inputsAndSettings.optimiserSettings
 	);
+	stack.setParallelism(_inputsAndSettings.parallelism);
 	string const& sourceName = _inputsAndSettings.sources.begin()->first;
 	string const& sourceContents = _inputsAndSettings.sources.begin()->second;
 
@@ -1144,6 +1652,7 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "ir", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["ir"] = stack.print();
 
+	stack.enableOptimiserProfile(isOptimizerProfileRequested(_inputsAndSettings.outputSelection));
 	stack.optimize();
 
 	MachineAssemblyObject object;
@@ -1174,6 +1683,8 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		output["contracts"][sourceName][contractName]["irOptimized"] = stack.print();
 	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "evm.assembly", wildcardMatchesExperimental))
 		output["contracts"][sourceName][contractName]["evm"]["assembly"] = object.assembly;
+	if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, contractName, "evm.optimizerProfile", wildcardMatchesExperimental))
+		output["contracts"][sourceName][contractName]["evm"]["optimizerProfile"] = stack.optimiserProfile().toJson();
 
 	return output;
 }
@@ -1181,16 +1692,24 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
+	return parseAndCompile([&]() { return parseInput(_input); }, nullptr);
+}
 
+Json::Value StandardCompiler::parseAndCompile(
+	function<std::variant<InputsAndSettings, Json::Value>()> const& _parseInput,
+	StreamedOutput* _streamedOutput
+) noexcept
+{
+	// Frees the Yul strings of the compilation, unless another one is still running.
+	YulStringRepository::Scope yulStrings;
 	try
 	{
-		auto parsed = parseInput(_input);
+		auto parsed = _parseInput();
 		if (std::holds_alternative<Json::Value>(parsed))
 			return std::get<Json::Value>(std::move(parsed));
 		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
 		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
+			return compileSolidity(std::move(settings), _streamedOutput);
 		else if (settings.language == "Yul")
 			return compileYul(std::move(settings));
 		else
@@ -1241,3 +1760,34 @@ string StandardCompiler::compile(string const& _input) noexcept
 		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
+
+bool StandardCompiler::compile(istream& _input, ostream& _output, ostream& _errorOutput) noexcept
+{
+	StreamedOutput streamedOutput(_output);
+	Json::Value output = parseAndCompile([&]() { return parseInput(_input); }, &streamedOutput);
+	try
+	{
+		if (!streamedOutput.started())
+			_output << util::jsonCompactPrint(output);
+		else if (output.isNull())
+			streamedOutput.finish();
+		else if (!streamedOutput.fail(output))
+		{
+			// An exception occurred after the errors had been written.
+			_errorOutput << util::jsonPrettyPrint(output) << endl;
+			return false;
+		}
+	}
+	catch (...)
+	{
+		try
+		{
+			_errorOutput << "Error writing output JSON." << endl;
+		}
+		catch (...)
+		{
+		}
+		return false;
+	}
+	return true;
+}
@@ -24,6 +24,10 @@
 
 #include <libsolidity/interface/CompilerStack.h>
 
+#include <libyul/YulString.h>
+
+#include <functional>
+#include <iosfwd>
 #include <optional>
 #include <utility>
 #include <variant>
@@ -46,21 +50,53 @@ public:
 	{
 	}
 
+	/// Reuses the contracts compiled before and the answers of the SMT solvers stored in
+	/// @a _directory, see CompilerStack::setCacheDirectory. This is not part of the input,
+	/// so that whoever provides the input cannot make the compiler write to arbitrary paths.
+	void setCacheDirectory(std::string _directory)
+	{
+		m_cacheDirectory = std::move(_directory);
+		m_compilerStack.reset();
+	}
+
+	/// Keeps the analysed sources of each Solidity compilation. If the input of the next
+	/// compilation differs only in the sources, only the changed sources and the sources that
+	/// import them are analysed again, see CompilerStack::updateSources.
+	/// While the sources are kept, no Yul strings are freed, see yul::YulStringRepository::Scope.
+	void enableIncrementalCompilation(bool _enable = true)
+	{
+		m_incrementalCompilation = _enable;
+		m_compilerStack.reset();
+		m_compilerStackYulStrings.reset();
+	}
+
 	/// Sets all input parameters according to @a _input which conforms to the standardized input
 	/// format, performs compilation and returns a standardized output.
 	Json::Value compile(Json::Value const& _input) noexcept;
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Reads the input from @a _input and writes the same output as above to @a _output, but
+	/// without holding all of either in memory: the sources are parsed one at a time, and the
+	/// output of each source and contract is written and released as soon as it is produced.
+	/// If the compilation fails after the output was started, the error is added to the
+	/// output as its errors member, unless that has already been written.
+	/// @returns false if the error could not be added, in which case the output is closed
+	/// early and the error is written to @a _errorOutput.
+	bool compile(std::istream& _input, std::ostream& _output, std::ostream& _errorOutput) noexcept;
 
 private:
+	class StreamedOutput;
+
 	struct InputsAndSettings
 	{
 		std::string language;
 		Json::Value errors;
 		bool parserErrorRecovery = false;
+		size_t parallelism = 1;
 		std::map<std::string, std::string> sources;
 		std::map<util::h256, std::string> smtLib2Responses;
+		ModelCheckerSettings modelCheckerSettings;
 		langutil::EVMVersion evmVersion;
 		std::vector<CompilerStack::Remapping> remappings;
 		RevertStrings revertStrings = RevertStrings::Default;
@@ -69,16 +105,48 @@ private:
 		bool metadataLiteralSources = false;
 		CompilerStack::MetadataHash metadataHash = CompilerStack::MetadataHash::IPFS;
 		Json::Value outputSelection;
+		/// The input apart from the sources.
+		Json::Value inputWithoutSources;
 	};
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
+	/// Parses the input json from @a _input one member and one source at a time.
+	std::variant<InputsAndSettings, Json::Value> parseInput(std::istream& _input);
+	/// Adds the source @a _name described by @a _source to @a _inputsAndSettings.
+	/// @returns an error as a json object if the source is invalid.
+	std::optional<Json::Value> parseSource(
+		std::string const& _name,
+		Json::Value const& _source,
+		InputsAndSettings& _inputsAndSettings
+	);
+	/// Parses everything but the sources of the input json @a _input into @a _inputsAndSettings.
+	std::variant<InputsAndSettings, Json::Value> parseSettings(
+		Json::Value const& _input,
+		InputsAndSettings _inputsAndSettings
+	);
+
+	/// Parses the input using @a _parseInput and compiles it. Converts all exceptions into errors.
+	/// If @a _streamedOutput is given, the output of a Solidity compilation is written to it
+	/// and a null value is returned.
+	Json::Value parseAndCompile(
+		std::function<std::variant<InputsAndSettings, Json::Value>()> const& _parseInput,
+		StreamedOutput* _streamedOutput
+	) noexcept;
 
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings, StreamedOutput* _streamedOutput);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
+	std::string m_cacheDirectory;
+	bool m_incrementalCompilation = false;
+	/// Keeps the Yul strings of the inline assembly in the ASTs of @a m_compilerStack.
+	std::unique_ptr<yul::YulStringRepository::Scope> m_compilerStackYulStrings;
+	/// The compiler stack of the previous Solidity compilation if incremental compilation is
+	/// enabled, and the input it was configured with.
+	std::unique_ptr<CompilerStack> m_compilerStack;
+	Json::Value m_compilerStackInput;
 };
 
 }
@@ -26,6 +26,8 @@
 #include <liblangutil/ParserBase.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <algorithm>
+
 namespace solidity::langutil
 {
 class Scanner;
@@ -48,6 +50,10 @@ public:
 
 	ASTPointer<SourceUnit> parse(std::shared_ptr<langutil::Scanner> const& _scanner);
 
+	/// Makes the IDs of the nodes created by the following calls to parse larger than @a _id,
+	/// so that they are distinct from the IDs of ASTs parsed by another parser.
+	void continueNodeIDsAfter(int64_t _id) { m_currentNodeID = std::max(m_currentNodeID, _id); }
+
 private:
 	class ASTNodeFactory;
 
@@ -68,6 +68,36 @@ string solidity::util::readFileAsString(string const& _file)
 	return readFile<string>(_file);
 }
 
+bool solidity::util::writeFileAtomically(string const& _file, string const& _content)
+{
+	namespace fs = boost::filesystem;
+
+	boost::system::error_code error;
+	fs::path temporary = _file;
+	temporary += fs::unique_path(".%%%%-%%%%-%%%%.tmp", error);
+	if (error)
+		return false;
+	{
+		ofstream file(temporary.string(), ios::binary | ios::trunc);
+		if (!file)
+			return false;
+		file << _content;
+		if (!file)
+		{
+			file.close();
+			fs::remove(temporary, error);
+			return false;
+		}
+	}
+	fs::rename(temporary, _file, error);
+	if (error)
+	{
+		fs::remove(temporary, error);
+		return false;
+	}
+	return true;
+}
+
 string solidity::util::readStandardInput()
 {
 	string ret;
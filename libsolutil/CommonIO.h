@@ -34,6 +34,12 @@ namespace solidity::util
 /// If the file doesn't exist or isn't readable, returns an empty container / bytes.
 std::string readFileAsString(std::string const& _file);
 
+/// Writes @a _content to the file @a _file, replacing it if it exists. The content is first
+/// written to a temporary file in the same directory, which is then renamed, so that readers
+/// never see a partially written file.
+/// @returns false if the file could not be written.
+bool writeFileAtomically(std::string const& _file, std::string const& _content);
+
 /// Retrieve and returns the contents of standard input (until EOF).
 std::string readStandardInput();
 
@@ -0,0 +1,76 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Value wrapper that shares the value between copies until one of them is modified.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace solidity::util
+{
+
+/**
+ * A value that is shared between copies until one of them is modified, at which point the
+ * modified copy receives its own clone of the value. Copying is therefore only as expensive as
+ * copying a shared pointer.
+ *
+ * Copies may be used and destroyed in different threads, but a single CopyOnWrite object must
+ * not be used concurrently if one of the uses modifies it.
+ *
+ * @tparam T the type of the stored value; has to be copy-constructible.
+ */
+template<typename T>
+class CopyOnWrite
+{
+public:
+	using value_type = T;
+
+	static_assert(std::is_copy_constructible_v<value_type>, "The stored type has to be copy-constructible.");
+
+	CopyOnWrite(): m_value(std::make_shared<value_type>()) {}
+	explicit CopyOnWrite(value_type _value): m_value(std::make_shared<value_type>(std::move(_value))) {}
+
+	value_type const& operator*() const { return *m_value; }
+	value_type const* operator->() const { return m_value.get(); }
+
+	/// @returns a modifiable reference to the value, cloning it first if it is shared with other copies.
+	/// The reference is invalidated by copying this object.
+	value_type& write()
+	{
+		if (m_value.use_count() > 1)
+			m_value = std::make_shared<value_type>(*m_value);
+		else
+			// The count is read without ordering. This makes the accesses to the value by a copy
+			// destroyed in another thread happen before the modification.
+			std::atomic_thread_fence(std::memory_order_acquire);
+		return *m_value;
+	}
+
+	/// @returns true if both objects refer to the same value. This implies equality of the values,
+	/// but the values might also be equal if this returns false.
+	bool sharesValueWith(CopyOnWrite const& _other) const { return m_value == _other.m_value; }
+
+private:
+	std::shared_ptr<value_type> m_value;
+};
+
+}
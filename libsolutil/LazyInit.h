@@ -20,7 +20,9 @@
 #include <libsolutil/Assertions.h>
 #include <libsolutil/Exceptions.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <type_traits>
 #include <utility>
@@ -30,9 +32,20 @@ namespace solidity::util
 
 DEV_SIMPLE_EXCEPTION(BadLazyInitAccess);
 
+/// @returns the mutex that serialises the initialisation of all LazyInit values and of the
+/// other lazily computed caches of objects that are shared between compilation threads.
+/// It is recursive because initialisers regularly trigger further lazy initialisation.
+/// Initialisers must not wait for other threads while holding it.
+inline std::recursive_mutex& lazyInitMutex()
+{
+	static std::recursive_mutex mutex;
+	return mutex;
+}
+
 /**
  * A value that is initialized at some point after construction of the LazyInit. The stored value can only be accessed
  * while calling "init", which initializes the stored value (if it has not already been initialized).
+ * Initialization is thread-safe, moving and resetting are not.
  *
  * @tparam T the type of the stored value; may not be a function, reference, array, or void type; may be const-qualified.
  */
@@ -52,16 +65,26 @@ public:
 	LazyInit& operator=(LazyInit const&) = delete;
 
 	// Move constructor must be overridden to ensure that moved-from object is left empty.
-	constexpr LazyInit(LazyInit&& _other) noexcept:
-		m_value(std::move(_other.m_value))
+	LazyInit(LazyInit&& _other) noexcept:
+		m_value(std::move(_other.m_value)),
+		m_initialized(m_value.has_value())
 	{
-		_other.m_value.reset();
+		_other.reset();
 	}
 
 	LazyInit& operator=(LazyInit&& _other) noexcept
 	{
 		this->m_value.swap(_other.m_value);
-		_other.m_value.reset();
+		m_initialized = m_value.has_value();
+		_other.reset();
+		return *this;
+	}
+
+	/// Clears the stored value, so that the next call to "init" initializes it again.
+	void reset() noexcept
+	{
+		m_value.reset();
+		m_initialized = false;
 	}
 
 	template<typename F>
@@ -84,11 +107,20 @@ private:
 	template<typename F>
 	void doInit(F&& _fun) const
 	{
+		if (m_initialized.load(std::memory_order_acquire))
+			return;
+
+		std::lock_guard<std::recursive_mutex> lock(lazyInitMutex());
 		if (!m_value.has_value())
+		{
 			m_value.emplace(std::forward<F>(_fun)());
+			m_initialized.store(true, std::memory_order_release);
+		}
 	}
 
 	mutable std::optional<value_type> m_value;
+	/// Set after m_value has been initialized. Allows lock-free access to initialized values.
+	mutable std::atomic<bool> m_initialized{false};
 };
 
 }
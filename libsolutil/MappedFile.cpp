@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolutil/MappedFile.h>
+
+#include <libsolutil/CommonIO.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace solidity::util;
+
+MappedFile::MappedFile(string const& _file)
+{
+#if !defined(_WIN32)
+	int descriptor = open(_file.c_str(), O_RDONLY);
+	if (descriptor >= 0)
+	{
+		struct stat status;
+		long pageSize = sysconf(_SC_PAGESIZE);
+		// The zero after the contents is only there if the last page is not full.
+		if (
+			fstat(descriptor, &status) == 0 &&
+			S_ISREG(status.st_mode) &&
+			static_cast<size_t>(status.st_size) >= c_minimumMappedSize &&
+			pageSize > 0 &&
+			status.st_size % pageSize != 0
+		)
+		{
+			size_t size = static_cast<size_t>(status.st_size);
+			void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+			if (mapping != MAP_FAILED)
+			{
+				m_mapping = mapping;
+				m_mappingSize = size;
+				m_contents = string_view(static_cast<char const*>(mapping), size);
+			}
+		}
+		close(descriptor);
+		if (m_mapping)
+			return;
+	}
+#endif
+	m_buffer = readFileAsString(_file);
+	m_contents = m_buffer;
+}
+
+MappedFile::~MappedFile()
+{
+#if !defined(_WIN32)
+	if (m_mapping)
+		munmap(m_mapping, m_mappingSize);
+#endif
+}
@@ -0,0 +1,63 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Read-only access to the contents of a file without copying them.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace solidity::util
+{
+
+/**
+ * Contents of a file that are mapped into memory where this is supported and worth it,
+ * and read into a string otherwise. Like in a std::string, the character after the end of
+ * the contents can be read and is zero.
+ *
+ * A mapped file that is modified while it is mapped changes the contents, and reading a part
+ * that was cut off by truncating it raises SIGBUS. So this is only meant for files that are
+ * not written to while the contents are in use.
+ */
+class MappedFile
+{
+public:
+	/// Maps @a _file into memory. If it doesn't exist or isn't readable, the contents are empty.
+	explicit MappedFile(std::string const& _file);
+	~MappedFile();
+
+	MappedFile(MappedFile const&) = delete;
+	MappedFile& operator=(MappedFile const&) = delete;
+
+	std::string_view contents() const noexcept { return m_contents; }
+	/// @returns true if the contents are mapped, false if they have been read into memory.
+	bool mapped() const noexcept { return m_mapping != nullptr; }
+
+	/// Files smaller than this are read, since mapping them is slower.
+	static size_t constexpr c_minimumMappedSize = 64 * 1024;
+
+private:
+	void* m_mapping = nullptr;
+	size_t m_mappingSize = 0;
+	std::string m_buffer;
+	std::string_view m_contents;
+};
+
+}
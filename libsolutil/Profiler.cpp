@@ -0,0 +1,212 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolutil/Profiler.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace solidity::util;
+
+void Profiler::count(string const& _name, uint64_t _amount)
+{
+	lock_guard<mutex> lock(m_mutex);
+	m_counters[_name] += _amount;
+}
+
+vector<Profiler::Phase> Profiler::phases() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_phases;
+}
+
+map<string, uint64_t> Profiler::counters() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_counters;
+}
+
+Json::Value Profiler::chromeTrace() const
+{
+	lock_guard<mutex> lock(m_mutex);
+
+	Json::Value events(Json::arrayValue);
+	chrono::microseconds end{0};
+	for (Phase const& phase: m_phases)
+	{
+		Json::Value event(Json::objectValue);
+		event["name"] = phase.name;
+		event["cat"] = "compiler";
+		event["ph"] = "X";
+		event["ts"] = Json::Int64(phase.start.count());
+		event["dur"] = Json::Int64(phase.duration.count());
+		event["pid"] = 1;
+		event["tid"] = Json::UInt64(phase.thread);
+		event["args"] = Json::objectValue;
+		if (!phase.detail.empty())
+			event["args"]["detail"] = phase.detail;
+		event["args"]["peakMemoryKiB"] = Json::UInt64(phase.peakMemoryAfter);
+		events.append(move(event));
+		end = max(end, phase.start + phase.duration);
+	}
+	for (auto const& [name, value]: m_counters)
+	{
+		Json::Value event(Json::objectValue);
+		event["name"] = name;
+		event["cat"] = "compiler";
+		event["ph"] = "C";
+		event["ts"] = Json::Int64(end.count());
+		event["pid"] = 1;
+		event["tid"] = 0;
+		event["args"][name] = Json::UInt64(value);
+		events.append(move(event));
+	}
+
+	Json::Value trace(Json::objectValue);
+	trace["traceEvents"] = move(events);
+	trace["displayTimeUnit"] = "ms";
+	return trace;
+}
+
+string Profiler::summary() const
+{
+	struct Statistics
+	{
+		size_t count = 0;
+		chrono::microseconds total{0};
+		chrono::microseconds maximum{0};
+		size_t memoryGrowth = 0;
+	};
+
+	vector<string> names;
+	map<string, Statistics> statistics;
+	map<string, uint64_t> counters;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		// Phases are listed in the order they were first started.
+		vector<Phase const*> phases;
+		for (Phase const& phase: m_phases)
+			phases.push_back(&phase);
+		stable_sort(phases.begin(), phases.end(), [](Phase const* _a, Phase const* _b) { return _a->start < _b->start; });
+		for (Phase const* phase: phases)
+		{
+			if (!statistics.count(phase->name))
+				names.push_back(phase->name);
+			Statistics& entry = statistics[phase->name];
+			entry.count++;
+			entry.total += phase->duration;
+			entry.maximum = max(entry.maximum, phase->duration);
+			entry.memoryGrowth = max(entry.memoryGrowth, phase->peakMemoryAfter - phase->peakMemoryBefore);
+		}
+		counters = m_counters;
+	}
+
+	ostringstream out;
+	out << left << setw(32) << "Phase" << right << setw(8) << "Count" << setw(14) << "Total ms"
+		<< setw(14) << "Max ms" << setw(20) << "Peak growth KiB" << endl;
+	for (string const& name: names)
+	{
+		Statistics const& entry = statistics.at(name);
+		out << left << setw(32) << name << right << setw(8) << entry.count
+			<< fixed << setprecision(3)
+			<< setw(14) << double(entry.total.count()) / 1000
+			<< setw(14) << double(entry.maximum.count()) / 1000
+			<< setw(20) << entry.memoryGrowth << endl;
+	}
+	out << left << setw(32) << "Peak memory KiB" << right << setw(56) << peakMemoryUsage() << endl;
+	for (auto const& [name, value]: counters)
+		out << left << setw(32) << name << right << setw(56) << value << endl;
+	return out.str();
+}
+
+size_t Profiler::peakMemoryUsage()
+{
+#if defined(_WIN32)
+	return 0;
+#else
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return 0;
+#if defined(__APPLE__)
+	// Reported in bytes on macOS and in KiB elsewhere.
+	return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+	return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+void Profiler::record(
+	string _name,
+	string _detail,
+	chrono::steady_clock::time_point _start,
+	chrono::steady_clock::time_point _end,
+	size_t _peakMemoryBefore,
+	size_t _peakMemoryAfter
+)
+{
+	lock_guard<mutex> lock(m_mutex);
+	size_t thread = m_threads.emplace(this_thread::get_id(), m_threads.size()).first->second;
+	m_phases.emplace_back(Phase{
+		move(_name),
+		move(_detail),
+		chrono::duration_cast<chrono::microseconds>(_start - m_start),
+		chrono::duration_cast<chrono::microseconds>(_end - _start),
+		thread,
+		_peakMemoryBefore,
+		_peakMemoryAfter
+	});
+}
+
+ScopedTimer::ScopedTimer(Profiler* _profiler, string _name, string _detail):
+	m_profiler(_profiler),
+	m_name(move(_name)),
+	m_detail(move(_detail))
+{
+	start();
+}
+
+void ScopedTimer::next(string _name, string _detail)
+{
+	stop();
+	m_name = move(_name);
+	m_detail = move(_detail);
+	start();
+}
+
+void ScopedTimer::start()
+{
+	if (!m_profiler)
+		return;
+	m_peakMemoryBefore = Profiler::peakMemoryUsage();
+	m_start = chrono::steady_clock::now();
+}
+
+void ScopedTimer::stop()
+{
+	if (!m_profiler)
+		return;
+	auto end = chrono::steady_clock::now();
+	m_profiler->record(m_name, m_detail, m_start, end, m_peakMemoryBefore, Profiler::peakMemoryUsage());
+}
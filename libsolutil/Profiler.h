@@ -0,0 +1,125 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Recording of the time and memory taken by the phases of the compiler.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Thread-safe record of the phases of a compiler run and of named counters.
+ * Phases are recorded by ScopedTimer and can be exported in the trace event format
+ * understood by chrome://tracing and Perfetto or as a summary table.
+ */
+class Profiler
+{
+public:
+	struct Phase
+	{
+		std::string name;
+		/// Further information like the name of the contract, may be empty.
+		std::string detail;
+		/// Start of the phase relative to the construction of the profiler.
+		std::chrono::microseconds start;
+		std::chrono::microseconds duration;
+		/// Number of the thread the phase ran on, in the order the threads were first seen.
+		size_t thread = 0;
+		/// Peak resident set size of the process in KiB before and after the phase.
+		size_t peakMemoryBefore = 0;
+		size_t peakMemoryAfter = 0;
+	};
+
+	Profiler(): m_start(std::chrono::steady_clock::now()) {}
+
+	/// Adds @a _amount to the counter @a _name.
+	void count(std::string const& _name, uint64_t _amount = 1);
+
+	/// @returns the recorded phases in the order they ended.
+	std::vector<Phase> phases() const;
+	std::map<std::string, uint64_t> counters() const;
+
+	/// @returns the phases as complete events and the counters as counter events in the
+	/// JSON object format of the trace event format.
+	Json::Value chromeTrace() const;
+	/// @returns a table of the total and maximum duration and the largest growth of the peak
+	/// memory of the phases grouped by name, followed by the counters.
+	std::string summary() const;
+
+	/// @returns the peak resident set size of the process in KiB or zero if it is not available.
+	static size_t peakMemoryUsage();
+
+private:
+	friend class ScopedTimer;
+
+	void record(
+		std::string _name,
+		std::string _detail,
+		std::chrono::steady_clock::time_point _start,
+		std::chrono::steady_clock::time_point _end,
+		size_t _peakMemoryBefore,
+		size_t _peakMemoryAfter
+	);
+
+	std::chrono::steady_clock::time_point const m_start;
+	mutable std::mutex m_mutex;
+	std::vector<Phase> m_phases;
+	std::map<std::string, uint64_t> m_counters;
+	std::map<std::thread::id, size_t> m_threads;
+};
+
+/**
+ * Records the time between its construction and destruction as a phase of a profiler.
+ * Does nothing if no profiler is given, so it can be left in place unconditionally.
+ */
+class ScopedTimer
+{
+public:
+	ScopedTimer(Profiler* _profiler, std::string _name, std::string _detail = {});
+	~ScopedTimer() { stop(); }
+
+	ScopedTimer(ScopedTimer const&) = delete;
+	ScopedTimer& operator=(ScopedTimer const&) = delete;
+
+	/// Ends the current phase and starts the phase @a _name, which avoids a nested scope
+	/// for each of a sequence of phases.
+	void next(std::string _name, std::string _detail = {});
+
+private:
+	void start();
+	void stop();
+
+	Profiler* m_profiler = nullptr;
+	std::string m_name;
+	std::string m_detail;
+	std::chrono::steady_clock::time_point m_start;
+	size_t m_peakMemoryBefore = 0;
+};
+
+}
@@ -109,9 +109,9 @@ h256 solidity::util::bzzr0Hash(string const& _input)
 }
 
 
-h256 solidity::util::bzzr1Hash(bytes const& _input)
+h256 solidity::util::bzzr1Hash(bytesConstRef _input)
 {
 	if (_input.empty())
 		return h256{};
-	return chunkHash(&_input);
+	return chunkHash(_input);
 }
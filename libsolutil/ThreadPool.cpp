@@ -0,0 +1,138 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <libsolutil/ThreadPool.h>
+
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+using namespace solidity::util;
+
+ThreadPool::ThreadPool(size_t _threads)
+{
+	size_t threads = max<size_t>(_threads, 1);
+	m_threads.reserve(threads);
+	for (size_t i = 0; i < threads; ++i)
+		m_threads.emplace_back([this] { work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		unique_lock<mutex> lock(m_mutex);
+		m_idle.wait(lock, [&] { return m_tasks.empty() && m_runningTasks == 0; });
+		m_shutdown = true;
+	}
+	m_taskAvailable.notify_all();
+	for (thread& worker: m_threads)
+		worker.join();
+}
+
+void ThreadPool::post(function<void()> _task)
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_tasks.emplace_back(move(_task));
+	}
+	m_taskAvailable.notify_one();
+}
+
+void ThreadPool::wait()
+{
+	unique_lock<mutex> lock(m_mutex);
+	m_idle.wait(lock, [&] { return m_tasks.empty() && m_runningTasks == 0; });
+	if (m_exception)
+		rethrow_exception(exchange(m_exception, nullptr));
+}
+
+void ThreadPool::run(vector<function<void()>> _tasks)
+{
+	size_t remaining = _tasks.size();
+	exception_ptr exception;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		for (function<void()>& task: _tasks)
+			m_tasks.emplace_back([this, task = move(task), &remaining, &exception]() {
+				try
+				{
+					task();
+				}
+				catch (...)
+				{
+					lock_guard<mutex> lock(m_mutex);
+					if (!exception)
+						exception = current_exception();
+				}
+				lock_guard<mutex> lock(m_mutex);
+				--remaining;
+			});
+	}
+	m_taskAvailable.notify_all();
+
+	unique_lock<mutex> lock(m_mutex);
+	while (remaining > 0)
+		if (m_tasks.empty())
+			m_taskFinished.wait(lock);
+		else
+			runQueuedTask(lock);
+	if (exception)
+		rethrow_exception(exception);
+}
+
+size_t ThreadPool::hardwareConcurrency()
+{
+	return max<size_t>(thread::hardware_concurrency(), 1);
+}
+
+void ThreadPool::work()
+{
+	unique_lock<mutex> lock(m_mutex);
+	while (true)
+	{
+		m_taskAvailable.wait(lock, [&] { return m_shutdown || !m_tasks.empty(); });
+		if (m_tasks.empty())
+			return;
+		runQueuedTask(lock);
+	}
+}
+
+void ThreadPool::runQueuedTask(unique_lock<mutex>& _lock)
+{
+	function<void()> task = move(m_tasks.front());
+	m_tasks.pop_front();
+	++m_runningTasks;
+	_lock.unlock();
+
+	exception_ptr exception;
+	try
+	{
+		task();
+	}
+	catch (...)
+	{
+		exception = current_exception();
+	}
+
+	_lock.lock();
+	if (exception && !m_exception)
+		m_exception = exception;
+	--m_runningTasks;
+	m_taskFinished.notify_all();
+	if (m_tasks.empty() && m_runningTasks == 0)
+		m_idle.notify_all();
+}
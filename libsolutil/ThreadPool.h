@@ -0,0 +1,89 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Fixed-size pool of worker threads.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/**
+ * Fixed number of worker threads that execute posted tasks in the order they were posted.
+ * Tasks may post further tasks to the same pool.
+ *
+ * If a task throws, the first exception is stored and rethrown by wait(); the remaining
+ * tasks are still executed.
+ */
+class ThreadPool
+{
+public:
+	/// Starts @a _threads worker threads (at least one).
+	explicit ThreadPool(size_t _threads);
+	/// Waits for all posted tasks to finish and joins the worker threads.
+	/// Exceptions of tasks that were not retrieved via wait() are dropped.
+	~ThreadPool();
+
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool& operator=(ThreadPool const&) = delete;
+
+	/// Schedules @a _task to be run by one of the worker threads.
+	void post(std::function<void()> _task);
+
+	/// Blocks until all tasks, including the ones posted while waiting, have finished.
+	/// Rethrows the first exception thrown by any of the tasks.
+	/// Must not be called from a task.
+	void wait();
+
+	/// Runs @a _tasks on the worker threads and blocks until all of them have finished.
+	/// Unlike wait(), this can be called from a task: The calling thread runs queued tasks,
+	/// possibly also other ones, until @a _tasks are done. Their exceptions are not stored
+	/// for wait(), but the first one is rethrown.
+	void run(std::vector<std::function<void()>> _tasks);
+
+	/// @returns the number of threads the hardware can run concurrently, at least one.
+	static size_t hardwareConcurrency();
+
+private:
+	void work();
+	/// Runs the first queued task with the lock @a _lock on m_mutex, which is released meanwhile.
+	void runQueuedTask(std::unique_lock<std::mutex>& _lock);
+
+	std::mutex m_mutex;
+	/// Notified when a task is posted or the pool is shutting down.
+	std::condition_variable m_taskAvailable;
+	/// Notified when the last running task finished and the queue is empty.
+	std::condition_variable m_idle;
+	/// Notified when a task finishes.
+	std::condition_variable m_taskFinished;
+	std::deque<std::function<void()>> m_tasks;
+	size_t m_runningTasks = 0;
+	bool m_shutdown = false;
+	std::exception_ptr m_exception;
+	std::vector<std::thread> m_threads;
+};
+
+}
@@ -25,13 +25,159 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
 
+struct Whiskers::Template
+{
+	struct Element
+	{
+		enum class Kind { Text, Tag, List, Condition };
+		Kind kind;
+		/// Literal text or name of the parameter. Names of conditional string parameters start with "+".
+		string value;
+		/// Body of a list or the part of a condition that is used if it is true.
+		unique_ptr<Template const> body;
+		/// Part of a condition that is used if it is false, can be null.
+		unique_ptr<Template const> elseBody;
+	};
+
+	explicit Template(string _source);
+
+	/// The text the template was parsed from, used in error messages.
+	string source;
+	vector<Element> elements;
+
+private:
+	/// Tries to parse an element starting with the "<" at @a _pos.
+	/// @returns the position after the element or string::npos if there is no valid element.
+	size_t parseElement(size_t _pos);
+	/// @returns the length of the parameter name starting at @a _pos.
+	size_t nameLength(size_t _pos) const;
+	void appendText(size_t _begin, size_t _end);
+};
+
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// Templates that are assembled at runtime would let the cache grow without bound,
+/// so it is cleared once it reaches this size.
+size_t const maxCachedTemplates = 4096;
+
+}
+
+Whiskers::Template::Template(string _source):
+	source(move(_source))
+{
+	size_t pos = 0;
+	while (pos < source.size())
+	{
+		size_t tagStart = source.find('<', pos);
+		if (tagStart == string::npos)
+		{
+			appendText(pos, source.size());
+			break;
+		}
+		appendText(pos, tagStart);
+		size_t elementEnd = parseElement(tagStart);
+		if (elementEnd == string::npos)
+		{
+			appendText(tagStart, tagStart + 1);
+			pos = tagStart + 1;
+		}
+		else
+			pos = elementEnd;
+	}
+}
+
+size_t Whiskers::Template::parseElement(size_t _pos)
+{
+	size_t nameStart = _pos + 1;
+	Element element;
+	if (size_t length = nameLength(nameStart))
+	{
+		if (nameStart + length >= source.size() || source[nameStart + length] != '>')
+			return string::npos;
+		element.kind = Element::Kind::Tag;
+		element.value = source.substr(nameStart, length);
+		elements.emplace_back(move(element));
+		return nameStart + length + 1;
+	}
+
+	if (nameStart >= source.size() || (source[nameStart] != '#' && source[nameStart] != '?'))
+		return string::npos;
+	bool isList = source[nameStart] == '#';
+	++nameStart;
+	bool isStringCondition = !isList && nameStart < source.size() && source[nameStart] == '+';
+	size_t length = nameLength(nameStart + (isStringCondition ? 1 : 0));
+	if (length == 0)
+		return string::npos;
+	length += isStringCondition ? 1 : 0;
+	size_t bodyStart = nameStart + length + 1;
+	if (bodyStart > source.size() || source[bodyStart - 1] != '>')
+		return string::npos;
+
+	element.value = source.substr(nameStart, length);
+	size_t bodyEnd = source.find("</" + element.value + ">", bodyStart);
+	if (bodyEnd == string::npos)
+		return string::npos;
+	size_t elementEnd = bodyEnd + element.value.size() + 3;
+
+	if (isList)
+	{
+		element.kind = Element::Kind::List;
+		element.body = make_unique<Template const>(source.substr(bodyStart, bodyEnd - bodyStart));
+	}
+	else
+	{
+		element.kind = Element::Kind::Condition;
+		string elseTag = "<!" + element.value + ">";
+		size_t elseStart = source.find(elseTag, bodyStart);
+		if (elseStart < bodyEnd)
+		{
+			size_t elseBodyStart = elseStart + elseTag.size();
+			element.body = make_unique<Template const>(source.substr(bodyStart, elseStart - bodyStart));
+			element.elseBody = make_unique<Template const>(source.substr(elseBodyStart, bodyEnd - elseBodyStart));
+		}
+		else
+			element.body = make_unique<Template const>(source.substr(bodyStart, bodyEnd - bodyStart));
+	}
+	elements.emplace_back(move(element));
+	return elementEnd;
+}
+
+size_t Whiskers::Template::nameLength(size_t _pos) const
+{
+	size_t end = _pos;
+	while (end < source.size() && isParameterCharacter(source[end]))
+		++end;
+	return end - _pos;
+}
+
+void Whiskers::Template::appendText(size_t _begin, size_t _end)
+{
+	if (_begin == _end)
+		return;
+	if (elements.empty() || elements.back().kind != Element::Kind::Text)
+		elements.emplace_back(Element{Element::Kind::Text, {}, nullptr, nullptr});
+	elements.back().value.append(source, _begin, _end - _begin);
+}
+
 Whiskers::Whiskers(string _template):
-	m_template(move(_template))
+	m_template(compile(move(_template)))
 {
 }
 
@@ -67,14 +213,19 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
+	size_t size = m_template->source.size();
+	for (auto const& parameter: m_parameters)
+		size += parameter.second.size();
+	string result;
+	result.reserve(size);
+	render(*m_template, m_parameters, m_conditions, m_listParameters, result);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -99,79 +250,70 @@ void Whiskers::checkParameterUnknown(string const& _parameter) const
 	);
 }
 
-namespace
-{
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
+shared_ptr<Whiskers::Template const> Whiskers::compile(string _template)
 {
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<Template const>> cache;
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		lock_guard<mutex> lock(cacheMutex);
+		auto it = cache.find(_template);
+		if (it != cache.end())
+			return it->second;
 	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
+
+	auto compiled = make_shared<Template const>(_template);
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() >= maxCachedTemplates)
+		cache.clear();
+	cache.emplace(move(_template), compiled);
+	return compiled;
 }
 
-string Whiskers::replace(
-	string const& _template,
+void Whiskers::render(
+	Template const& _template,
 	StringMap const& _parameters,
 	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
+	StringListMap const& _listParameters,
+	string& _output
 )
 {
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
-	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
+	using Kind = Template::Element::Kind;
+	for (Template::Element const& element: _template.elements)
+		switch (element.kind)
+		{
+		case Kind::Text:
+			_output += element.value;
+			break;
+		case Kind::Tag:
 		{
+			auto parameter = _parameters.find(element.value);
 			assertThrow(
-				_parameters.count(tagName),
+				parameter != _parameters.end(),
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + element.value + " not provided.\n" +
 				"Template:\n" +
-				_template
+				_template.source
 			);
-			return _parameters.at(tagName);
+			_output += parameter->second;
+			break;
 		}
-		else if (!listName.empty())
+		case Kind::List:
 		{
-			string templ(_match[3]);
+			auto list = _listParameters.find(element.value);
 			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
+				list != _listParameters.end(),
+				WhiskersError, "List parameter " + element.value + " not set."
 			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			for (auto const& parameters: list->second)
+				render(*element.body, joinMaps(_parameters, parameters), _conditions, StringListMap(), _output);
+			break;
 		}
-		else
+		case Kind::Condition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
+			if (element.value[0] == '+')
 			{
-				string tag = conditionName.substr(1);
+				string tag = element.value.substr(1);
 				assertThrow(
 					_parameters.count(tag),
 					WhiskersError, "Tag " + tag + " used as condition but was not set."
@@ -181,19 +323,18 @@ string Whiskers::replace(
 			else
 			{
 				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
+					_conditions.count(element.value),
+					WhiskersError, "Condition parameter " + element.value + " not set."
 				);
-				conditionValue = _conditions.at(conditionName);
+				conditionValue = _conditions.at(element.value);
 			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
+			if (conditionValue)
+				render(*element.body, _parameters, _conditions, _listParameters, _output);
+			else if (element.elseBody)
+				render(*element.elseBody, _parameters, _conditions, _listParameters, _output);
+			break;
+		}
 		}
-	});
 }
 
 Whiskers::StringMap Whiskers::joinMaps(
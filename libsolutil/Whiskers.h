@@ -25,6 +25,7 @@
 
 #include <libsolutil/Exceptions.h>
 
+#include <memory>
 #include <string>
 #include <map>
 #include <vector>
@@ -65,6 +66,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *  - List parameter: <#list>...</list>
  *    The part between the tags is repeated as often as values are provided
  *    in the mapping. Each list element can have its own parameter -> value mapping.
+ *
+ * Templates are parsed only once and the parsed form is shared between all objects
+ * created with the same template string.
  */
 class Whiskers
 {
@@ -88,24 +92,30 @@ public:
 	std::string render() const;
 
 private:
+	/// Template string split into literal text and the elements described above.
+	struct Template;
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
-	static std::string replace(
-		std::string const& _template,
+	/// @returns the parsed form of @a _template, which is cached across calls.
+	static std::shared_ptr<Template const> compile(std::string _template);
+
+	/// Appends the expansion of @a _template to @a _output.
+	static void render(
+		Template const& _template,
 		StringMap const& _parameters,
 		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
+		StringListMap const& _listParameters,
+		std::string& _output
 	);
 
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
 	/// Joins the two maps throwing an exception if two keys are equal.
 	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
 
-	std::string m_template;
+	std::shared_ptr<Template const> m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
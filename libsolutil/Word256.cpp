@@ -0,0 +1,367 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Fixed-width 256 bit unsigned integer for evaluating EVM operations.
+ */
+
+#include <libsolutil/Word256.h>
+
+#include <libsolutil/Assertions.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace
+{
+
+using Limb = boost::multiprecision::limb_type;
+constexpr size_t limbBits = sizeof(Limb) * 8;
+static_assert(limbBits == 32 || limbBits == 64, "Unsupported limb size of boost multiprecision.");
+constexpr size_t u256Limbs = 256 / limbBits;
+
+unsigned leadingZeros(uint64_t _value)
+{
+#if defined(__GNUC__)
+	return _value == 0 ? 64 : unsigned(__builtin_clzll(_value));
+#else
+	unsigned zeros = 0;
+	for (uint64_t mask = uint64_t(1) << 63; mask != 0 && !(_value & mask); mask >>= 1)
+		++zeros;
+	return zeros;
+#endif
+}
+
+/// @returns the upper limb of the 128 bit value @a _high, @a _low shifted left by @a _shift < 64 bits.
+uint64_t shiftLeftWide(uint64_t _high, uint64_t _low, unsigned _shift)
+{
+	return _shift == 0 ? _high : (_high << _shift) | (_low >> (64 - _shift));
+}
+
+/// Divides the 128 bit value @a _high, @a _low by @a _divisor, which has to be larger than @a _high,
+/// @returns the quotient and stores the remainder in @a _remainder.
+uint64_t divideWide(uint64_t _high, uint64_t _low, uint64_t _divisor, uint64_t& _remainder)
+{
+#if defined(__SIZEOF_INT128__)
+	util::detail::uint128 dividend = (util::detail::uint128(_high) << 64) | _low;
+	uint64_t quotient = uint64_t(dividend / _divisor);
+	_remainder = uint64_t(dividend - util::detail::uint128(quotient) * _divisor);
+	return quotient;
+#elif defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920
+	return _udiv128(_high, _low, _divisor, &_remainder);
+#else
+	// Hacker's Delight, divlu: schoolbook division with 32 bit digits.
+	uint64_t constexpr base = uint64_t(1) << 32;
+	unsigned shift = leadingZeros(_divisor);
+	_divisor <<= shift;
+	uint64_t divisorHigh = _divisor >> 32;
+	uint64_t divisorLow = _divisor & 0xffffffff;
+	uint64_t numeratorHigh = shiftLeftWide(_high, _low, shift);
+	uint64_t numeratorLow = _low << shift;
+	uint64_t digit1 = numeratorLow >> 32;
+	uint64_t digit0 = numeratorLow & 0xffffffff;
+
+	uint64_t quotient1 = numeratorHigh / divisorHigh;
+	uint64_t remainder = numeratorHigh - quotient1 * divisorHigh;
+	while (quotient1 >= base || quotient1 * divisorLow > remainder * base + digit1)
+	{
+		--quotient1;
+		remainder += divisorHigh;
+		if (remainder >= base)
+			break;
+	}
+	uint64_t middle = numeratorHigh * base + digit1 - quotient1 * _divisor;
+
+	uint64_t quotient0 = middle / divisorHigh;
+	remainder = middle - quotient0 * divisorHigh;
+	while (quotient0 >= base || quotient0 * divisorLow > remainder * base + digit0)
+	{
+		--quotient0;
+		remainder += divisorHigh;
+		if (remainder >= base)
+			break;
+	}
+	_remainder = (middle * base + digit0 - quotient0 * _divisor) >> shift;
+	return quotient1 * base + quotient0;
+#endif
+}
+
+/// @returns the number of significant limbs of @a _limbs.
+template <size_t N>
+size_t significantLimbs(array<uint64_t, N> const& _limbs)
+{
+	size_t length = N;
+	while (length > 0 && _limbs[length - 1] == 0)
+		--length;
+	return length;
+}
+
+/// Divides the @a _m limbs of @a _numerator by the @a _n limbs of @a _divisor with Knuth's
+/// algorithm D (see Hacker's Delight, divmnu64, here with 64 bit digits). Limbs are stored least
+/// significant first. Requires _m >= _n > 0 and a non-zero most significant limb of @a _divisor.
+/// Writes _m - _n + 1 limbs to @a _quotient and _n limbs to @a _remainder.
+void divideLimbs(
+	uint64_t const* _numerator,
+	size_t _m,
+	uint64_t const* _divisor,
+	size_t _n,
+	uint64_t* _quotient,
+	uint64_t* _remainder
+)
+{
+	if (_n == 1)
+	{
+		uint64_t remainder = 0;
+		for (size_t j = _m; j > 0; --j)
+			_quotient[j - 1] = divideWide(remainder, _numerator[j - 1], _divisor[0], remainder);
+		_remainder[0] = remainder;
+		return;
+	}
+
+	// Normalize so that the most significant limb of the divisor has its top bit set.
+	unsigned shift = leadingZeros(_divisor[_n - 1]);
+	uint64_t divisor[4];
+	uint64_t numerator[9];
+	for (size_t i = _n - 1; i > 0; --i)
+		divisor[i] = shiftLeftWide(_divisor[i], _divisor[i - 1], shift);
+	divisor[0] = _divisor[0] << shift;
+	numerator[_m] = shiftLeftWide(0, _numerator[_m - 1], shift);
+	for (size_t i = _m - 1; i > 0; --i)
+		numerator[i] = shiftLeftWide(_numerator[i], _numerator[i - 1], shift);
+	numerator[0] = _numerator[0] << shift;
+
+	uint64_t const divisorHigh = divisor[_n - 1];
+	for (size_t j = _m - _n + 1; j > 0; --j)
+	{
+		size_t const k = j - 1;
+		// Estimate the quotient limb, which is at most two too large.
+		uint64_t quotientLimb;
+		uint64_t remainder;
+		bool remainderOverflow = false;
+		if (numerator[k + _n] >= divisorHigh)
+		{
+			quotientLimb = ~uint64_t(0);
+			remainder = numerator[k + _n - 1] + divisorHigh;
+			remainderOverflow = remainder < divisorHigh;
+		}
+		else
+			quotientLimb = divideWide(numerator[k + _n], numerator[k + _n - 1], divisorHigh, remainder);
+		while (!remainderOverflow)
+		{
+			uint64_t productHigh;
+			uint64_t productLow = util::detail::multiplyWide(quotientLimb, divisor[_n - 2], productHigh);
+			if (productHigh < remainder || (productHigh == remainder && productLow <= numerator[k + _n - 2]))
+				break;
+			--quotientLimb;
+			remainder += divisorHigh;
+			remainderOverflow = remainder < divisorHigh;
+		}
+
+		// Multiply and subtract.
+		uint64_t borrow = 0;
+		for (size_t i = 0; i < _n; ++i)
+		{
+			uint64_t productHigh;
+			uint64_t productLow = util::detail::multiplyWide(quotientLimb, divisor[i], productHigh);
+			productLow += borrow;
+			productHigh += productLow < borrow ? 1 : 0;
+			uint64_t limb = numerator[i + k];
+			numerator[i + k] = limb - productLow;
+			borrow = productHigh + (limb < productLow ? 1 : 0);
+		}
+		bool negative = numerator[k + _n] < borrow;
+		numerator[k + _n] -= borrow;
+
+		_quotient[k] = quotientLimb;
+		if (negative)
+		{
+			// The estimate was one too large, add the divisor back.
+			--_quotient[k];
+			uint64_t carry = 0;
+			for (size_t i = 0; i < _n; ++i)
+			{
+				uint64_t sum = numerator[i + k] + carry;
+				carry = sum < carry ? 1 : 0;
+				numerator[i + k] = sum + divisor[i];
+				carry += numerator[i + k] < sum ? 1 : 0;
+			}
+			numerator[k + _n] += carry;
+		}
+	}
+
+	for (size_t i = 0; i + 1 < _n; ++i)
+		_remainder[i] = shift == 0 ? numerator[i] : (numerator[i] >> shift) | (numerator[i + 1] << (64 - shift));
+	_remainder[_n - 1] = numerator[_n - 1] >> shift;
+}
+
+/// @returns @a _numerator modulo @a _modulus, where @a _modulus is non-zero.
+template <size_t N>
+Word256 remainderOf(array<uint64_t, N> const& _numerator, Word256 const& _modulus)
+{
+	array<uint64_t, 4> divisor{{_modulus.limb(0), _modulus.limb(1), _modulus.limb(2), _modulus.limb(3)}};
+	size_t n = significantLimbs(divisor);
+	assertThrow(n > 0, Exception, "Modulus must not be zero.");
+	size_t m = max(significantLimbs(_numerator), n);
+
+	array<uint64_t, N> quotient;
+	array<uint64_t, 4> remainder{};
+	divideLimbs(_numerator.data(), m, divisor.data(), n, quotient.data(), remainder.data());
+	return Word256::fromLimbs(remainder);
+}
+
+}
+
+Word256::Word256(u256 const& _value)
+{
+	auto const& backend = _value.backend();
+	for (size_t i = 0; i < backend.size(); ++i)
+		m_limbs[i * limbBits / 64] |= uint64_t(backend.limbs()[i]) << (i * limbBits % 64);
+}
+
+Word256::operator u256() const
+{
+	u256 result;
+	auto& backend = result.backend();
+	backend.resize(u256Limbs, u256Limbs);
+	for (size_t i = 0; i < u256Limbs; ++i)
+		backend.limbs()[i] = Limb(m_limbs[i * limbBits / 64] >> (i * limbBits % 64));
+	backend.normalize();
+	return result;
+}
+
+unsigned Word256::bitLength() const
+{
+	for (size_t i = 4; i > 0; --i)
+		if (m_limbs[i - 1] != 0)
+			return unsigned(64 * i) - leadingZeros(m_limbs[i - 1]);
+	return 0;
+}
+
+void Word256::divMod(Word256 const& _a, Word256 const& _b, Word256& _quotient, Word256& _remainder)
+{
+	if (_b.isZero())
+	{
+		_quotient = Word256();
+		_remainder = Word256();
+		return;
+	}
+	if (_a < _b)
+	{
+		_quotient = Word256();
+		_remainder = _a;
+		return;
+	}
+	if (_a.fitsUint64())
+	{
+		_quotient = _a.m_limbs[0] / _b.m_limbs[0];
+		_remainder = _a.m_limbs[0] % _b.m_limbs[0];
+		return;
+	}
+
+	_quotient = Word256();
+	_remainder = Word256();
+	divideLimbs(
+		_a.m_limbs.data(),
+		significantLimbs(_a.m_limbs),
+		_b.m_limbs.data(),
+		significantLimbs(_b.m_limbs),
+		_quotient.m_limbs.data(),
+		_remainder.m_limbs.data()
+	);
+}
+
+Word256 Word256::signedDiv(Word256 const& _a, Word256 const& _b)
+{
+	Word256 quotient = (_a.isNegative() ? -_a : _a) / (_b.isNegative() ? -_b : _b);
+	return _a.isNegative() != _b.isNegative() ? -quotient : quotient;
+}
+
+Word256 Word256::signedMod(Word256 const& _a, Word256 const& _b)
+{
+	Word256 remainder = (_a.isNegative() ? -_a : _a) % (_b.isNegative() ? -_b : _b);
+	return _a.isNegative() ? -remainder : remainder;
+}
+
+Word256 Word256::arithmeticShiftRight(Word256 const& _value, unsigned _shift)
+{
+	if (!_value.isNegative())
+		return _value >> _shift;
+	if (_shift >= 256)
+		return ~Word256();
+	return ~(~_value >> _shift);
+}
+
+Word256 Word256::signExtend(Word256 const& _byteIndex, Word256 const& _value)
+{
+	if (_byteIndex >= 31)
+		return _value;
+	unsigned testBit = unsigned(_byteIndex.m_limbs[0]) * 8 + 7;
+	Word256 mask = (Word256(1) << testBit) - 1;
+	return _value.bit(testBit) ? _value | ~mask : _value & mask;
+}
+
+Word256 Word256::byte(Word256 const& _index, Word256 const& _value)
+{
+	if (_index >= 32)
+		return Word256();
+	return (_value >> unsigned(8 * (31 - _index.m_limbs[0]))) & 0xff;
+}
+
+Word256 Word256::addMod(Word256 const& _a, Word256 const& _b, Word256 const& _modulus)
+{
+	if (_modulus.isZero())
+		return Word256();
+	Word256 sum = _a + _b;
+	array<uint64_t, 5> wideSum{{sum.m_limbs[0], sum.m_limbs[1], sum.m_limbs[2], sum.m_limbs[3], sum < _a ? 1u : 0u}};
+	return remainderOf(wideSum, _modulus);
+}
+
+Word256 Word256::mulMod(Word256 const& _a, Word256 const& _b, Word256 const& _modulus)
+{
+	if (_modulus.isZero())
+		return Word256();
+	array<uint64_t, 8> product{};
+	for (size_t i = 0; i < 4; ++i)
+	{
+		uint64_t carry = 0;
+		for (size_t j = 0; j < 4; ++j)
+		{
+			uint64_t high;
+			uint64_t low = util::detail::multiplyWide(_a.m_limbs[i], _b.m_limbs[j], high);
+			low += carry;
+			high += low < carry ? 1 : 0;
+			product[i + j] += low;
+			high += product[i + j] < low ? 1 : 0;
+			carry = high;
+		}
+		product[i + 4] = carry;
+	}
+	return remainderOf(product, _modulus);
+}
+
+Word256 Word256::exp(Word256 const& _base, Word256 const& _exponent)
+{
+	Word256 result = 1;
+	Word256 power = _base;
+	for (unsigned i = 0, length = _exponent.bitLength(); i < length; ++i)
+	{
+		if (_exponent.bit(i))
+			result *= power;
+		power *= power;
+	}
+	return result;
+}
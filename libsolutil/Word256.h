@@ -0,0 +1,315 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Fixed-width 256 bit unsigned integer for evaluating EVM operations.
+ */
+
+#pragma once
+
+#include <libsolutil/Common.h>
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+namespace solidity::util
+{
+
+namespace detail
+{
+
+#if defined(__SIZEOF_INT128__)
+__extension__ using uint128 = unsigned __int128;
+#endif
+
+/// @returns the lower 64 bits of the product of @a _a and @a _b and stores the upper ones in @a _high.
+inline uint64_t multiplyWide(uint64_t _a, uint64_t _b, uint64_t& _high)
+{
+#if defined(__SIZEOF_INT128__)
+	uint128 product = uint128(_a) * _b;
+	_high = uint64_t(product >> 64);
+	return uint64_t(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+	return _umul128(_a, _b, &_high);
+#else
+	uint64_t aLow = _a & 0xffffffff;
+	uint64_t aHigh = _a >> 32;
+	uint64_t bLow = _b & 0xffffffff;
+	uint64_t bHigh = _b >> 32;
+	uint64_t lowLow = aLow * bLow;
+	uint64_t lowHigh = aLow * bHigh;
+	uint64_t highLow = aHigh * bLow;
+	uint64_t middle = (lowLow >> 32) + (lowHigh & 0xffffffff) + (highLow & 0xffffffff);
+	_high = aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+	return (middle << 32) | (lowLow & 0xffffffff);
+#endif
+}
+
+}
+
+/**
+ * Unsigned 256 bit integer stored in four 64 bit limbs, with the wrapping semantics of EVM words.
+ * Arithmetic on it is a lot cheaper than on u256, so code that evaluates EVM operations on
+ * constants converts to Word256 and back to u256 at its interface to the rest of the compiler.
+ *
+ * Like in the EVM, division and modulo by zero result in zero and shifts by 256 or more bits
+ * result in zero.
+ */
+class Word256
+{
+public:
+	constexpr Word256() = default;
+	/// Converts like u256, i.e. negative values are taken modulo 2**256.
+	template <typename T, typename = std::enable_if_t<std::is_integral_v<T>>>
+	constexpr Word256(T _value):
+		m_limbs{{uint64_t(_value), extension(_value), extension(_value), extension(_value)}}
+	{}
+	explicit Word256(u256 const& _value);
+	/// Creates a word from its limbs, with the least significant limb first.
+	static constexpr Word256 fromLimbs(std::array<uint64_t, 4> const& _limbs)
+	{
+		Word256 result;
+		result.m_limbs = _limbs;
+		return result;
+	}
+
+	explicit operator u256() const;
+
+	/// @returns the limb at @a _index, where the limb at index zero is the least significant one.
+	constexpr uint64_t limb(size_t _index) const { return m_limbs[_index]; }
+
+	bool isZero() const { return (m_limbs[0] | m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0; }
+	/// @returns true if the value fits into a single limb.
+	bool fitsUint64() const { return (m_limbs[1] | m_limbs[2] | m_limbs[3]) == 0; }
+	bool bit(unsigned _index) const { return _index < 256 && ((m_limbs[_index / 64] >> (_index % 64)) & 1); }
+	/// @returns true if the value is negative when interpreted in two's complement.
+	bool isNegative() const { return (m_limbs[3] >> 63) != 0; }
+	/// @returns the number of significant bits, which is zero for zero.
+	unsigned bitLength() const;
+
+	Word256& operator+=(Word256 const& _other);
+	Word256& operator-=(Word256 const& _other);
+	Word256& operator*=(Word256 const& _other) { return *this = *this * _other; }
+	Word256& operator/=(Word256 const& _other) { return *this = *this / _other; }
+	Word256& operator%=(Word256 const& _other) { return *this = *this % _other; }
+	Word256& operator&=(Word256 const& _other);
+	Word256& operator|=(Word256 const& _other);
+	Word256& operator^=(Word256 const& _other);
+	Word256& operator<<=(unsigned _shift) { return *this = *this << _shift; }
+	Word256& operator>>=(unsigned _shift) { return *this = *this >> _shift; }
+
+	friend Word256 operator+(Word256 _a, Word256 const& _b) { return _a += _b; }
+	friend Word256 operator-(Word256 _a, Word256 const& _b) { return _a -= _b; }
+	friend Word256 operator-(Word256 const& _a) { return Word256() - _a; }
+	friend inline Word256 operator*(Word256 const& _a, Word256 const& _b);
+	friend inline Word256 operator/(Word256 const& _a, Word256 const& _b);
+	friend inline Word256 operator%(Word256 const& _a, Word256 const& _b);
+	friend Word256 operator&(Word256 _a, Word256 const& _b) { return _a &= _b; }
+	friend Word256 operator|(Word256 _a, Word256 const& _b) { return _a |= _b; }
+	friend Word256 operator^(Word256 _a, Word256 const& _b) { return _a ^= _b; }
+	friend inline Word256 operator~(Word256 const& _a);
+	friend inline Word256 operator<<(Word256 const& _a, unsigned _shift);
+	friend inline Word256 operator>>(Word256 const& _a, unsigned _shift);
+
+	friend bool operator==(Word256 const& _a, Word256 const& _b) { return _a.m_limbs == _b.m_limbs; }
+	friend bool operator!=(Word256 const& _a, Word256 const& _b) { return _a.m_limbs != _b.m_limbs; }
+	friend inline bool operator<(Word256 const& _a, Word256 const& _b);
+	friend bool operator>(Word256 const& _a, Word256 const& _b) { return _b < _a; }
+	friend bool operator<=(Word256 const& _a, Word256 const& _b) { return !(_b < _a); }
+	friend bool operator>=(Word256 const& _a, Word256 const& _b) { return !(_a < _b); }
+
+	/// Computes the quotient and the remainder of @a _a divided by @a _b at once.
+	static void divMod(Word256 const& _a, Word256 const& _b, Word256& _quotient, Word256& _remainder);
+
+	/// The operations below are the signed and modular operations of the EVM,
+	/// which have no counterpart among the operators.
+	static Word256 signedDiv(Word256 const& _a, Word256 const& _b);
+	static Word256 signedMod(Word256 const& _a, Word256 const& _b);
+	static bool signedLess(Word256 const& _a, Word256 const& _b);
+	static Word256 arithmeticShiftRight(Word256 const& _value, unsigned _shift);
+	/// Extends the sign of @a _value from the byte at @a _byteIndex, counted from the least significant byte.
+	static Word256 signExtend(Word256 const& _byteIndex, Word256 const& _value);
+	/// @returns the byte at @a _index of @a _value, counted from the most significant byte.
+	static Word256 byte(Word256 const& _index, Word256 const& _value);
+	static Word256 addMod(Word256 const& _a, Word256 const& _b, Word256 const& _modulus);
+	static Word256 mulMod(Word256 const& _a, Word256 const& _b, Word256 const& _modulus);
+	static Word256 exp(Word256 const& _base, Word256 const& _exponent);
+
+private:
+	template <typename T>
+	static constexpr uint64_t extension(T _value)
+	{
+		if constexpr (std::is_signed_v<T>)
+			return _value < 0 ? ~uint64_t(0) : 0;
+		else
+			return 0;
+	}
+
+	/// Limbs in little endian order.
+	std::array<uint64_t, 4> m_limbs{};
+};
+
+inline Word256& Word256::operator+=(Word256 const& _other)
+{
+	uint64_t carry = 0;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		uint64_t sum = m_limbs[i] + carry;
+		carry = sum < carry ? 1 : 0;
+		m_limbs[i] = sum + _other.m_limbs[i];
+		carry += m_limbs[i] < sum ? 1 : 0;
+	}
+	return *this;
+}
+
+inline Word256& Word256::operator-=(Word256 const& _other)
+{
+	uint64_t borrow = 0;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		uint64_t subtrahend = _other.m_limbs[i] + borrow;
+		borrow = subtrahend < borrow ? 1 : 0;
+		borrow += m_limbs[i] < subtrahend ? 1 : 0;
+		m_limbs[i] -= subtrahend;
+	}
+	return *this;
+}
+
+inline Word256 operator*(Word256 const& _a, Word256 const& _b)
+{
+	Word256 result;
+	for (size_t i = 0; i < 4; ++i)
+	{
+		if (_a.m_limbs[i] == 0)
+			continue;
+		uint64_t carry = 0;
+		for (size_t j = 0; i + j < 4; ++j)
+		{
+			// The sum of the product and both addends always fits into 128 bits.
+			uint64_t high;
+			uint64_t low = detail::multiplyWide(_a.m_limbs[i], _b.m_limbs[j], high);
+			low += carry;
+			high += low < carry ? 1 : 0;
+			result.m_limbs[i + j] += low;
+			high += result.m_limbs[i + j] < low ? 1 : 0;
+			carry = high;
+		}
+	}
+	return result;
+}
+
+inline Word256 operator/(Word256 const& _a, Word256 const& _b)
+{
+	if (_a.fitsUint64() && _b.fitsUint64())
+		return _b.m_limbs[0] == 0 ? Word256() : Word256(_a.m_limbs[0] / _b.m_limbs[0]);
+	Word256 quotient;
+	Word256 remainder;
+	Word256::divMod(_a, _b, quotient, remainder);
+	return quotient;
+}
+
+inline Word256 operator%(Word256 const& _a, Word256 const& _b)
+{
+	if (_a.fitsUint64() && _b.fitsUint64())
+		return _b.m_limbs[0] == 0 ? Word256() : Word256(_a.m_limbs[0] % _b.m_limbs[0]);
+	Word256 quotient;
+	Word256 remainder;
+	Word256::divMod(_a, _b, quotient, remainder);
+	return remainder;
+}
+
+inline Word256& Word256::operator&=(Word256 const& _other)
+{
+	for (size_t i = 0; i < 4; ++i)
+		m_limbs[i] &= _other.m_limbs[i];
+	return *this;
+}
+
+inline Word256& Word256::operator|=(Word256 const& _other)
+{
+	for (size_t i = 0; i < 4; ++i)
+		m_limbs[i] |= _other.m_limbs[i];
+	return *this;
+}
+
+inline Word256& Word256::operator^=(Word256 const& _other)
+{
+	for (size_t i = 0; i < 4; ++i)
+		m_limbs[i] ^= _other.m_limbs[i];
+	return *this;
+}
+
+inline Word256 operator~(Word256 const& _a)
+{
+	Word256 result;
+	for (size_t i = 0; i < 4; ++i)
+		result.m_limbs[i] = ~_a.m_limbs[i];
+	return result;
+}
+
+inline Word256 operator<<(Word256 const& _a, unsigned _shift)
+{
+	Word256 result;
+	if (_shift >= 256)
+		return result;
+	size_t limbShift = _shift / 64;
+	unsigned bitShift = _shift % 64;
+	for (size_t i = 3; i + 1 > limbShift; --i)
+	{
+		result.m_limbs[i] = _a.m_limbs[i - limbShift] << bitShift;
+		if (bitShift != 0 && i > limbShift)
+			result.m_limbs[i] |= _a.m_limbs[i - limbShift - 1] >> (64 - bitShift);
+	}
+	return result;
+}
+
+inline Word256 operator>>(Word256 const& _a, unsigned _shift)
+{
+	Word256 result;
+	if (_shift >= 256)
+		return result;
+	size_t limbShift = _shift / 64;
+	unsigned bitShift = _shift % 64;
+	for (size_t i = 0; i + limbShift < 4; ++i)
+	{
+		result.m_limbs[i] = _a.m_limbs[i + limbShift] >> bitShift;
+		if (bitShift != 0 && i + limbShift < 3)
+			result.m_limbs[i] |= _a.m_limbs[i + limbShift + 1] << (64 - bitShift);
+	}
+	return result;
+}
+
+inline bool operator<(Word256 const& _a, Word256 const& _b)
+{
+	for (size_t i = 4; i > 0; --i)
+		if (_a.m_limbs[i - 1] != _b.m_limbs[i - 1])
+			return _a.m_limbs[i - 1] < _b.m_limbs[i - 1];
+	return false;
+}
+
+inline bool Word256::signedLess(Word256 const& _a, Word256 const& _b)
+{
+	if (_a.isNegative() != _b.isNegative())
+		return _a.isNegative();
+	return _a < _b;
+}
+
+}
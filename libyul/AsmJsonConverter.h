@@ -23,7 +23,7 @@
 #pragma once
 
 #include <libyul/AsmDataForward.h>
-#include <liblangutil/SourceLocation.h>
+#include <liblangutil/CompactSourceLocation.h>
 #include <json/json.h>
 #include <boost/variant.hpp>
 #include <vector>
@@ -60,7 +60,7 @@ public:
 	Json::Value operator()(Label const& _node) const;
 
 private:
-	Json::Value createAstNode(langutil::SourceLocation const& _location, std::string _nodeType) const;
+	Json::Value createAstNode(langutil::CompactSourceLocation const& _location, std::string _nodeType) const;
 	template <class T>
 	Json::Value vectorOfVariantsToJson(std::vector<T> const& vec) const;
 
@@ -43,6 +43,7 @@
 
 #include <libevmasm/Assembly.h>
 #include <liblangutil/Scanner.h>
+#include <libsolutil/ThreadPool.h>
 
 using namespace std;
 using namespace solidity;
@@ -80,6 +81,7 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 {
 	m_errors.clear();
 	m_analysisSuccessful = false;
+	m_sourceName.clear();
 	m_scanner = make_shared<Scanner>(CharStream(_source, _sourceName));
 	m_parserResult = ObjectParser(m_errorReporter, languageToDialect(m_language, m_evmVersion)).parse(m_scanner, false);
 	if (!m_errorReporter.errors().empty())
@@ -90,6 +92,19 @@ bool AssemblyStack::parseAndAnalyze(std::string const& _sourceName, std::string
 	return analyzeParsed();
 }
 
+bool AssemblyStack::analyze(shared_ptr<Object> _object, string const& _sourceName)
+{
+	yulAssert(_object, "");
+	yulAssert(_object->code, "");
+	m_errors.clear();
+	m_analysisSuccessful = false;
+	m_scanner.reset();
+	m_sourceName = _sourceName;
+	m_parserResult = move(_object);
+
+	return analyzeParsed();
+}
+
 void AssemblyStack::optimize()
 {
 	if (!m_optimiserSettings.runYulOptimiser)
@@ -99,7 +114,18 @@ void AssemblyStack::optimize()
 
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
+	list<OptimiserProfile> profiles;
+	list<OptimiserProfile>* profilesIfEnabled = m_profileOptimiser ? &profiles : nullptr;
+	if (m_parallelism > 1)
+	{
+		util::ThreadPool threadPool(m_parallelism);
+		optimize(*m_parserResult, true, &threadPool, profilesIfEnabled);
+		threadPool.wait();
+	}
+	else
+		optimize(*m_parserResult, true, nullptr, profilesIfEnabled);
+	for (OptimiserProfile const& profile: profiles)
+		m_optimiserProfile.merge(profile);
 	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
 }
 
@@ -164,28 +190,48 @@ void AssemblyStack::compileEVM(AbstractAssembly& _assembly, bool _evm15, bool _o
 			break;
 	}
 
-	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _evm15, _optimize);
+	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _evm15, _optimize, m_parallelism);
 }
 
-void AssemblyStack::optimize(Object& _object, bool _isCreation)
+void AssemblyStack::optimize(
+	Object& _object,
+	bool _isCreation,
+	util::ThreadPool* _threadPool,
+	list<OptimiserProfile>* _profiles
+)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
 	for (auto& subNode: _object.subObjects)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
-			optimize(*subObject, false);
-
-	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
-	unique_ptr<GasMeter> meter;
-	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
-		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
-	OptimiserSuite::run(
-		dialect,
-		meter.get(),
-		_object,
-		m_optimiserSettings.optimizeStackAllocation,
-		m_optimiserSettings.yulOptimiserSteps
-	);
+			optimize(*subObject, false, _threadPool, _profiles);
+
+	// Each object gets its own profile, so that the tasks do not share any state.
+	OptimiserProfile* profile = _profiles ? &_profiles->emplace_back() : nullptr;
+
+	// The optimiser only modifies the code of the object itself and uses its own name dispenser,
+	// so the objects can be optimised in any order or concurrently.
+	auto optimizeObject = [this, &_object, _isCreation, _threadPool, profile]()
+	{
+		Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+		unique_ptr<GasMeter> meter;
+		if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
+			meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
+		OptimiserSuite::run(
+			dialect,
+			meter.get(),
+			_object,
+			m_optimiserSettings.optimizeStackAllocation,
+			m_optimiserSettings.yulOptimiserSteps,
+			{},
+			_threadPool,
+			profile
+		);
+	};
+	if (_threadPool)
+		_threadPool->post(optimizeObject);
+	else
+		optimizeObject();
 }
 
 MachineAssemblyObject AssemblyStack::assemble(Machine _machine) const
@@ -243,7 +289,7 @@ pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleAndGue
 	creationObject.sourceMappings = make_unique<string>(
 		evmasm::AssemblyItem::computeSourceMapping(
 			assembly.items(),
-			{{scanner().charStream() ? scanner().charStream()->name() : "", 0}}
+			{{sourceName(), 0}}
 		)
 	);
 
@@ -257,7 +303,7 @@ pair<MachineAssemblyObject, MachineAssemblyObject> AssemblyStack::assembleAndGue
 		runtimeObject.sourceMappings = make_unique<string>(
 			evmasm::AssemblyItem::computeSourceMapping(
 				runtimeAssembly.items(),
-				{{scanner().charStream() ? scanner().charStream()->name() : "", 0}}
+				{{sourceName(), 0}}
 			)
 		);
 	}
@@ -272,6 +318,13 @@ string AssemblyStack::print() const
 	return m_parserResult->toString(&languageToDialect(m_language, m_evmVersion)) + "\n";
 }
 
+string AssemblyStack::sourceName() const
+{
+	if (m_scanner && m_scanner->charStream())
+		return m_scanner->charStream()->name();
+	return m_sourceName;
+}
+
 shared_ptr<Object> AssemblyStack::parserResult() const
 {
 	yulAssert(m_analysisSuccessful, "Analysis was not successful.");
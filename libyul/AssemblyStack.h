@@ -26,11 +26,14 @@
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
 #include <libevmasm/LinkerObject.h>
 
+#include <algorithm>
+#include <list>
 #include <memory>
 #include <string>
 
@@ -39,6 +42,11 @@ namespace solidity::langutil
 class Scanner;
 }
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::yul
 {
 class AbstractAssembly;
@@ -71,6 +79,17 @@ public:
 		m_errorReporter(m_errors)
 	{}
 
+	/// Sets the maximum number of threads used to optimise and to compile the sub-objects
+	/// of the object and to optimise the functions of each object. The output does not
+	/// depend on this.
+	void setParallelism(size_t _parallelism) { m_parallelism = std::max<size_t>(_parallelism, 1); }
+
+	/// Enables collecting statistics about the runs of the optimiser steps in optimize().
+	void enableOptimiserProfile(bool _enable = true) { m_profileOptimiser = _enable; }
+	/// @returns the statistics about the optimiser steps of all objects, which are only
+	/// collected if enabled.
+	OptimiserProfile const& optimiserProfile() const { return m_optimiserProfile; }
+
 	/// @returns the scanner used during parsing
 	langutil::Scanner const& scanner() const;
 
@@ -78,6 +97,12 @@ public:
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Runs the analysis step on @a _object instead of parsing source code, returns false if
+	/// the object cannot be assembled. The object has to be in the language of this stack,
+	/// e.g. created by a code generator, and is modified by the later steps.
+	/// Multiple calls overwrite the previous state.
+	bool analyze(std::shared_ptr<Object> _object, std::string const& _sourceName = "");
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
 	void optimize();
@@ -107,15 +132,32 @@ private:
 	bool analyzeParsed();
 	bool analyzeParsed(yul::Object& _object);
 
+	/// @returns the name of the source used in the source mappings.
+	std::string sourceName() const;
+
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _evm15, bool _optimize) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	/// Optimises @a _object and its sub-objects. If @a _threadPool is given, each object is
+	/// optimised by a separate task posted to it, which also uses the pool to optimise the
+	/// functions of the object. If @a _profiles is given, the statistics
+	/// about the optimiser steps of each object are collected in a new element of it.
+	void optimize(
+		yul::Object& _object,
+		bool _isCreation,
+		util::ThreadPool* _threadPool,
+		std::list<OptimiserProfile>* _profiles
+	);
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
+	size_t m_parallelism = 1;
+	bool m_profileOptimiser = false;
+	OptimiserProfile m_optimiserProfile;
 
 	std::shared_ptr<langutil::Scanner> m_scanner;
+	/// Name of the source if the object was not parsed by this stack.
+	std::string m_sourceName;
 
 	bool m_analysisSuccessful = false;
 	std::shared_ptr<yul::Object> m_parserResult;
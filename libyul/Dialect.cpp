@@ -21,6 +21,8 @@
 #include <libyul/Dialect.h>
 #include <libyul/AsmData.h>
 
+#include <mutex>
+
 using namespace solidity::yul;
 using namespace std;
 using namespace solidity::langutil;
@@ -28,8 +30,8 @@ using namespace solidity::langutil;
 Literal Dialect::zeroLiteralForType(solidity::yul::YulString _type) const
 {
 	if (_type == boolType && _type != defaultType)
-		return {SourceLocation{}, LiteralKind::Boolean, "false"_yulstring, _type};
-	return {SourceLocation{}, LiteralKind::Number, "0"_yulstring, _type};
+		return {CompactSourceLocation{}, LiteralKind::Boolean, "false"_yulstring, _type};
+	return {CompactSourceLocation{}, LiteralKind::Number, "0"_yulstring, _type};
 }
 
 bool Dialect::validTypeForLiteral(LiteralKind _kind, YulString, YulString _type) const
@@ -44,6 +46,8 @@ Dialect const& Dialect::yulDeprecated()
 {
 	static unique_ptr<Dialect> dialect;
 	static YulStringRepository::ResetCallback callback{[&] { dialect.reset(); }};
+	static mutex dialectMutex;
+	lock_guard<mutex> lock(dialectMutex);
 
 	if (!dialect)
 	{
@@ -28,6 +28,11 @@
 #include <memory>
 #include <set>
 
+namespace solidity::langutil
+{
+class CharStream;
+}
+
 namespace solidity::yul
 {
 struct Dialect;
@@ -74,6 +79,9 @@ public:
 	std::vector<std::shared_ptr<ObjectNode>> subObjects;
 	std::map<YulString, size_t> subIndexByName;
 	std::shared_ptr<yul::AsmAnalysisInfo> analysisInfo;
+	/// Source of the code, which keeps the source locations of the code valid, since
+	/// they only refer to it weakly.
+	std::shared_ptr<langutil::CharStream> charStream;
 };
 
 }
@@ -43,6 +43,7 @@ shared_ptr<Object> ObjectParser::parse(shared_ptr<Scanner> const& _scanner, bool
 			// Special case: Code-only form.
 			object = make_shared<Object>();
 			object->name = "object"_yulstring;
+			object->charStream = m_scanner->charStream();
 			object->code = parseBlock();
 			if (!object->code)
 				return nullptr;
@@ -71,6 +72,7 @@ shared_ptr<Object> ObjectParser::parseObject(Object* _containingObject)
 
 	shared_ptr<Object> ret = make_shared<Object>();
 	ret->name = parseUniqueName(_containingObject);
+	ret->charStream = m_scanner->charStream();
 
 	expectToken(Token::LBrace);
 
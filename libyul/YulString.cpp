@@ -0,0 +1,133 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * String abstraction that avoids copies.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libyul/Exceptions.h>
+
+using namespace std;
+using namespace solidity::yul;
+
+namespace
+{
+/// Guards the list of reset callbacks, which are registered from different dialects.
+mutex& resetCallbackMutex()
+{
+	static mutex callbackMutex;
+	return callbackMutex;
+}
+
+/// Guards the number of scopes, which is also held while the repository is reset at the end
+/// of the last scope, so that no new scope starts during the reset.
+mutex& scopeMutex()
+{
+	static mutex countMutex;
+	return countMutex;
+}
+
+size_t scopeCount = 0;
+}
+
+YulStringRepository::YulStringRepository()
+{
+	for (auto& block: m_blocks)
+		block.store(nullptr, memory_order_relaxed);
+	addString(string{});
+}
+
+YulStringRepository::~YulStringRepository()
+{
+	for (auto& block: m_blocks)
+		delete block.load(memory_order_relaxed);
+}
+
+YulStringRepository::Handle YulStringRepository::stringToHandle(string const& _string)
+{
+	if (_string.empty())
+		return { 0, emptyHash() };
+	uint64_t h = hash(_string);
+	Shard& shard = m_shards[h % shardCount];
+	lock_guard<mutex> lock(shard.mutex);
+	auto range = shard.hashToID.equal_range(h);
+	for (auto it = range.first; it != range.second; ++it)
+		if (idToString(it->second) == _string)
+			return Handle{it->second, h};
+	size_t id = addString(_string);
+	shard.hashToID.emplace_hint(range.second, make_pair(h, id));
+
+	return Handle{id, h};
+}
+
+void YulStringRepository::reset()
+{
+	lock_guard<mutex> lock(resetCallbackMutex());
+	for (auto const& cb: resetCallbacks())
+		cb();
+	instance().clear();
+}
+
+YulStringRepository::ResetCallback::ResetCallback(function<void()> _fun)
+{
+	lock_guard<mutex> lock(resetCallbackMutex());
+	YulStringRepository::resetCallbacks().emplace_back(move(_fun));
+}
+
+YulStringRepository::Scope::Scope()
+{
+	lock_guard<mutex> lock(scopeMutex());
+	++scopeCount;
+}
+
+YulStringRepository::Scope::~Scope()
+{
+	lock_guard<mutex> lock(scopeMutex());
+	if (--scopeCount == 0)
+		reset();
+}
+
+size_t YulStringRepository::addString(string const& _string)
+{
+	size_t id = m_nextID.fetch_add(1, memory_order_relaxed);
+	yulAssert(id / blockSize < maxBlocks, "Too many distinct Yul strings.");
+	atomic<Block*>& slot = m_blocks[id / blockSize];
+	Block* block = slot.load(memory_order_acquire);
+	if (!block)
+	{
+		// Several threads can start a new block at the same time, only one of them wins.
+		auto newBlock = make_unique<Block>();
+		if (slot.compare_exchange_strong(block, newBlock.get(), memory_order_acq_rel))
+			block = newBlock.release();
+	}
+	(*block)[id % blockSize] = _string;
+	return id;
+}
+
+void YulStringRepository::clear()
+{
+	for (Shard& shard: m_shards)
+	{
+		lock_guard<mutex> lock(shard.mutex);
+		shard.hashToID.clear();
+	}
+	for (auto& block: m_blocks)
+		delete block.exchange(nullptr);
+	m_nextID = 0;
+	addString(string{});
+}
@@ -22,8 +22,11 @@
 
 #include <boost/noncopyable.hpp>
 
+#include <array>
+#include <atomic>
 #include <unordered_map>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <functional>
@@ -35,6 +38,11 @@ namespace solidity::yul
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
 /// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
 /// non-deterministic) and a deterministic string hash.
+///
+/// Strings can be added and looked up from several threads concurrently. The hash table is split
+/// into shards with their own locks and the strings are stored in blocks that are never moved,
+/// so looking up a string by its ID does not need a lock. IDs stay valid until the next reset(),
+/// which happens when the last Scope ends.
 class YulStringRepository
 {
 public:
@@ -50,22 +58,12 @@ public:
 		return inst;
 	}
 
-	Handle stringToHandle(std::string const& _string)
+	Handle stringToHandle(std::string const& _string);
+	std::string const& idToString(size_t _id) const
 	{
-		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
-		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
-
-		return Handle{id, h};
+		Block const* block = m_blocks[_id / blockSize].load(std::memory_order_acquire);
+		return (*block)[_id % blockSize];
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
 	static std::uint64_t hash(std::string const& v)
 	{
@@ -81,31 +79,50 @@ public:
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
 	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Use with care - there cannot be any dangling YulString references and no other
+	/// thread may use the repository at the same time.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
-	static void reset()
-	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
-	}
+	static void reset();
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
 	struct ResetCallback
 	{
-		ResetCallback(std::function<void()> _fun)
-		{
-			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
-		}
+		ResetCallback(std::function<void()> _fun);
+	};
+	/// Lifetime of the strings of a compilation. The repository is reset when the last scope
+	/// that exists at the same time ends, so that the strings of concurrent compilations stay
+	/// valid while the memory of finished ones is still freed.
+	class Scope: boost::noncopyable
+	{
+	public:
+		Scope();
+		~Scope();
 	};
 
 private:
-	YulStringRepository() = default;
+	static constexpr size_t blockSize = 4096;
+	static constexpr size_t maxBlocks = 16384;
+	static constexpr size_t shardCount = 16;
+
+	using Block = std::array<std::string, blockSize>;
+	struct Shard
+	{
+		std::mutex mutex;
+		std::unordered_multimap<std::uint64_t, size_t> hashToID;
+	};
+
+	YulStringRepository();
+	~YulStringRepository();
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
+	YulStringRepository(YulStringRepository&&) = delete;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+	YulStringRepository& operator=(YulStringRepository&& _rhs) = delete;
+
+	/// Stores @a _string under a new ID.
+	size_t addString(std::string const& _string);
+	/// Removes all strings apart from the empty string, which always has ID zero.
+	void clear();
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
@@ -113,8 +130,11 @@ private:
 		return callbacks;
 	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	/// Strings by ID, in blocks of blockSize strings that are allocated on demand.
+	std::array<std::atomic<Block*>, maxBlocks> m_blocks;
+	std::atomic<size_t> m_nextID{0};
+	/// IDs by string hash. The shard of a string is determined by its hash.
+	std::array<Shard, shardCount> m_shards;
 };
 
 /// Wrapper around handles into the YulString repository.
@@ -26,6 +26,7 @@
 #include <libyul/Utilities.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Word256.h>
 
 #include <variant>
 
@@ -132,9 +133,10 @@ Representation const& RepresentationFinder::findRepresentation(u256 const& _valu
 		routine = min(move(routine), represent("not"_yulstring, findRepresentation(~_value)));
 
 	// Decompose value into a * 2**k + b where abs(b) << 2**k
+	Word256 const value(_value);
 	for (unsigned bits = 255; bits > 8 && m_maxSteps > 0; --bits)
 	{
-		unsigned gapDetector = unsigned((_value >> (bits - 8)) & 0x1ff);
+		unsigned gapDetector = unsigned((value >> (bits - 8)).limb(0) & 0x1ff);
 		if (gapDetector != 0xff && gapDetector != 0x100)
 			continue;
 
@@ -26,7 +26,7 @@
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/AsmData.h>
 
-#include <liblangutil/SourceLocation.h>
+#include <liblangutil/CompactSourceLocation.h>
 
 #include <libsolutil/Common.h>
 
@@ -73,7 +73,7 @@ public:
 	RepresentationFinder(
 		EVMDialect const& _dialect,
 		GasMeter const& _meter,
-		langutil::SourceLocation _location,
+		langutil::CompactSourceLocation _location,
 		std::map<u256, Representation>& _cache
 	):
 		m_dialect(_dialect),
@@ -99,7 +99,7 @@ private:
 
 	EVMDialect const& m_dialect;
 	GasMeter const& m_meter;
-	langutil::SourceLocation m_location;
+	langutil::CompactSourceLocation m_location;
 	/// Counter for the complexity of optimization, will stop when it reaches zero.
 	size_t m_maxSteps = 10000;
 	std::map<u256, Representation>& m_cache;
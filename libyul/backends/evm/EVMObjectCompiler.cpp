@@ -26,13 +26,32 @@
 #include <libyul/Object.h>
 #include <libyul/Exceptions.h>
 
+#include <libsolutil/ThreadPool.h>
+
 using namespace solidity::yul;
 using namespace std;
 
-void EVMObjectCompiler::compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize)
+void EVMObjectCompiler::compile(
+	Object& _object,
+	AbstractAssembly& _assembly,
+	EVMDialect const& _dialect,
+	bool _evm15,
+	bool _optimize,
+	size_t _parallelism
+)
 {
-	EVMObjectCompiler compiler(_assembly, _dialect, _evm15);
-	compiler.run(_object, _optimize);
+	if (_parallelism > 1)
+	{
+		util::ThreadPool threadPool(_parallelism);
+		EVMObjectCompiler compiler(_assembly, _dialect, _evm15, &threadPool);
+		compiler.run(_object, _optimize);
+		threadPool.wait();
+	}
+	else
+	{
+		EVMObjectCompiler compiler(_assembly, _dialect, _evm15, nullptr);
+		compiler.run(_object, _optimize);
+	}
 }
 
 void EVMObjectCompiler::run(Object& _object, bool _optimize)
@@ -43,9 +62,27 @@ void EVMObjectCompiler::run(Object& _object, bool _optimize)
 	for (auto& subNode: _object.subObjects)
 		if (Object* subObject = dynamic_cast<Object*>(subNode.get()))
 		{
+			// Sub-assemblies are created here in a fixed order, which determines their IDs.
+			// Filling them does not touch the assembly of this object.
 			auto subAssemblyAndID = m_assembly.createSubAssembly();
 			context.subIDs[subObject->name] = subAssemblyAndID.second;
-			compile(*subObject, *subAssemblyAndID.first, m_dialect, m_evm15, _optimize);
+			// The task must not refer to this compiler, which might be destroyed before it runs.
+			auto compileSubObject = [
+				subObject,
+				subAssembly = subAssemblyAndID.first,
+				dialect = &m_dialect,
+				evm15 = m_evm15,
+				threadPool = m_threadPool,
+				_optimize
+			]()
+			{
+				EVMObjectCompiler compiler(*subAssembly, *dialect, evm15, threadPool);
+				compiler.run(*subObject, _optimize);
+			};
+			if (m_threadPool)
+				m_threadPool->post(compileSubObject);
+			else
+				compileSubObject();
 		}
 		else
 		{
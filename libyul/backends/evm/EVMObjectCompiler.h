@@ -20,6 +20,13 @@
 
 #pragma once
 
+#include <cstddef>
+
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::yul
 {
 struct Object;
@@ -29,10 +36,20 @@ struct EVMDialect;
 class EVMObjectCompiler
 {
 public:
-	static void compile(Object& _object, AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, bool _optimize);
+	/// Compiles @a _object into @a _assembly and its sub-objects into sub-assemblies.
+	/// If @a _parallelism is larger than one, the sub-objects are compiled on up to that many
+	/// threads. Each of them has its own sub-assembly, so the result is the same.
+	static void compile(
+		Object& _object,
+		AbstractAssembly& _assembly,
+		EVMDialect const& _dialect,
+		bool _evm15,
+		bool _optimize,
+		size_t _parallelism = 1
+	);
 private:
-	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15):
-		m_assembly(_assembly), m_dialect(_dialect), m_evm15(_evm15)
+	EVMObjectCompiler(AbstractAssembly& _assembly, EVMDialect const& _dialect, bool _evm15, util::ThreadPool* _threadPool):
+		m_assembly(_assembly), m_dialect(_dialect), m_evm15(_evm15), m_threadPool(_threadPool)
 	{}
 
 	void run(Object& _object, bool _optimize);
@@ -40,6 +57,8 @@ private:
 	AbstractAssembly& m_assembly;
 	EVMDialect const& m_dialect;
 	bool m_evm15 = false;
+	/// Pool the sub-objects are compiled on, compiled in the current thread if null.
+	util::ThreadPool* m_threadPool = nullptr;
 };
 
 }
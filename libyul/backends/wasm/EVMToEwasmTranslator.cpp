@@ -1245,6 +1245,7 @@ Object EVMToEwasmTranslator::run(Object const& _object)
 	ret.name = _object.name;
 	ret.code = make_shared<Block>(move(ast));
 	ret.analysisInfo = make_shared<AsmAnalysisInfo>();
+	ret.charStream = _object.charStream;
 
 	ErrorList errors;
 	ErrorReporter errorReporter(errors);
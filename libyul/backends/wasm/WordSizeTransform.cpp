@@ -276,7 +276,7 @@ void WordSizeTransform::rewriteIdentifierList(vector<Identifier>& _ids)
 }
 
 vector<Statement> WordSizeTransform::handleSwitchInternal(
-	langutil::SourceLocation const& _location,
+	langutil::CompactSourceLocation const& _location,
 	vector<YulString> const& _splitExpressions,
 	vector<Case> _cases,
 	YulString _runDefaultFlag,
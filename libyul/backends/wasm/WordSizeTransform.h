@@ -23,7 +23,7 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <libyul/optimiser/NameDispenser.h>
 
-#include <liblangutil/SourceLocation.h>
+#include <liblangutil/CompactSourceLocation.h>
 
 #include <array>
 #include <vector>
@@ -86,7 +86,7 @@ private:
 
 	std::vector<Statement> handleSwitch(Switch& _switch);
 	std::vector<Statement> handleSwitchInternal(
-		langutil::SourceLocation const& _location,
+		langutil::CompactSourceLocation const& _location,
 		std::vector<YulString> const& _splitExpressions,
 		std::vector<Case> _cases,
 		YulString _runDefaultFlag,
@@ -44,6 +44,23 @@ void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _
 	cse(_ast);
 }
 
+FunctionLocalRun CommonSubexpressionEliminator::prepareFunctionLocalRun(
+	OptimiserStepContext& _context,
+	Block const& _ast
+)
+{
+	auto functionSideEffects = SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	uint64_t contextHash = SideEffectsPropagator::hash(functionSideEffects);
+	return {
+		[&dialect = _context.dialect, functionSideEffects = move(functionSideEffects)](Statement& _statement)
+		{
+			CommonSubexpressionEliminator cse{dialect, functionSideEffects};
+			cse.visit(_statement);
+		},
+		contextHash
+	};
+}
+
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
 	Dialect const& _dialect,
 	map<YulString, SideEffects> _functionSideEffects
@@ -41,6 +41,8 @@ class CommonSubexpressionEliminator: public DataFlowAnalyzer
 public:
 	static constexpr char const* name{"CommonSubexpressionEliminator"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	/// Prepares running the step on single functions, see OptimiserStep::prepareFunctionLocalRun.
+	static FunctionLocalRun prepareFunctionLocalRun(OptimiserStepContext&, Block const& _ast);
 
 private:
 	CommonSubexpressionEliminator(
@@ -71,7 +71,7 @@ void ConditionalSimplifier::operator()(Block& _block)
 				)
 				{
 					YulString condition = std::get<Identifier>(*_if.condition).name;
-					langutil::SourceLocation location = _if.location;
+					langutil::CompactSourceLocation location = _if.location;
 					return make_vector<Statement>(
 						std::move(_s),
 						Assignment{
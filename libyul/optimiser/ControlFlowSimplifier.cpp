@@ -37,7 +37,7 @@ namespace
 {
 
 ExpressionStatement makeDiscardCall(
-	langutil::SourceLocation const& _location,
+	langutil::CompactSourceLocation const& _location,
 	BuiltinFunction const& _discardFunction,
 	Expression&& _expression
 )
@@ -38,6 +38,16 @@ void DeadCodeEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	DeadCodeEliminator{_context.dialect}(_ast);
 }
 
+FunctionLocalRun DeadCodeEliminator::prepareFunctionLocalRun(OptimiserStepContext& _context, Block const&)
+{
+	// The main block is the only statement of the grouped AST that is not a function definition,
+	// so nothing is removed from the top-level block itself.
+	return {[&dialect = _context.dialect](Statement& _statement)
+	{
+		DeadCodeEliminator{dialect}.visit(_statement);
+	}};
+}
+
 void DeadCodeEliminator::operator()(ForLoop& _for)
 {
 	yulAssert(_for.pre.statements.empty(), "DeadCodeEliminator needs ForLoopInitRewriter as a prerequisite.");
@@ -30,6 +30,7 @@ namespace solidity::yul
 {
 struct Dialect;
 struct OptimiserStepContext;
+struct FunctionLocalRun;
 
 /**
  * Optimisation stage that removes unreachable code
@@ -50,6 +51,8 @@ class DeadCodeEliminator: public ASTModifier
 public:
 	static constexpr char const* name{"DeadCodeEliminator"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	/// Prepares running the step on single functions, see OptimiserStep::prepareFunctionLocalRun.
+	static FunctionLocalRun prepareFunctionLocalRun(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void operator()(ForLoop& _for) override;
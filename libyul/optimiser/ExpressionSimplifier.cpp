@@ -36,6 +36,15 @@ void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 	ExpressionSimplifier{_context.dialect}(_ast);
 }
 
+FunctionLocalRun ExpressionSimplifier::prepareFunctionLocalRun(OptimiserStepContext& _context, Block const&)
+{
+	return {[&dialect = _context.dialect](Statement& _statement)
+	{
+		ExpressionSimplifier simplifier{dialect};
+		static_cast<ASTModifier&>(simplifier).visit(_statement);
+	}};
+}
+
 void ExpressionSimplifier::visit(Expression& _expression)
 {
 	ASTModifier::visit(_expression);
@@ -28,6 +28,7 @@ namespace solidity::yul
 {
 struct Dialect;
 struct OptimiserStepContext;
+struct FunctionLocalRun;
 
 /**
  * Applies simplification rules to all expressions.
@@ -44,6 +45,8 @@ class ExpressionSimplifier: public DataFlowAnalyzer
 public:
 	static constexpr char const* name{"ExpressionSimplifier"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	/// Prepares running the step on single functions, see OptimiserStep::prepareFunctionLocalRun.
+	static FunctionLocalRun prepareFunctionLocalRun(OptimiserStepContext&, Block const& _ast);
 
 	using ASTModifier::operator();
 	void visit(Expression& _expression) override;
@@ -44,10 +44,11 @@ public:
 
 	void operator()(Block& _block);
 
+	/// @returns true if @a _block already has the form this step produces.
+	static bool alreadyGrouped(Block const& _block);
+
 private:
 	FunctionGrouper() = default;
-
-	bool alreadyGrouped(Block const& _block);
 };
 
 }
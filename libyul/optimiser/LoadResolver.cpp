@@ -41,6 +41,21 @@ void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 	}(_ast);
 }
 
+FunctionLocalRun LoadResolver::prepareFunctionLocalRun(OptimiserStepContext& _context, Block const& _ast)
+{
+	auto functionSideEffects = SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	bool optimizeMLoad = !MSizeFinder::containsMSize(_context.dialect, _ast);
+	uint64_t contextHash = SideEffectsPropagator::hash(functionSideEffects) * 2 + (optimizeMLoad ? 1 : 0);
+	return {
+		[&dialect = _context.dialect, functionSideEffects = move(functionSideEffects), optimizeMLoad](Statement& _statement)
+		{
+			LoadResolver resolver{dialect, functionSideEffects, optimizeMLoad};
+			static_cast<ASTModifier&>(resolver).visit(_statement);
+		},
+		contextHash
+	};
+}
+
 void LoadResolver::visit(Expression& _e)
 {
 	DataFlowAnalyzer::visit(_e);
@@ -45,6 +45,8 @@ public:
 	static constexpr char const* name{"LoadResolver"};
 	/// Run the load resolver on the given complete AST.
 	static void run(OptimiserStepContext&, Block& _ast);
+	/// Prepares running the step on single functions, see OptimiserStep::prepareFunctionLocalRun.
+	static FunctionLocalRun prepareFunctionLocalRun(OptimiserStepContext&, Block const& _ast);
 
 private:
 	LoadResolver(
@@ -39,6 +39,25 @@ void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects}(_ast);
 }
 
+FunctionLocalRun LoopInvariantCodeMotion::prepareFunctionLocalRun(OptimiserStepContext& _context, Block const& _ast)
+{
+	// Variables are only assigned to inside of the function that declares them, so only the
+	// function itself determines which of its variables are SSA variables.
+	auto functionSideEffects = SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	uint64_t contextHash = SideEffectsPropagator::hash(functionSideEffects);
+	return {
+		[
+			&dialect = _context.dialect,
+			ssaVariables = SSAValueTracker::ssaVariables(_ast),
+			functionSideEffects = move(functionSideEffects)
+		](Statement& _statement)
+		{
+			LoopInvariantCodeMotion{dialect, ssaVariables, functionSideEffects}.visit(_statement);
+		},
+		contextHash
+	};
+}
+
 void LoopInvariantCodeMotion::operator()(Block& _block)
 {
 	util::iterateReplacing(
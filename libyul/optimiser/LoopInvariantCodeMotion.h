@@ -41,6 +41,8 @@ class LoopInvariantCodeMotion: public ASTModifier
 public:
 	static constexpr char const* name{"LoopInvariantCodeMotion"};
 	static void run(OptimiserStepContext& _context, Block& _ast);
+	/// Prepares running the step on single functions, see OptimiserStep::prepareFunctionLocalRun.
+	static FunctionLocalRun prepareFunctionLocalRun(OptimiserStepContext&, Block const& _ast);
 
 	void operator()(Block& _block) override;
 
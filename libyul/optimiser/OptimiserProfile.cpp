@@ -0,0 +1,67 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Statistics about the runs of the optimiser steps.
+ */
+
+#include <libyul/optimiser/OptimiserProfile.h>
+
+#include <libyul/optimiser/Suite.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+void OptimiserProfile::addRun(char _step, chrono::nanoseconds _time, size_t _nodesBefore, size_t _nodesAfter, bool _changed)
+{
+	StepStatistics& statistics = steps[_step];
+	statistics.runs++;
+	if (_changed)
+		statistics.changes++;
+	statistics.time += _time;
+	statistics.nodesBefore += _nodesBefore;
+	statistics.nodesAfter += _nodesAfter;
+}
+
+void OptimiserProfile::merge(OptimiserProfile const& _other)
+{
+	for (auto const& [step, other]: _other.steps)
+	{
+		StepStatistics& statistics = steps[step];
+		statistics.runs += other.runs;
+		statistics.changes += other.changes;
+		statistics.time += other.time;
+		statistics.nodesBefore += other.nodesBefore;
+		statistics.nodesAfter += other.nodesAfter;
+	}
+}
+
+Json::Value OptimiserProfile::toJson() const
+{
+	Json::Value ret(Json::objectValue);
+	for (auto const& [step, statistics]: steps)
+	{
+		Json::Value& entry = ret[string(1, step)];
+		entry["name"] = OptimiserSuite::stepAbbreviationToNameMap().at(step);
+		entry["runs"] = Json::UInt64(statistics.runs);
+		entry["changes"] = Json::UInt64(statistics.changes);
+		entry["microseconds"] = Json::UInt64(chrono::duration_cast<chrono::microseconds>(statistics.time).count());
+		entry["nodesBefore"] = Json::UInt64(statistics.nodesBefore);
+		entry["nodesAfter"] = Json::UInt64(statistics.nodesAfter);
+	}
+	return ret;
+}
@@ -0,0 +1,62 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Statistics about the runs of the optimiser steps.
+ */
+
+#pragma once
+
+#include <json/json.h>
+
+#include <chrono>
+#include <map>
+
+namespace solidity::yul
+{
+
+/**
+ * Statistics about the runs of the optimiser steps, aggregated per step abbreviation.
+ */
+struct OptimiserProfile
+{
+	struct StepStatistics
+	{
+		/// Number of times the step was run.
+		size_t runs = 0;
+		/// Number of runs that changed the code.
+		size_t changes = 0;
+		/// Wall time spent in the step.
+		std::chrono::nanoseconds time{0};
+		/// Number of AST nodes before and after the runs, summed over all runs.
+		size_t nodesBefore = 0;
+		size_t nodesAfter = 0;
+	};
+
+	/// Adds a run of the step with the abbreviation @a _step.
+	void addRun(char _step, std::chrono::nanoseconds _time, size_t _nodesBefore, size_t _nodesAfter, bool _changed);
+	/// Adds the statistics of @a _other to this profile.
+	void merge(OptimiserProfile const& _other);
+
+	/// @returns an object that maps the abbreviations of the steps to the name of the step, the
+	/// number of runs and of runs that changed the code, the time in microseconds and the sums
+	/// of the node counts before and after the runs.
+	Json::Value toJson() const;
+
+	std::map<char, StepStatistics> steps;
+};
+
+}
@@ -17,16 +17,19 @@
 
 #pragma once
 
+#include <libyul/AsmDataForward.h>
 #include <libyul/Exceptions.h>
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <set>
+#include <type_traits>
 
 namespace solidity::yul
 {
 
 struct Dialect;
-struct Block;
 class YulString;
 class NameDispenser;
 
@@ -37,6 +40,18 @@ struct OptimiserStepContext
 	std::set<YulString> const& reservedIdentifiers;
 };
 
+/**
+ * Optimiser step prepared to be run separately on the top-level statements of an AST.
+ */
+struct FunctionLocalRun
+{
+	/// Applies the step to one statement. Can be called concurrently for different statements.
+	std::function<void(Statement&)> run;
+	/// Hash of the information about the rest of the AST that the step uses. If neither this
+	/// nor a statement changed, running the step on the statement again has the same effect.
+	uint64_t contextHash = 0;
+};
+
 
 /**
  * Construction to create dynamically callable objects out of the
@@ -48,9 +63,25 @@ struct OptimiserStep
 	virtual ~OptimiserStep() = default;
 
 	virtual void run(OptimiserStepContext&, Block&) const = 0;
+	/// Prepares running the step separately on each top-level statement of @a _ast, which has
+	/// to consist of the main block followed by function definitions.
+	/// @returns a function that applies the step to one of these statements, or an empty
+	/// function if the step does not support this and has to be run on the whole AST.
+	virtual FunctionLocalRun prepareFunctionLocalRun(OptimiserStepContext&, Block const&) const
+	{
+		return {};
+	}
 	std::string name;
 };
 
+/// Steps that only modify the code inside of functions and of the main block, do not create new
+/// names and only depend on information about other functions that they gather before they
+/// modify anything, provide `prepareFunctionLocalRun` with the same meaning as above.
+template <class Step, class = void>
+struct IsFunctionLocalStep: std::false_type {};
+template <class Step>
+struct IsFunctionLocalStep<Step, std::void_t<decltype(&Step::prepareFunctionLocalRun)>>: std::true_type {};
+
 template <class Step>
 struct OptimiserStepInstance: public OptimiserStep
 {
@@ -59,6 +90,13 @@ struct OptimiserStepInstance: public OptimiserStep
 	{
 		Step::run(_context, _ast);
 	}
+	FunctionLocalRun prepareFunctionLocalRun(OptimiserStepContext& _context, Block const& _ast) const override
+	{
+		if constexpr (IsFunctionLocalStep<Step>::value)
+			return Step::prepareFunctionLocalRun(_context, _ast);
+		else
+			return {};
+	}
 };
 
 
@@ -41,6 +41,18 @@ void RedundantAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
 	remover(_ast);
 }
 
+FunctionLocalRun RedundantAssignEliminator::prepareFunctionLocalRun(OptimiserStepContext& _context, Block const&)
+{
+	return {[&dialect = _context.dialect](Statement& _statement)
+	{
+		RedundantAssignEliminator rae{dialect};
+		rae.visit(_statement);
+
+		AssignmentRemover remover{rae.m_pendingRemovals};
+		remover.visit(_statement);
+	}};
+}
+
 void RedundantAssignEliminator::operator()(Identifier const& _identifier)
 {
 	changeUndecidedTo(_identifier.name, State::Used);
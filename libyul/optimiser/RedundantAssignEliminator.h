@@ -110,6 +110,8 @@ class RedundantAssignEliminator: public ASTWalker
 public:
 	static constexpr char const* name{"RedundantAssignEliminator"};
 	static void run(OptimiserStepContext&, Block& _ast);
+	/// Prepares running the step on single functions, see OptimiserStep::prepareFunctionLocalRun.
+	static FunctionLocalRun prepareFunctionLocalRun(OptimiserStepContext&, Block const& _ast);
 
 	explicit RedundantAssignEliminator(Dialect const& _dialect): m_dialect(&_dialect) {}
 	RedundantAssignEliminator() = delete;
@@ -30,6 +30,8 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/Algorithms.h>
 
+#include <boost/functional/hash.hpp>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -153,6 +155,21 @@ map<YulString, SideEffects> SideEffectsPropagator::sideEffects(
 	return ret;
 }
 
+uint64_t SideEffectsPropagator::hash(map<YulString, SideEffects> const& _sideEffects)
+{
+	size_t hash = _sideEffects.size();
+	for (auto const& [name, sideEffects]: _sideEffects)
+	{
+		boost::hash_combine(hash, name.hash());
+		boost::hash_combine(hash, sideEffects.movable);
+		boost::hash_combine(hash, sideEffects.sideEffectFree);
+		boost::hash_combine(hash, sideEffects.sideEffectFreeIfNoMSize);
+		boost::hash_combine(hash, sideEffects.invalidatesStorage);
+		boost::hash_combine(hash, sideEffects.invalidatesMemory);
+	}
+	return hash;
+}
+
 MovableChecker::MovableChecker(Dialect const& _dialect, Expression const& _expression):
 	MovableChecker(_dialect)
 {
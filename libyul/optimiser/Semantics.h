@@ -88,6 +88,9 @@ public:
 		Dialect const& _dialect,
 		CallGraph const& _directCallGraph
 	);
+
+	/// @returns a hash of the names and side effects in @a _sideEffects.
+	static uint64_t hash(std::map<YulString, SideEffects> const& _sideEffects);
 };
 
 /**
@@ -46,7 +46,8 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	if (!instruction)
 		return nullptr;
 
-	static std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
+	// The rules keep the state of the current match, so every thread needs its own copy.
+	static thread_local std::map<std::optional<EVMVersion>, std::unique_ptr<SimplificationRules>> evmRules;
 
 	std::optional<EVMVersion> version;
 	if (yul::EVMDialect const* evmDialect = dynamic_cast<yul::EVMDialect const*>(&_dialect))
@@ -58,19 +59,22 @@ SimplificationRules::Rule const* SimplificationRules::findFirstMatch(
 	SimplificationRules& rules = *evmRules[version];
 	assertThrow(rules.isInitialized(), OptimizerException, "Rule list not properly initialized.");
 
-	for (auto const& rule: rules.m_rules[uint8_t(instruction->first)])
+	evmasm::Shape shapes[2] = {evmasm::AnyShape, evmasm::AnyShape};
+	for (size_t i = 0; i < min<size_t>(instruction->second->size(), 2); ++i)
+		shapes[i] = shapeOf(instruction->second->at(i), _dialect, _ssaValues);
+	for (auto const* rule: rules.m_rules.candidates(instruction->first, shapes[0], shapes[1]))
 	{
 		rules.resetMatchGroups();
-		if (rule.pattern.matches(_expr, _dialect, _ssaValues))
-			if (!rule.feasible || rule.feasible())
-				return &rule;
+		if (rule->pattern.matches(_expr, _dialect, _ssaValues))
+			if (!rule->feasible || rule->feasible())
+				return rule;
 	}
 	return nullptr;
 }
 
 bool SimplificationRules::isInitialized() const
 {
-	return !m_rules[uint8_t(evmasm::Instruction::ADD)].empty();
+	return m_rules.hasRules(evmasm::Instruction::ADD);
 }
 
 std::optional<std::pair<evmasm::Instruction, vector<Expression> const*>>
@@ -85,15 +89,27 @@ std::optional<std::pair<evmasm::Instruction, vector<Expression> const*>>
 	return {};
 }
 
-void SimplificationRules::addRules(std::vector<Rule> const& _rules)
+evmasm::Shape SimplificationRules::shapeOf(
+	Expression const& _expr,
+	Dialect const& _dialect,
+	map<YulString, AssignedValue> const& _ssaValues
+)
 {
-	for (auto const& r: _rules)
-		addRule(r);
-}
+	Expression const* expr = &_expr;
+	// Resolve variables in the same way as Pattern::matches does for constants and operations.
+	if (holds_alternative<Identifier>(_expr))
+	{
+		auto it = _ssaValues.find(std::get<Identifier>(_expr).name);
+		if (it != _ssaValues.end() && it->second.value)
+			expr = it->second.value;
+	}
 
-void SimplificationRules::addRule(Rule const& _rule)
-{
-	m_rules[uint8_t(_rule.pattern.instruction())].push_back(_rule);
+	if (holds_alternative<Literal>(*expr) && std::get<Literal>(*expr).kind == LiteralKind::Number)
+		return evmasm::ConstantShape;
+	else if (auto instrAndArgs = instructionAndArguments(_dialect, *expr))
+		return uint8_t(instrAndArgs->first);
+	else
+		return evmasm::AnyShape;
 }
 
 SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _evmVersion)
@@ -116,7 +132,10 @@ SimplificationRules::SimplificationRules(std::optional<langutil::EVMVersion> _ev
 	Y.setMatchGroup(6, m_matchGroups);
 	Z.setMatchGroup(7, m_matchGroups);
 
-	addRules(simplificationRuleList(_evmVersion, A, B, C, W, X, Y, Z));
+	vector<Rule> rules = simplificationRuleList(_evmVersion, A, B, C, W, X, Y, Z);
+	for (Rule& rule: rules)
+		rule.pattern.compile();
+	m_rules = evmasm::SimplificationRuleIndex<Pattern>(rules);
 	assertThrow(isInitialized(), OptimizerException, "Rule list not properly initialized.");
 }
 
@@ -127,98 +146,133 @@ yul::Pattern::Pattern(evmasm::Instruction _instruction, initializer_list<Pattern
 {
 }
 
-void Pattern::setMatchGroup(unsigned _group, map<unsigned, Expression const*>& _matchGroups)
+void Pattern::setMatchGroup(unsigned _group, evmasm::MatchGroups<Expression>& _matchGroups)
 {
+	assertThrow(0 < _group && _group < _matchGroups.size(), OptimizerException, "Invalid match group.");
 	m_matchGroup = _group;
 	m_matchGroups = &_matchGroups;
 }
 
+void Pattern::compile()
+{
+	vector<MatchStep> steps;
+	appendMatchSteps(steps);
+	assertThrow(steps.size() <= maxMatchSteps, OptimizerException, "Pattern too large.");
+	m_steps = make_shared<vector<MatchStep> const>(move(steps));
+}
+
+void Pattern::appendMatchSteps(vector<MatchStep>& _steps) const
+{
+	_steps.push_back(MatchStep{
+		m_kind,
+		m_kind == PatternKind::Operation ? m_instruction : evmasm::Instruction::STOP,
+		m_arguments.size(),
+		m_data ? make_optional(*m_data) : nullopt,
+		m_matchGroup,
+		m_matchGroups
+	});
+	for (Pattern const& argument: m_arguments)
+		argument.appendMatchSteps(_steps);
+}
+
 bool Pattern::matches(
 	Expression const& _expr,
 	Dialect const& _dialect,
 	map<YulString, AssignedValue> const& _ssaValues
 ) const
 {
-	Expression const* expr = &_expr;
-
-	// Resolve the variable if possible.
-	// Do not do it for "Any" because we can check identity better for variables.
-	if (m_kind != PatternKind::Any && holds_alternative<Identifier>(_expr))
+	assertThrow(m_steps, OptimizerException, "Pattern not compiled.");
+
+	// Walks the expression alongside the pre-order steps using a fixed-size stack of the
+	// expressions still to be matched.
+	//
+	// Variables are resolved to their values, but not for "Any", because identity can be checked
+	// better on variables. Repeated match groups compare the unresolved expressions for the same
+	// reason, assuming that CSE or local value numbering has been done before. Constants in match
+	// groups store the resolved expression, because the actual number is needed.
+	auto const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
+	array<Expression const*, maxMatchSteps> pending;
+	size_t pendingCount = 0;
+	pending[pendingCount++] = &_expr;
+
+	for (MatchStep const& step: *m_steps)
 	{
-		YulString varName = std::get<Identifier>(_expr).name;
-		if (_ssaValues.count(varName))
-			if (Expression const* new_expr = _ssaValues.at(varName).value)
-				expr = new_expr;
-	}
-	assertThrow(expr, OptimizerException, "");
+		assertThrow(pendingCount > 0, OptimizerException, "");
+		Expression const& original = *pending[--pendingCount];
+		Expression const* expr = &original;
+		if (step.kind != PatternKind::Any && holds_alternative<Identifier>(original))
+		{
+			auto it = _ssaValues.find(std::get<Identifier>(original).name);
+			if (it != _ssaValues.end() && it->second.value)
+				expr = it->second.value;
+		}
 
-	if (m_kind == PatternKind::Constant)
-	{
-		if (!holds_alternative<Literal>(*expr))
-			return false;
-		Literal const& literal = std::get<Literal>(*expr);
-		if (literal.kind != LiteralKind::Number)
-			return false;
-		if (m_data && *m_data != u256(literal.value.str()))
-			return false;
-		assertThrow(m_arguments.empty(), OptimizerException, "");
-	}
-	else if (m_kind == PatternKind::Operation)
-	{
-		auto instrAndArgs = SimplificationRules::instructionAndArguments(_dialect, *expr);
-		if (!instrAndArgs || m_instruction != instrAndArgs->first)
-			return false;
-		assertThrow(m_arguments.size() == instrAndArgs->second->size(), OptimizerException, "");
-		for (size_t i = 0; i < m_arguments.size(); ++i)
-			if (!m_arguments[i].matches(instrAndArgs->second->at(i), _dialect, _ssaValues))
+		switch (step.kind)
+		{
+		case PatternKind::Constant:
+		{
+			Literal const* literal = get_if<Literal>(expr);
+			if (!literal || literal->kind != LiteralKind::Number)
 				return false;
-	}
-	else
-	{
-		assertThrow(m_arguments.empty(), OptimizerException, "\"Any\" should not have arguments.");
-	}
-
-	if (m_matchGroup)
-	{
-		// We support matching multiple expressions that require the same value
-		// based on identical ASTs, which have to be movable.
-
-		// TODO: add tests:
-		// - { let x := mload(0) let y := and(x, x) }
-		// - { let x := 4 let y := and(x, y) }
-
-		// This code uses `_expr` again for "Any", because we want the comparison to be done
-		// on the variables and not their values.
-		// The assumption is that CSE or local value numbering has been done prior to this step.
-
-		if (m_matchGroups->count(m_matchGroup))
+			if (step.data && *step.data != u256(literal->value.str()))
+				return false;
+			break;
+		}
+		case PatternKind::Operation:
 		{
-			assertThrow(m_kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
-			Expression const* firstMatch = (*m_matchGroups)[m_matchGroup];
-			assertThrow(firstMatch, OptimizerException, "Match set but to null.");
-			return
-				SyntacticallyEqual{}(*firstMatch, _expr) &&
-				SideEffectsCollector(_dialect, _expr).movable();
+			FunctionCall const* call = get_if<FunctionCall>(expr);
+			if (!call || !evmDialect)
+				return false;
+			auto const* builtin = evmDialect->builtin(call->functionName.name);
+			if (!builtin || builtin->instruction != step.instruction)
+				return false;
+			assertThrow(step.arguments == call->arguments.size(), OptimizerException, "");
+			for (auto it = call->arguments.rbegin(); it != call->arguments.rend(); ++it)
+				pending[pendingCount++] = &*it;
+			break;
+		}
+		case PatternKind::Any:
+			break;
 		}
-		else if (m_kind == PatternKind::Any)
-			(*m_matchGroups)[m_matchGroup] = &_expr;
-		else
+
+		if (step.matchGroup)
 		{
-			assertThrow(m_kind == PatternKind::Constant, OptimizerException, "Match group set for operation.");
-			// We do not use _expr here, because we want the actual number.
-			(*m_matchGroups)[m_matchGroup] = expr;
+			if (Expression const* firstMatch = (*step.matchGroups)[step.matchGroup])
+			{
+				assertThrow(step.kind == PatternKind::Any, OptimizerException, "Match group repetition for non-any.");
+				if (!SyntacticallyEqual{}(*firstMatch, original) || !SideEffectsCollector(_dialect, original).movable())
+					return false;
+			}
+			else if (step.kind == PatternKind::Any)
+				(*step.matchGroups)[step.matchGroup] = &original;
+			else
+			{
+				assertThrow(step.kind == PatternKind::Constant, OptimizerException, "Match group set for operation.");
+				(*step.matchGroups)[step.matchGroup] = expr;
+			}
 		}
 	}
+	assertThrow(pendingCount == 0, OptimizerException, "");
 	return true;
 }
 
+evmasm::Shape Pattern::shape() const
+{
+	if (m_kind == PatternKind::Operation)
+		return uint8_t(m_instruction);
+	else if (m_kind == PatternKind::Constant)
+		return evmasm::ConstantShape;
+	else
+		return evmasm::AnyShape;
+}
+
 evmasm::Instruction Pattern::instruction() const
 {
 	assertThrow(m_kind == PatternKind::Operation, OptimizerException, "");
 	return m_instruction;
 }
 
-Expression Pattern::toExpression(SourceLocation const& _location) const
+Expression Pattern::toExpression(CompactSourceLocation const& _location) const
 {
 	if (matchGroup())
 		return ASTCopier().translate(matchGroupValue());
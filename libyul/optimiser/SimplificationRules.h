@@ -21,6 +21,7 @@
 #pragma once
 
 #include <libevmasm/SimplificationRule.h>
+#include <libevmasm/SimplificationRuleIndex.h>
 
 #include <libyul/AsmDataForward.h>
 #include <libyul/AsmData.h>
@@ -32,6 +33,7 @@
 #include <boost/noncopyable.hpp>
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -68,13 +70,18 @@ public:
 	instructionAndArguments(Dialect const& _dialect, Expression const& _expr);
 
 private:
-	void addRules(std::vector<Rule> const& _rules);
-	void addRule(Rule const& _rule);
+	/// @returns the shape of @a _expr as far as patterns are concerned, i.e. after resolving
+	/// variables with known values.
+	static evmasm::Shape shapeOf(
+		Expression const& _expr,
+		Dialect const& _dialect,
+		std::map<YulString, AssignedValue> const& _ssaValues
+	);
 
-	void resetMatchGroups() { m_matchGroups.clear(); }
+	void resetMatchGroups() { m_matchGroups.fill(nullptr); }
 
-	std::map<unsigned, Expression const*> m_matchGroups;
-	std::vector<evmasm::SimplificationRule<Pattern>> m_rules[256];
+	evmasm::MatchGroups<Expression> m_matchGroups{};
+	evmasm::SimplificationRuleIndex<Pattern> m_rules;
 };
 
 enum class PatternKind
@@ -109,8 +116,14 @@ public:
 	/// Sets this pattern to be part of the match group with the identifier @a _group.
 	/// Inside one rule, all patterns in the same match group have to match expressions from the
 	/// same expression equivalence class.
-	void setMatchGroup(unsigned _group, std::map<unsigned, Expression const*>& _matchGroups);
+	void setMatchGroup(unsigned _group, evmasm::MatchGroups<Expression>& _matchGroups);
 	unsigned matchGroup() const { return m_matchGroup; }
+	/// Flattens this pattern into a sequence of matching steps that `matches` then executes
+	/// instead of traversing the tree of argument patterns. Only used for the top-level
+	/// patterns of rules, their arguments are never matched on their own.
+	void compile();
+	/// @returns true if @a _expr matches this pattern and assigns the matched expressions to
+	/// the match groups. Can only be called after `compile`.
 	bool matches(
 		Expression const& _expr,
 		Dialect const& _dialect,
@@ -118,6 +131,8 @@ public:
 	) const;
 
 	std::vector<Pattern> arguments() const { return m_arguments; }
+	/// @returns the shape of the expressions this pattern can match.
+	evmasm::Shape shape() const;
 
 	/// @returns the data of the matched expression if this pattern is part of a match group.
 	u256 d() const;
@@ -126,9 +141,24 @@ public:
 
 	/// Turns this pattern into an actual expression. Should only be called
 	/// for patterns resulting from an action, i.e. with match groups assigned.
-	Expression toExpression(langutil::SourceLocation const& _location) const;
+	Expression toExpression(langutil::CompactSourceLocation const& _location) const;
 
 private:
+	/// A single pattern of a compiled pattern tree, which is stored in pre-order.
+	struct MatchStep
+	{
+		PatternKind kind;
+		evmasm::Instruction instruction; ///< Only valid if kind is Operation
+		size_t arguments; ///< Only valid if kind is Operation
+		std::optional<u256> data; ///< Only valid if kind is Constant
+		unsigned matchGroup;
+		evmasm::MatchGroups<Expression>* matchGroups; ///< Only valid if matchGroup is nonzero
+	};
+	/// Upper bound on the number of steps of a compiled pattern. This also bounds the number
+	/// of expressions waiting to be matched.
+	static constexpr size_t maxMatchSteps = 16;
+
+	void appendMatchSteps(std::vector<MatchStep>& _steps) const;
 	Expression const& matchGroupValue() const;
 
 	PatternKind m_kind = PatternKind::Any;
@@ -136,7 +166,9 @@ private:
 	std::shared_ptr<u256> m_data; ///< Only valid if m_kind is Constant
 	std::vector<Pattern> m_arguments;
 	unsigned m_matchGroup = 0;
-	std::map<unsigned, Expression const*>* m_matchGroups = nullptr;
+	evmasm::MatchGroups<Expression>* m_matchGroups = nullptr;
+	/// Steps of this pattern if it was compiled, shared between copies of the pattern.
+	std::shared_ptr<std::vector<MatchStep> const> m_steps;
 };
 
 }
@@ -0,0 +1,188 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that calculates hash values for statements.
+ */
+
+#include <libyul/optimiser/StatementHasher.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+enum NodeKind: uint8_t
+{
+	LiteralNode,
+	IdentifierNode,
+	FunctionCallNode,
+	ExpressionStatementNode,
+	AssignmentNode,
+	VariableDeclarationNode,
+	IfNode,
+	SwitchNode,
+	CaseNode,
+	FunctionDefinitionNode,
+	ForLoopNode,
+	BreakNode,
+	ContinueNode,
+	LeaveNode,
+	BlockNode
+};
+}
+
+uint64_t StatementHasher::run(Statement const& _statement)
+{
+	StatementHasher hasher;
+	hasher.visit(_statement);
+	return hasher.m_hash;
+}
+
+uint64_t StatementHasher::run(Block const& _block)
+{
+	StatementHasher hasher;
+	hasher(_block);
+	return hasher.m_hash;
+}
+
+void StatementHasher::operator()(Literal const& _literal)
+{
+	hashNode(LiteralNode, _literal.location);
+	hash64(static_cast<uint64_t>(_literal.kind));
+	hash64(_literal.value.hash());
+	hash64(_literal.type.hash());
+}
+
+void StatementHasher::operator()(Identifier const& _identifier)
+{
+	hashNode(IdentifierNode, _identifier.location);
+	hash64(_identifier.name.hash());
+}
+
+void StatementHasher::operator()(FunctionCall const& _funCall)
+{
+	hashNode(FunctionCallNode, _funCall.location);
+	(*this)(_funCall.functionName);
+	hash64(_funCall.arguments.size());
+	ASTWalker::operator()(_funCall);
+}
+
+void StatementHasher::operator()(ExpressionStatement const& _statement)
+{
+	hashNode(ExpressionStatementNode, _statement.location);
+	ASTWalker::operator()(_statement);
+}
+
+void StatementHasher::operator()(Assignment const& _assignment)
+{
+	hashNode(AssignmentNode, _assignment.location);
+	hash64(_assignment.variableNames.size());
+	ASTWalker::operator()(_assignment);
+}
+
+void StatementHasher::operator()(VariableDeclaration const& _varDecl)
+{
+	hashNode(VariableDeclarationNode, _varDecl.location);
+	hashTypedNames(_varDecl.variables);
+	hash64(_varDecl.value ? 1 : 0);
+	ASTWalker::operator()(_varDecl);
+}
+
+void StatementHasher::operator()(If const& _if)
+{
+	hashNode(IfNode, _if.location);
+	ASTWalker::operator()(_if);
+}
+
+void StatementHasher::operator()(Switch const& _switch)
+{
+	hashNode(SwitchNode, _switch.location);
+	hash64(_switch.cases.size());
+	visit(*_switch.expression);
+	for (auto const& _case: _switch.cases)
+	{
+		hashNode(CaseNode, _case.location);
+		hash64(_case.value ? 1 : 0);
+		if (_case.value)
+			(*this)(*_case.value);
+		(*this)(_case.body);
+	}
+}
+
+void StatementHasher::operator()(FunctionDefinition const& _funDef)
+{
+	hashNode(FunctionDefinitionNode, _funDef.location);
+	hash64(_funDef.name.hash());
+	hashTypedNames(_funDef.parameters);
+	hashTypedNames(_funDef.returnVariables);
+	ASTWalker::operator()(_funDef);
+}
+
+void StatementHasher::operator()(ForLoop const& _loop)
+{
+	hashNode(ForLoopNode, _loop.location);
+	ASTWalker::operator()(_loop);
+}
+
+void StatementHasher::operator()(Break const& _break)
+{
+	hashNode(BreakNode, _break.location);
+}
+
+void StatementHasher::operator()(Continue const& _continue)
+{
+	hashNode(ContinueNode, _continue.location);
+}
+
+void StatementHasher::operator()(Leave const& _leave)
+{
+	hashNode(LeaveNode, _leave.location);
+}
+
+void StatementHasher::operator()(Block const& _block)
+{
+	hashNode(BlockNode, _block.location);
+	hash64(_block.statements.size());
+	ASTWalker::operator()(_block);
+}
+
+void StatementHasher::hashNode(uint8_t _kind, langutil::CompactSourceLocation const& _location)
+{
+	hash64(_kind);
+	hash64(_location.sourceIndex);
+	hash64(static_cast<uint64_t>(_location.start));
+	hash64(static_cast<uint64_t>(_location.end));
+}
+
+void StatementHasher::hashTypedNames(vector<TypedName> const& _names)
+{
+	hash64(_names.size());
+	for (TypedName const& name: _names)
+	{
+		hash64(name.name.hash());
+		hash64(name.type.hash());
+	}
+}
+
+void StatementHasher::hash64(uint64_t _value)
+{
+	// FNV-1a on whole words, with the high bits folded back so that they also affect the low bits.
+	m_hash ^= _value;
+	m_hash *= 1099511628211u;
+	m_hash ^= m_hash >> 29;
+}
@@ -0,0 +1,73 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Optimiser component that calculates hash values for statements.
+ */
+#pragma once
+
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/AsmDataForward.h>
+#include <libyul/YulString.h>
+#include <libyul/AsmData.h>
+
+namespace solidity::yul
+{
+
+/**
+ * Optimiser component that calculates hash values for statements.
+ *
+ * In contrast to the BlockHasher, all names, types and source locations are taken
+ * into account, so statements with equal hashes are (likely) identical and not
+ * only equal up to renaming. This can be used to detect whether a statement was
+ * changed at all.
+ */
+class StatementHasher: public ASTWalker
+{
+public:
+	static uint64_t run(Statement const& _statement);
+	static uint64_t run(Block const& _block);
+
+	using ASTWalker::operator();
+
+	void operator()(Literal const& _literal) override;
+	void operator()(Identifier const& _identifier) override;
+	void operator()(FunctionCall const& _funCall) override;
+	void operator()(ExpressionStatement const& _statement) override;
+	void operator()(Assignment const& _assignment) override;
+	void operator()(VariableDeclaration const& _varDecl) override;
+	void operator()(If const& _if) override;
+	void operator()(Switch const& _switch) override;
+	void operator()(FunctionDefinition const& _funDef) override;
+	void operator()(ForLoop const& _loop) override;
+	void operator()(Break const& _break) override;
+	void operator()(Continue const& _continue) override;
+	void operator()(Leave const& _leave) override;
+	void operator()(Block const& _block) override;
+
+private:
+	StatementHasher() = default;
+
+	/// Hashes a tag that distinguishes the kinds of nodes and the location of the node.
+	void hashNode(uint8_t _kind, langutil::CompactSourceLocation const& _location);
+	void hashTypedNames(std::vector<TypedName> const& _names);
+
+	void hash64(uint64_t _value);
+
+	uint64_t m_hash = 14695981039346656037u;
+};
+
+}
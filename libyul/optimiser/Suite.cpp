@@ -48,6 +48,7 @@
 #include <libyul/optimiser/SSAReverser.h>
 #include <libyul/optimiser/SSATransform.h>
 #include <libyul/optimiser/StackCompressor.h>
+#include <libyul/optimiser/StatementHasher.h>
 #include <libyul/optimiser/StructuralSimplifier.h>
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/RedundantAssignEliminator.h>
@@ -55,6 +56,7 @@
 #include <libyul/optimiser/LoadResolver.h>
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 #include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
@@ -66,10 +68,13 @@
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
 #include <libsolutil/CommonData.h>
+#include <libsolutil/ThreadPool.h>
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/range/algorithm_ext/erase.hpp>
 
+#include <chrono>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::yul;
@@ -80,7 +85,9 @@ void OptimiserSuite::run(
 	Object& _object,
 	bool _optimizeStackAllocation,
 	string const& _optimisationSequence,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	util::ThreadPool* _threadPool,
+	OptimiserProfile* _profile
 )
 {
 	set<YulString> reservedIdentifiers = _externallyUsedIdentifiers;
@@ -93,7 +100,7 @@ void OptimiserSuite::run(
 	)(*_object.code));
 	Block& ast = *_object.code;
 
-	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast);
+	OptimiserSuite suite(_dialect, reservedIdentifiers, Debug::None, ast, _threadPool, _profile);
 
 	// Some steps depend on properties ensured by FunctionHoister, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -151,42 +158,55 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 	return ret;
 }
 
+/// @returns the number of AST nodes of @a _ast, including all functions.
+size_t nodeCount(Block const& _ast)
+{
+	static CodeWeights const countEveryNode{1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+	return CodeSize::codeSizeIncludingFunctions(_ast, countEveryNode);
+}
+
+/// @returns the name of the function defined by @a _statement or the empty name for the main block.
+YulString statementName(Statement const& _statement)
+{
+	if (auto const* function = get_if<FunctionDefinition>(&_statement))
+		return function->name;
+	return {};
+}
+
 }
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			RedundantAssignEliminator,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		RedundantAssignEliminator,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	return instance;
 }
@@ -306,16 +326,85 @@ void OptimiserSuite::runSequence(string const& _stepAbbreviations, Block& _ast)
 	}
 }
 
+OptimiserSuite::OptimiserSuite(
+	Dialect const& _dialect,
+	set<YulString> const& _externallyUsedIdentifiers,
+	Debug _debug,
+	Block& _ast,
+	util::ThreadPool* _threadPool,
+	OptimiserProfile* _profile
+):
+	m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
+	m_context{_dialect, m_dispenser, _externallyUsedIdentifiers},
+	m_debug(_debug),
+	m_threadPool(_threadPool),
+	m_profile(_profile)
+{
+}
+
+struct OptimiserSuite::ChangeTracker
+{
+	explicit ChangeTracker(size_t _steps): unchanged(_steps) {}
+
+	/// @returns the hashes of the top-level statements of @a _ast, which has to be unchanged
+	/// since the last call unless the hashes were reset.
+	vector<uint64_t>& statementHashes(Block const& _ast)
+	{
+		if (!hashes)
+			hashes = util::applyMap(_ast.statements, [](Statement const& _statement) { return StatementHasher::run(_statement); });
+		return *hashes;
+	}
+
+	/// Hashes of the top-level statements, unset if they have to be recomputed.
+	optional<vector<uint64_t>> hashes;
+	/// For each step of the sequence and each function that the step did not change the last
+	/// time it was run on it, the hashes of the function and of the step context at that time.
+	/// The main block is stored under the empty name.
+	vector<map<YulString, pair<uint64_t, uint64_t>>> unchanged;
+};
+
 void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
+{
+	runSequence(_steps, _ast, nullptr);
+}
+
+void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast, ChangeTracker* _tracker)
 {
 	unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
-	for (string const& step: _steps)
+	for (size_t position = 0; position < _steps.size(); ++position)
 	{
+		string const& step = _steps[position];
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-		allSteps().at(step)->run(m_context, _ast);
+		OptimiserStep const& optimiserStep = *allSteps().at(step);
+		size_t nodesBefore = 0;
+		uint64_t hashBefore = 0;
+		if (m_profile)
+		{
+			nodesBefore = nodeCount(_ast);
+			hashBefore = StatementHasher::run(_ast);
+		}
+		auto start = chrono::steady_clock::now();
+		if (!runOnFunctions(optimiserStep, _ast, _tracker, position))
+		{
+			optimiserStep.run(m_context, _ast);
+			if (_tracker)
+				_tracker->hashes.reset();
+		}
+		if (m_profile)
+		{
+			// The counts and the hash are taken after the time, so that they are not part of it.
+			auto const end = chrono::steady_clock::now();
+			m_profile->addRun(
+				stepNameToAbbreviationMap().at(step),
+				end - start,
+				nodesBefore,
+				nodeCount(_ast),
+				StatementHasher::run(_ast) != hashBefore
+			);
+		}
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
@@ -331,20 +420,91 @@ void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 	}
 }
 
+bool OptimiserSuite::runOnFunctions(
+	OptimiserStep const& _step,
+	Block& _ast,
+	ChangeTracker* _tracker,
+	size_t _position
+)
+{
+	// Without a thread pool, running the step on each function separately only pays off
+	// inside of a tracked sequence, where functions the step did not change are skipped.
+	// Outside of it, the step is run on the whole AST as before.
+	if (!m_threadPool && !_tracker)
+		return false;
+	if (_ast.statements.size() < 2 || !FunctionGrouper::alreadyGrouped(_ast))
+		return false;
+
+	// The step gathers all information about the whole AST before any function is modified,
+	// so the functions can be processed in any order.
+	FunctionLocalRun localRun = _step.prepareFunctionLocalRun(m_context, _ast);
+	if (!localRun.run)
+		return false;
+
+	vector<uint64_t>* hashes = _tracker ? &_tracker->statementHashes(_ast) : nullptr;
+	vector<uint64_t> newHashes = hashes ? *hashes : vector<uint64_t>{};
+	vector<function<void()>> tasks;
+	for (size_t i = 0; i < _ast.statements.size(); ++i)
+	{
+		Statement& statement = _ast.statements[i];
+		if (_tracker)
+		{
+			// If neither the statement nor the information the step uses about the rest of
+			// the AST changed since the step did not change the statement, it would not
+			// change it now either.
+			auto const& unchanged = _tracker->unchanged.at(_position);
+			auto it = unchanged.find(statementName(statement));
+			if (it != unchanged.end() && it->second == make_pair((*hashes)[i], localRun.contextHash))
+				continue;
+		}
+		auto task = [&localRun, &statement, newHash = hashes ? &newHashes[i] : nullptr]()
+		{
+			localRun.run(statement);
+			if (newHash)
+				*newHash = StatementHasher::run(statement);
+		};
+		if (m_threadPool)
+			tasks.emplace_back(move(task));
+		else
+			task();
+	}
+	// The suite itself might run on a thread of the pool, so it cannot wait for the whole pool.
+	if (m_threadPool)
+		m_threadPool->run(move(tasks));
+
+	if (_tracker)
+	{
+		auto& unchanged = _tracker->unchanged.at(_position);
+		for (size_t i = 0; i < _ast.statements.size(); ++i)
+			if (newHashes[i] == (*hashes)[i])
+				unchanged[statementName(_ast.statements[i])] = {newHashes[i], localRun.contextHash};
+			else
+				unchanged.erase(statementName(_ast.statements[i]));
+		*hashes = move(newHashes);
+	}
+	return true;
+}
+
 void OptimiserSuite::runSequenceUntilStable(
 	std::vector<string> const& _steps,
 	Block& _ast,
 	size_t maxRounds
 )
 {
+	ChangeTracker tracker{_steps.size()};
 	size_t codeSize = 0;
+	vector<uint64_t> hashes;
 	for (size_t rounds = 0; rounds < maxRounds; ++rounds)
 	{
+		// If the last round did not change anything, the code size did not change either.
+		if (rounds > 0 && tracker.statementHashes(_ast) == hashes)
+			break;
 		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
 		if (newSize == codeSize)
 			break;
 		codeSize = newSize;
+		hashes = tracker.statementHashes(_ast);
 
-		runSequence(_steps, _ast);
+		runSequence(_steps, _ast, &tracker);
 	}
 }
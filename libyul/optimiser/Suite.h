@@ -30,6 +30,11 @@
 #include <string>
 #include <memory>
 
+namespace solidity::util
+{
+class ThreadPool;
+}
+
 namespace solidity::yul
 {
 
@@ -37,6 +42,7 @@ struct AsmAnalysisInfo;
 struct Dialect;
 class GasMeter;
 struct Object;
+struct OptimiserProfile;
 
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
@@ -57,13 +63,19 @@ public:
 		PrintStep,
 		PrintChanges
 	};
+	/// Runs the optimiser on the code of @a _object. If @a _threadPool is given, steps that only
+	/// change the code inside of functions are run on the functions concurrently on its threads,
+	/// which does not change the result. If @a _profile is given, statistics about the runs of
+	/// the steps are added to it.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
 		Object& _object,
 		bool _optimizeStackAllocation,
 		std::string const& _optimisationSequence,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		util::ThreadPool* _threadPool = nullptr,
+		OptimiserProfile* _profile = nullptr
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -87,16 +99,31 @@ private:
 		Dialect const& _dialect,
 		std::set<YulString> const& _externallyUsedIdentifiers,
 		Debug _debug,
-		Block& _ast
-	):
-		m_dispenser{_dialect, _ast, _externallyUsedIdentifiers},
-		m_context{_dialect, m_dispenser, _externallyUsedIdentifiers},
-		m_debug(_debug)
-	{}
+		Block& _ast,
+		util::ThreadPool* _threadPool,
+		OptimiserProfile* _profile = nullptr
+	);
+
+	/// Records which functions the steps of a sequence that is run until it is stable did not
+	/// change, so that running the steps on them again can be skipped.
+	struct ChangeTracker;
+
+	void runSequence(std::vector<std::string> const& _steps, Block& _ast, ChangeTracker* _tracker);
+
+	/// Runs @a _step separately on the functions of @a _ast if the step supports this and the AST
+	/// is grouped into the main block and function definitions. This happens concurrently if there
+	/// is a thread pool. If @a _tracker is given, the step is the one at @a _position of the
+	/// tracked sequence and is not run on functions that it did not change the last time.
+	/// @returns false if the step still has to be run on the whole AST.
+	bool runOnFunctions(OptimiserStep const& _step, Block& _ast, ChangeTracker* _tracker, size_t _position);
 
 	NameDispenser m_dispenser;
 	OptimiserStepContext m_context;
 	Debug m_debug;
+	/// Pool for running steps on functions concurrently, null if this is done sequentially.
+	util::ThreadPool* m_threadPool = nullptr;
+	/// Statistics about the runs of the steps, not collected if null.
+	OptimiserProfile* m_profile = nullptr;
 };
 
 }
@@ -53,8 +53,11 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/MappedFile.h>
 
+#include <chrono>
 #include <memory>
+#include <thread>
 
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -117,6 +120,7 @@ static string const g_strAstJson = "ast-json";
 static string const g_strAstCompactJson = "ast-compact-json";
 static string const g_strBinary = "bin";
 static string const g_strBinaryRuntime = "bin-runtime";
+static string const g_strCacheDir = "cache-dir";
 static string const g_strCombinedJson = "combined-json";
 static string const g_strCompactJSON = "compact-format";
 static string const g_strContracts = "contracts";
@@ -135,6 +139,7 @@ static string const g_strYulDialect = "yul-dialect";
 static string const g_strIR = "ir";
 static string const g_strIROptimized = "ir-optimized";
 static string const g_strIPFS = "ipfs";
+static string const g_strJobs = "jobs";
 static string const g_strLicense = "license";
 static string const g_strLibraries = "libraries";
 static string const g_strLink = "link";
@@ -142,6 +147,9 @@ static string const g_strMachine = "machine";
 static string const g_strMetadata = "metadata";
 static string const g_strMetadataHash = "metadata-hash";
 static string const g_strMetadataLiteral = "metadata-literal";
+static string const g_strModelCheckerJobs = "model-checker-jobs";
+static string const g_strModelCheckerPortfolio = "model-checker-portfolio";
+static string const g_strModelCheckerTimeout = "model-checker-timeout";
 static string const g_strNatspecDev = "devdoc";
 static string const g_strNatspecUser = "userdoc";
 static string const g_strNone = "none";
@@ -150,11 +158,15 @@ static string const g_strOpcodes = "opcodes";
 static string const g_strOptimize = "optimize";
 static string const g_strOptimizeRuns = "optimize-runs";
 static string const g_strOptimizeYul = "optimize-yul";
+static string const g_strOptimizerProfile = "optimizer-profile";
 static string const g_strYulOptimizations = "yul-optimizations";
 static string const g_strOutputDir = "output-dir";
 static string const g_strOverwrite = "overwrite";
 static string const g_strRevertStrings = "revert-strings";
 static string const g_strStorageLayout = "storage-layout";
+static string const g_strTraceOut = "trace-out";
+static string const g_strTraceSummary = "trace-summary";
+static string const g_strWatch = "watch";
 
 /// Possible arguments to for --revert-strings
 static set<string> const g_revertStringsArgs
@@ -192,6 +204,7 @@ static string const g_argAstCompactJson = g_strAstCompactJson;
 static string const g_argAstJson = g_strAstJson;
 static string const g_argBinary = g_strBinary;
 static string const g_argBinaryRuntime = g_strBinaryRuntime;
+static string const g_argCacheDir = g_strCacheDir;
 static string const g_argCombinedJson = g_strCombinedJson;
 static string const g_argCompactJSON = g_strCompactJSON;
 static string const g_argErrorRecovery = g_strErrorRecovery;
@@ -199,6 +212,7 @@ static string const g_argGas = g_strGas;
 static string const g_argHelp = g_strHelp;
 static string const g_argImportAst = g_strImportAst;
 static string const g_argInputFile = g_strInputFile;
+static string const g_argJobs = g_strJobs;
 static string const g_argYul = g_strYul;
 static string const g_argIR = g_strIR;
 static string const g_argIROptimized = g_strIROptimized;
@@ -214,12 +228,16 @@ static string const g_argNatspecUser = g_strNatspecUser;
 static string const g_argOpcodes = g_strOpcodes;
 static string const g_argOptimize = g_strOptimize;
 static string const g_argOptimizeRuns = g_strOptimizeRuns;
+static string const g_argOptimizerProfile = g_strOptimizerProfile;
 static string const g_argOutputDir = g_strOutputDir;
 static string const g_argSignatureHashes = g_strSignatureHashes;
 static string const g_argStandardJSON = g_strStandardJSON;
 static string const g_argStorageLayout = g_strStorageLayout;
 static string const g_argStrictAssembly = g_strStrictAssembly;
+static string const g_argTraceOut = g_strTraceOut;
+static string const g_argTraceSummary = g_strTraceSummary;
 static string const g_argVersion = g_strVersion;
+static string const g_argWatch = g_strWatch;
 static string const g_stdinFileName = g_stdinFileNameStr;
 static string const g_argIgnoreMissingFiles = g_strIgnoreMissingFiles;
 static string const g_argColor = g_strColor;
@@ -306,6 +324,7 @@ static bool needsHumanTargetedStdout(po::variables_map const& _args)
 		g_argNatspecUser,
 		g_argNatspecDev,
 		g_argOpcodes,
+		g_argOptimizerProfile,
 		g_argSignatureHashes,
 		g_argStorageLayout
 	})
@@ -459,6 +478,38 @@ void CommandLineInterface::handleStorageLayout(string const& _contract)
 		sout() << "Contract Storage Layout:" << endl << data << endl;
 }
 
+void CommandLineInterface::handleOptimiserProfile(string const& _contract)
+{
+	if (!m_args.count(g_argOptimizerProfile))
+		return;
+
+	string data = jsonCompactPrint(m_compiler->optimiserProfile(_contract));
+	if (m_args.count(g_argOutputDir))
+		createFile(m_compiler->filesystemFriendlyName(_contract) + "_optimizer_profile.json", data);
+	else
+		sout() << "Optimizer profile:" << endl << data << endl;
+}
+
+void CommandLineInterface::handleTrace()
+{
+	if (!m_profiler)
+		return;
+
+	if (m_args.count(g_argTraceOut))
+	{
+		string path = m_args[g_argTraceOut].as<string>();
+		ofstream outFile(path);
+		outFile << jsonCompactPrint(m_profiler->chromeTrace());
+		if (!outFile)
+		{
+			serr() << "Could not write the trace to \"" << path << "\"." << endl;
+			m_error = true;
+		}
+	}
+	if (m_args.count(g_argTraceSummary))
+		serr() << m_profiler->summary();
+}
+
 void CommandLineInterface::handleNatspec(bool _natspecDev, string const& _contract)
 {
 	std::string argName;
@@ -589,13 +640,23 @@ bool CommandLineInterface::readInputFilesAndConfigureRemappings()
 					continue;
 				}
 
-				m_sourceCodes[infile.generic_string()] = readFileAsString(infile.string());
+				if (m_args.count(g_argWatch))
+					// The contents must not change when the file is edited.
+					m_sourceCodes[infile.generic_string()] = CharStream(
+						readFileAsString(infile.string()),
+						infile.generic_string()
+					);
+				else
+					m_sourceCodes[infile.generic_string()] = CharStream(
+						make_shared<MappedFile const>(infile.string()),
+						infile.generic_string()
+					);
 				path = boost::filesystem::canonical(infile).string();
 			}
 			m_allowedDirectories.push_back(boost::filesystem::path(path).remove_filename());
 		}
 	if (addStdin)
-		m_sourceCodes[g_stdinFileName] = readStandardInput();
+		m_sourceCodes[g_stdinFileName] = CharStream(readStandardInput(), g_stdinFileName);
 	if (m_sourceCodes.size() == 0)
 	{
 		serr() << "No input files given. If you wish to use the standard input please specify \"-\" explicitly." << endl;
@@ -671,12 +732,12 @@ bool CommandLineInterface::parseLibraryOption(string const& _input)
 map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 {
 	map<string, Json::Value> sourceJsons;
-	map<string, string> tmpSources;
+	map<string, CharStream> tmpSources;
 
 	for (auto const& srcPair: m_sourceCodes)
 	{
 		Json::Value ast;
-		astAssert(jsonParseStrict(srcPair.second, ast), "Input file could not be parsed to JSON");
+		astAssert(jsonParseStrict(string(srcPair.second.source()), ast), "Input file could not be parsed to JSON");
 		astAssert(ast.isMember("sources"), "Invalid Format for import-JSON: Must have 'sources'-object");
 
 		for (auto& src: ast["sources"].getMemberNames())
@@ -687,7 +748,7 @@ map<string, Json::Value> CommandLineInterface::parseAstFromInput()
 			astAssert(ast["sources"][src][astKey]["nodeType"].asString() == "SourceUnit",  "Top-level node should be a 'SourceUnit'");
 			astAssert(sourceJsons.count(src) == 0, "All sources must have unique names");
 			sourceJsons.emplace(src, move(ast["sources"][src][astKey]));
-			tmpSources[src] = util::jsonCompactPrint(ast);
+			tmpSources[src] = CharStream(util::jsonCompactPrint(ast), src);
 		}
 	}
 
@@ -796,6 +857,32 @@ General Information)").c_str(),
 			po::value<string>()->value_name(boost::join(g_revertStringsArgs, ",")),
 			"Strip revert (and require) reason strings or add additional debugging information."
 		)
+		(
+			g_argJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Compile up to n contracts or Yul objects concurrently. The output does not depend on this setting."
+		)
+		(
+			g_argCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			"Reuse the bytecode of contracts compiled before with the same sources and settings. "
+			"The compiled contracts and the answers of the SMT solvers are stored in the given directory."
+		)
+		(
+			g_argTraceOut.c_str(),
+			po::value<string>()->value_name("path"),
+			"Write the time and peak memory taken by the phases of the compiler to the given file "
+			"in the Chrome trace event format."
+		)
+		(
+			g_argTraceSummary.c_str(),
+			"Print a table of the time and peak memory taken by the phases of the compiler to stderr."
+		)
+		(
+			g_argWatch.c_str(),
+			"Compile again and print the output again whenever one of the input files changes, "
+			"until interrupted. Only the changed files and the files importing them are analysed again."
+		)
 	;
 	desc.add(outputOptions);
 
@@ -908,6 +995,7 @@ General Information)").c_str(),
 		(g_argNatspecDev.c_str(), "Natspec developer documentation of all contracts.")
 		(g_argMetadata.c_str(), "Combined Metadata JSON whose Swarm hash is stored on-chain.")
 		(g_argStorageLayout.c_str(), "Slots, offsets and types of the contract's state variables.")
+		(g_argOptimizerProfile.c_str(), "Number of runs, changes, time and AST node counts of each step of the Yul optimizer in JSON format.")
 	;
 	desc.add(outputComponents);
 
@@ -967,6 +1055,32 @@ General Information)").c_str(),
 	;
 	desc.add(optimizerOptions);
 
+	po::options_description modelCheckerOptions("Model Checker Options");
+	modelCheckerOptions.add_options()
+		(
+			g_strModelCheckerJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Check up to n verification targets of a function concurrently. "
+			"The order of the warnings does not depend on this setting."
+		)
+		(
+			g_strModelCheckerPortfolio.c_str(),
+			po::value<string>()->value_name(
+				smtutil::portfolioModeToString(smtutil::PortfolioMode::Verify) + "," +
+				smtutil::portfolioModeToString(smtutil::PortfolioMode::Race)
+			),
+			"Wait for all SMT solvers and report conflicting answers (verify, default) "
+			"or use the first answer and interrupt the other solvers (race)."
+		)
+		(
+			g_strModelCheckerTimeout.c_str(),
+			po::value<unsigned>()->value_name("ms"),
+			"Set a time limit in milliseconds for each SMT query. Queries that reach it are "
+			"reported as unknown (timeout). By default only deterministic resource limits apply."
+		)
+	;
+	desc.add(modelCheckerOptions);
+
 	po::options_description allOptions = desc;
 	allOptions.add_options()(g_argInputFile.c_str(), po::value<vector<string>>(), "input file");
 
@@ -1033,6 +1147,40 @@ General Information)").c_str(),
 		m_revertStrings = *revertStrings;
 	}
 
+	if (m_args.count(g_strModelCheckerPortfolio))
+	{
+		string modeString = m_args[g_strModelCheckerPortfolio].as<string>();
+		std::optional<smtutil::PortfolioMode> mode = smtutil::portfolioModeFromString(modeString);
+		if (!mode)
+		{
+			serr() << "Invalid option for --" << g_strModelCheckerPortfolio << ": " << modeString << endl;
+			return false;
+		}
+		m_modelCheckerSettings.portfolioMode = *mode;
+	}
+
+	if (m_args.count(g_strModelCheckerJobs))
+	{
+		unsigned jobs = m_args[g_strModelCheckerJobs].as<unsigned>();
+		if (jobs == 0)
+		{
+			serr() << "--" << g_strModelCheckerJobs << " has to be at least 1." << endl;
+			return false;
+		}
+		m_modelCheckerSettings.parallelism = jobs;
+	}
+
+	if (m_args.count(g_strModelCheckerTimeout))
+	{
+		unsigned timeout = m_args[g_strModelCheckerTimeout].as<unsigned>();
+		if (timeout == 0)
+		{
+			serr() << "--" << g_strModelCheckerTimeout << " has to be at least 1." << endl;
+			return false;
+		}
+		m_modelCheckerSettings.timeout = timeout;
+	}
+
 	if (m_args.count(g_argCombinedJson))
 	{
 		vector<string> requests;
@@ -1087,9 +1235,12 @@ bool CommandLineInterface::processInput()
 			if (!boost::filesystem::is_regular_file(canonicalPath))
 				return ReadCallback::Result{false, "Not a valid file."};
 
-			auto contents = readFileAsString(canonicalPath.string());
+			// In watch mode, the contents must not change when the file is edited.
+			CharStream contents = m_args.count(g_argWatch) ?
+				CharStream(readFileAsString(canonicalPath.string()), path.generic_string()) :
+				CharStream(make_shared<MappedFile const>(canonicalPath.string()), path.generic_string());
 			m_sourceCodes[path.generic_string()] = contents;
-			return ReadCallback::Result{true, contents};
+			return ReadCallback::Result{true, {}, move(contents)};
 		}
 		catch (Exception const& _exception)
 		{
@@ -1145,6 +1296,20 @@ bool CommandLineInterface::processInput()
 		return false;
 	}
 
+	if (m_args.count(g_argWatch))
+	{
+		if (countEnabledOptions(exclusiveModes) > 0)
+		{
+			serr() << "--" << g_argWatch << " is only supported when compiling Solidity files." << endl;
+			return false;
+		}
+		if (m_args.count(g_argOutputDir) && !m_args.count(g_strOverwrite))
+		{
+			serr() << "--" << g_argWatch << " requires --" << g_strOverwrite << " together with --" << g_argOutputDir << "." << endl;
+			return false;
+		}
+	}
+
 	if (m_args.count(g_argStandardJSON))
 	{
 		vector<string> inputFiles;
@@ -1158,14 +1323,19 @@ bool CommandLineInterface::processInput()
 			serr() << "If --" << g_argStandardJSON << " is used, only zero or one input files are supported." << endl;
 			return false;
 		}
-		string input;
+		StandardCompiler compiler(fileReader);
+		if (m_args.count(g_argCacheDir))
+			compiler.setCacheDirectory(m_args[g_argCacheDir].as<string>());
+		bool success;
 		if (jsonFile.empty())
-			input = readStandardInput();
+			success = compiler.compile(std::cin, sout(), serr(false));
 		else
-			input = readFileAsString(jsonFile);
-		StandardCompiler compiler(fileReader);
-		sout() << compiler.compile(std::move(input)) << endl;
-		return true;
+		{
+			ifstream input(jsonFile, ios::binary);
+			success = compiler.compile(input, sout(), serr(false));
+		}
+		sout() << endl;
+		return success;
 	}
 
 	if (!readInputFilesAndConfigureRemappings())
@@ -1326,6 +1496,11 @@ bool CommandLineInterface::processInput()
 	}
 
 	m_compiler = make_unique<CompilerStack>(fileReader);
+	if (m_args.count(g_argTraceOut) || m_args.count(g_argTraceSummary))
+	{
+		m_profiler = make_unique<util::Profiler>();
+		m_compiler->setProfiler(m_profiler.get());
+	}
 
 	unique_ptr<SourceReferenceFormatter> formatter;
 	if (m_args.count(g_argOldReporter))
@@ -1346,10 +1521,24 @@ bool CommandLineInterface::processInput()
 			m_compiler->setLibraries(m_libraries);
 		m_compiler->setEVMVersion(m_evmVersion);
 		m_compiler->setRevertStringBehaviour(m_revertStrings);
+		m_compiler->setModelCheckerSettings(m_modelCheckerSettings);
+		if (m_args.count(g_argJobs))
+		{
+			unsigned jobs = m_args[g_argJobs].as<unsigned>();
+			if (jobs == 0)
+			{
+				serr() << "--" << g_argJobs << " has to be at least 1." << endl;
+				return false;
+			}
+			m_compiler->setParallelism(jobs);
+		}
+		if (m_args.count(g_argCacheDir))
+			m_compiler->setCacheDirectory(m_args[g_argCacheDir].as<string>());
 		// TODO: Perhaps we should not compile unless requested
 
 		m_compiler->enableIRGeneration(m_args.count(g_argIR) || m_args.count(g_argIROptimized));
 		m_compiler->enableEwasmGeneration(m_args.count(g_argEwasm));
+		m_compiler->enableOptimiserProfile(m_args.count(g_argOptimizerProfile));
 
 		OptimiserSettings settings = m_args.count(g_argOptimize) ? OptimiserSettings::standard() : OptimiserSettings::minimal();
 		settings.expectedExecutionsPerDeployment = m_args[g_argOptimizeRuns].as<unsigned>();
@@ -1399,7 +1588,7 @@ bool CommandLineInterface::processInput()
 		}
 		else
 		{
-			m_compiler->setSources(m_sourceCodes);
+			m_compiler->setSourceStreams(m_sourceCodes);
 			if (m_args.count(g_argErrorRecovery))
 				m_compiler->setParserErrorRecovery(true);
 		}
@@ -1411,6 +1600,7 @@ bool CommandLineInterface::processInput()
 			g_hasOutput = true;
 			formatter->printErrorInformation(*error);
 		}
+		handleTrace();
 
 		if (!successful)
 		{
@@ -1617,6 +1807,61 @@ void CommandLineInterface::handleAst(string const& _argStr)
 	}
 }
 
+void CommandLineInterface::watchInputFiles()
+{
+	if (!m_args.count(g_argWatch) || !m_compiler || m_compiler->state() < CompilerStack::State::ParsingPerformed)
+		return;
+
+	map<string, time_t> modificationTimes;
+	for (auto const& [path, stream]: m_sourceCodes)
+		if (path != g_stdinFileName)
+			modificationTimes[path] = boost::filesystem::last_write_time(path);
+
+	while (true)
+	{
+		this_thread::sleep_for(chrono::milliseconds(200));
+		bool changed = false;
+		for (auto& [path, time]: modificationTimes)
+		{
+			boost::system::error_code error;
+			time_t newTime = boost::filesystem::last_write_time(path, error);
+			if (!error && newTime != time)
+			{
+				time = newTime;
+				changed = true;
+			}
+		}
+		if (!changed)
+			continue;
+
+		try
+		{
+			// Only the input files are read again, imported files are kept as they are.
+			StringMap sources;
+			for (string const& name: m_compiler->sourceNames())
+				sources[name] = string(m_compiler->scanner(name).source());
+			for (auto const& [path, time]: modificationTimes)
+				sources[path] = readFileAsString(path);
+			m_compiler->updateSources(std::move(sources));
+
+			bool successful = m_compiler->compile();
+			unique_ptr<SourceReferenceFormatter> formatter;
+			if (m_args.count(g_argOldReporter))
+				formatter = make_unique<SourceReferenceFormatter>(serr(false));
+			else
+				formatter = make_unique<SourceReferenceFormatterHuman>(serr(false), m_coloredOutput, m_withErrorIds);
+			for (auto const& error: m_compiler->errors())
+				formatter->printErrorInformation(*error);
+			if (successful)
+				outputCompilationResults();
+		}
+		catch (boost::exception const& _exception)
+		{
+			serr() << "Exception during compilation: " << boost::diagnostic_information(_exception) << endl;
+		}
+	}
+}
+
 bool CommandLineInterface::actOnInput()
 {
 	if (m_args.count(g_argStandardJSON) || m_onlyAssemble)
@@ -1650,34 +1895,36 @@ bool CommandLineInterface::link()
 		replacement += "__";
 		librariesReplacements[replacement] = library.second;
 	}
-	for (auto& src: m_sourceCodes)
+	for (auto& [name, stream]: m_sourceCodes)
 	{
-		auto end = src.second.end();
-		for (auto it = src.second.begin(); it != end;)
+		string source(stream.source());
+		auto end = source.end();
+		for (auto it = source.begin(); it != end;)
 		{
 			while (it != end && *it != '_') ++it;
 			if (it == end) break;
 			if (end - it < placeholderSize)
 			{
-				serr() << "Error in binary object file " << src.first << " at position " << (end - src.second.begin()) << endl;
+				serr() << "Error in binary object file " << name << " at position " << (end - source.begin()) << endl;
 				return false;
 			}
 
-			string name(it, it + placeholderSize);
-			if (librariesReplacements.count(name))
+			string placeholder(it, it + placeholderSize);
+			if (librariesReplacements.count(placeholder))
 			{
-				string hexStr(toHex(librariesReplacements.at(name).asBytes()));
+				string hexStr(toHex(librariesReplacements.at(placeholder).asBytes()));
 				copy(hexStr.begin(), hexStr.end(), it);
 			}
 			else
-				serr() << "Reference \"" << name << "\" in file \"" << src.first << "\" still unresolved." << endl;
+				serr() << "Reference \"" << placeholder << "\" in file \"" << name << "\" still unresolved." << endl;
 			it += placeholderSize;
 		}
 		// Remove hints for resolved libraries.
 		for (auto const& library: m_libraries)
-			boost::algorithm::erase_all(src.second, "\n" + libraryPlaceholderHint(library.first));
-		while (!src.second.empty() && *prev(src.second.end()) == '\n')
-			src.second.resize(src.second.size() - 1);
+			boost::algorithm::erase_all(source, "\n" + libraryPlaceholderHint(library.first));
+		while (!source.empty() && *prev(source.end()) == '\n')
+			source.resize(source.size() - 1);
+		stream = CharStream(move(source), name);
 	}
 	return true;
 }
@@ -1686,11 +1933,11 @@ void CommandLineInterface::writeLinkedFiles()
 {
 	for (auto const& src: m_sourceCodes)
 		if (src.first == g_stdinFileName)
-			sout() << src.second << endl;
+			sout() << src.second.source() << endl;
 		else
 		{
 			ofstream outFile(src.first);
-			outFile << src.second;
+			outFile << src.second.source();
 			if (!outFile)
 			{
 				serr() << "Could not write to file " << src.first << ". Aborting." << endl;
@@ -1726,6 +1973,17 @@ bool CommandLineInterface::assemble(
 {
 	solAssert(_optimize || !_yulOptimiserSteps.has_value(), "");
 
+	size_t parallelism = 1;
+	if (m_args.count(g_argJobs))
+	{
+		parallelism = m_args[g_argJobs].as<unsigned>();
+		if (parallelism == 0)
+		{
+			serr() << "--" << g_argJobs << " has to be at least 1." << endl;
+			return false;
+		}
+	}
+
 	bool successful = true;
 	map<string, yul::AssemblyStack> assemblyStacks;
 	for (auto const& src: m_sourceCodes)
@@ -1735,9 +1993,11 @@ bool CommandLineInterface::assemble(
 			settings.yulOptimiserSteps = _yulOptimiserSteps.value();
 
 		auto& stack = assemblyStacks[src.first] = yul::AssemblyStack(m_evmVersion, _language, settings);
+		stack.setParallelism(parallelism);
+		stack.enableOptimiserProfile(m_args.count(g_argOptimizerProfile));
 		try
 		{
-			if (!stack.parseAndAnalyze(src.first, src.second))
+			if (!stack.parseAndAnalyze(src.first, string(src.second.source())))
 				successful = false;
 			else
 				stack.optimize();
@@ -1840,6 +2100,12 @@ bool CommandLineInterface::assemble(
 			sout() << object.assembly << endl;
 		else
 			serr() << "No text representation found." << endl;
+
+		if (m_args.count(g_argOptimizerProfile))
+		{
+			sout() << endl << "Optimizer profile:" << endl;
+			sout() << jsonCompactPrint(stack.optimiserProfile().toJson()) << endl;
+		}
 	}
 
 	return true;
@@ -1872,7 +2138,12 @@ void CommandLineInterface::outputCompilationResults()
 			if (m_args.count(g_argAsmJson))
 				ret = jsonPrettyPrint(m_compiler->assemblyJSON(contract));
 			else
-				ret = m_compiler->assemblyString(contract, m_sourceCodes);
+			{
+				StringMap sourceCodes;
+				for (auto const& [name, stream]: m_sourceCodes)
+					sourceCodes[name] = string(stream.source());
+				ret = m_compiler->assemblyString(contract, move(sourceCodes));
+			}
 
 			if (m_args.count(g_argOutputDir))
 			{
@@ -1895,6 +2166,7 @@ void CommandLineInterface::outputCompilationResults()
 		handleMetadata(contract);
 		handleABI(contract);
 		handleStorageLayout(contract);
+		handleOptimiserProfile(contract);
 		handleNatspec(true, contract);
 		handleNatspec(false, contract);
 	} // end of contracts iteration
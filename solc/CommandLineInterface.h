@@ -24,7 +24,9 @@
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/DebugSettings.h>
 #include <libyul/AssemblyStack.h>
+#include <liblangutil/CharStream.h>
 #include <liblangutil/EVMVersion.h>
+#include <libsolutil/Profiler.h>
 
 #include <boost/program_options.hpp>
 #include <boost/filesystem/path.hpp>
@@ -47,6 +49,9 @@ public:
 	/// Perform actions on the input depending on provided compiler arguments
 	/// @returns true on success.
 	bool actOnInput();
+	/// If --watch was given, compiles the input files again after each change and performs the
+	/// above actions again. Only returns if it was not given.
+	void watchInputFiles();
 
 private:
 	bool link();
@@ -80,6 +85,10 @@ private:
 	void handleGasEstimation(std::string const& _contract);
 	void handleFormal();
 	void handleStorageLayout(std::string const& _contract);
+	void handleOptimiserProfile(std::string const& _contract);
+	/// Writes the phases recorded by @a m_profiler to the file given by --trace-out
+	/// and prints their summary if requested.
+	void handleTrace();
 
 	/// Fills @a m_sourceCodes initially and @a m_redirects.
 	bool readInputFilesAndConfigureRemappings();
@@ -114,8 +123,8 @@ private:
 
 	/// Compiler arguments variable map
 	boost::program_options::variables_map m_args;
-	/// map of input files to source code strings
-	std::map<std::string, std::string> m_sourceCodes;
+	/// map of input files to their source code, files are mapped into memory instead of copied
+	std::map<std::string, langutil::CharStream> m_sourceCodes;
 	/// list of remappings
 	std::vector<frontend::CompilerStack::Remapping> m_remappings;
 	/// list of allowed directories to read files from
@@ -126,10 +135,14 @@ private:
 	std::map<std::string, util::h160> m_libraries;
 	/// Solidity compiler stack
 	std::unique_ptr<frontend::CompilerStack> m_compiler;
+	/// Record of the compiler phases, only present if a trace or its summary was requested.
+	std::unique_ptr<util::Profiler> m_profiler;
 	/// EVM version to use
 	langutil::EVMVersion m_evmVersion;
 	/// How to handle revert strings
 	RevertStrings m_revertStrings = RevertStrings::Default;
+	/// Settings of the SMTChecker
+	ModelCheckerSettings m_modelCheckerSettings;
 	/// Chosen hash method for the bytecode metadata.
 	CompilerStack::MetadataHash m_metadataHash = CompilerStack::MetadataHash::IPFS;
 	/// Whether or not to colorize diagnostics output.
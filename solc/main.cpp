@@ -56,12 +56,12 @@ int main(int argc, char** argv)
 	solidity::frontend::CommandLineInterface cli;
 	if (!cli.parseArguments(argc, argv))
 		return 1;
-	if (!cli.processInput())
-		return 1;
-	bool success = false;
+	bool success = cli.processInput();
 	try
 	{
-		success = cli.actOnInput();
+		if (success)
+			success = cli.actOnInput();
+		cli.watchInputFiles();
 	}
 	catch (boost::exception const& _exception)
 	{
@@ -0,0 +1,106 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the character searches of the scanner.
+ */
+
+#include <liblangutil/CharacterSearch.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+
+namespace solidity::langutil::test
+{
+
+namespace
+{
+
+/// Checks that @a _find stops at @a _stop placed at every position of runs of @a _part
+/// of lengths around the block sizes, and at the end if there is no stop.
+template <typename Find>
+void checkRuns(Find _find, char _part, char _stop)
+{
+	for (size_t length = 0; length <= 70; ++length)
+	{
+		string run(length, _part);
+		BOOST_CHECK_EQUAL(_find(run, 0), length);
+		for (size_t start = 0; start <= length; ++start)
+		{
+			string text = run + _stop + run;
+			BOOST_CHECK_EQUAL(_find(text, start), length);
+			BOOST_CHECK_EQUAL(_find(text, length + 1 + start), text.size());
+		}
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(CharacterSearchTest)
+
+BOOST_AUTO_TEST_CASE(whitespace)
+{
+	checkRuns(findEndOfWhitespace, ' ', 'a');
+	checkRuns(findEndOfWhitespace, '\n', '\v');
+	BOOST_CHECK_EQUAL(findEndOfWhitespace(" \t\r\n \t\r\n \t\r\n \t\r\n \t\r\n/", 0), 20);
+	BOOST_CHECK_EQUAL(findEndOfWhitespace(string(40, ' ') + "\xc2\x85", 0), 40);
+	BOOST_CHECK_EQUAL(findEndOfWhitespace("  ", 5), 2);
+}
+
+BOOST_AUTO_TEST_CASE(identifier)
+{
+	checkRuns(findEndOfIdentifier, 'a', ' ');
+	checkRuns(findEndOfIdentifier, '_', '.');
+	string const identifier = "abcdefghijklmnopqrstuvwxyz_ABCDEFGHIJKLMNOPQRSTUVWXYZ$0123456789";
+	for (char stop: string("@[`{/:\x7f\x80\xff"))
+		BOOST_CHECK_EQUAL(findEndOfIdentifier(identifier + stop + identifier, 0), identifier.size());
+}
+
+BOOST_AUTO_TEST_CASE(decimal_digits)
+{
+	checkRuns(findEndOfDecimalDigits, '7', 'e');
+	checkRuns(findEndOfDecimalDigits, '_', '.');
+	string const digits = "0123456789_0123456789_0123456789";
+	for (char stop: string("/:aA\xb0"))
+		BOOST_CHECK_EQUAL(findEndOfDecimalDigits(digits + stop + digits, 0), digits.size());
+}
+
+BOOST_AUTO_TEST_CASE(hex_digits)
+{
+	checkRuns(findEndOfHexDigits, 'f', 'g');
+	checkRuns(findEndOfHexDigits, 'A', ' ');
+	string const digits = "0123456789abcdefABCDEF_0123456789abcdefABCDEF";
+	for (char stop: string("/:gG`@x\xc6"))
+		BOOST_CHECK_EQUAL(findEndOfHexDigits(digits + stop + digits, 0), digits.size());
+}
+
+BOOST_AUTO_TEST_CASE(line_terminator_candidate)
+{
+	checkRuns(findLineTerminatorCandidate, 'a', '\n');
+	checkRuns(findLineTerminatorCandidate, ' ', '\xe2');
+	string const comment = "// any comment \t with \x09 some \xc3\xa4 \x0e characters";
+	for (char stop: string("\n\v\f\r\xc2\xe2"))
+		BOOST_CHECK_EQUAL(findLineTerminatorCandidate(comment + stop + comment, 0), comment.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,91 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the CompactSourceLocation class.
+ */
+
+#include <liblangutil/CompactSourceLocation.h>
+
+#include <test/Common.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+namespace solidity::langutil::test
+{
+
+BOOST_AUTO_TEST_SUITE(CompactSourceLocationTest)
+
+BOOST_AUTO_TEST_CASE(round_trip)
+{
+	auto const sourceA = std::make_shared<CharStream>("lorem ipsum", "sourceA");
+	auto const sourceB = std::make_shared<CharStream>("lorem ipsum", "sourceB");
+
+	BOOST_CHECK(SourceLocation(CompactSourceLocation{}) == SourceLocation{});
+	BOOST_CHECK(!CompactSourceLocation{}.isValid());
+	BOOST_CHECK_EQUAL(CompactSourceLocation{SourceLocation{}}.sourceIndex, 0);
+
+	CompactSourceLocation a{SourceLocation{0, 3, sourceA}};
+	CompactSourceLocation b{SourceLocation{0, 3, sourceB}};
+	BOOST_CHECK(a.isValid());
+	BOOST_CHECK(a != b);
+	BOOST_CHECK(a == CompactSourceLocation(SourceLocation{0, 3, sourceA}));
+	BOOST_CHECK(SourceLocation(a) == (SourceLocation{0, 3, sourceA}));
+	BOOST_CHECK(SourceLocation(b).source == sourceB);
+	BOOST_CHECK_EQUAL(SourceLocation(b).end, 3);
+}
+
+BOOST_AUTO_TEST_CASE(destroyed_stream)
+{
+	auto source = std::make_shared<CharStream>("lorem ipsum", "source");
+	CompactSourceLocation location{SourceLocation{1, 2, source}};
+	BOOST_CHECK(SourceLocation(location).source == source);
+	source.reset();
+
+	SourceLocation converted = location;
+	BOOST_CHECK(!converted.source);
+	BOOST_CHECK_EQUAL(converted.start, 1);
+
+	// A new stream never takes over the index of a destroyed one, even at the same address.
+	auto other = std::make_shared<CharStream>("dolor", "other");
+	BOOST_CHECK(CompactSourceLocation(SourceLocation{1, 2, other}).sourceIndex != location.sourceIndex);
+	BOOST_CHECK(!SourceLocation(location).source);
+}
+
+BOOST_AUTO_TEST_CASE(many_destroyed_streams)
+{
+	auto kept = std::make_shared<CharStream>("lorem ipsum", "kept");
+	CompactSourceLocation keptLocation{SourceLocation{1, 2, kept}};
+	std::vector<CompactSourceLocation> locations;
+	// Enough streams that the destroyed ones are removed from the table in between.
+	for (size_t i = 0; i < 1000; ++i)
+	{
+		auto source = std::make_shared<CharStream>("lorem ipsum", "source" + std::to_string(i));
+		locations.emplace_back(SourceLocation{1, 2, source});
+		BOOST_CHECK(SourceLocation(locations.back()).source == source);
+	}
+	for (CompactSourceLocation const& location: locations)
+		BOOST_CHECK(!SourceLocation(location).source);
+	BOOST_CHECK(SourceLocation(keptLocation).source == kept);
+	BOOST_CHECK_EQUAL(CompactSourceLocation(SourceLocation{1, 2, kept}).sourceIndex, keptLocation.sourceIndex);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
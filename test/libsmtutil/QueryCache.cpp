@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the cache of SMT solver answers.
+ */
+
+#include <libsmtutil/QueryCache.h>
+#include <libsmtutil/SMTLib2Interface.h>
+
+#include <test/yulPhaser/TestHelpers.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::util;
+using namespace solidity::phaser::test;
+
+namespace fs = boost::filesystem;
+
+namespace solidity::smtutil::test
+{
+
+namespace
+{
+
+map<h256, string> const noResponses;
+
+string canonicalQuery(SMTLib2Interface& _solver, vector<Expression> const& _assertions, vector<Expression> const& _expressions)
+{
+	return QueryCache::canonicalQuery(_solver.variables(), _assertions, _expressions);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(QueryCacheTest)
+
+BOOST_AUTO_TEST_CASE(canonical_query_ignores_names_and_unused_declarations)
+{
+	SMTLib2Interface first(noResponses, {});
+	Expression x = first.newVariable("x_12_0", SortProvider::sintSort);
+	Expression y = first.newVariable("y_13_1", SortProvider::sintSort);
+	first.newVariable("unused_14_0", SortProvider::boolSort);
+
+	SMTLib2Interface second(noResponses, {});
+	Expression a = second.newVariable("a_7_3", SortProvider::sintSort);
+	Expression b = second.newVariable("b_8_0", SortProvider::sintSort);
+
+	string query = canonicalQuery(first, {x < y, y < 10}, {x});
+	BOOST_CHECK_EQUAL(query, canonicalQuery(second, {a < b, b < 10}, {a}));
+	BOOST_CHECK(query.find("x_12_0") == string::npos);
+	BOOST_CHECK(query.find("unused") == string::npos);
+
+	// The names are assigned in the order of the first occurrence.
+	BOOST_CHECK(query != canonicalQuery(second, {b < a, a < 10}, {a}));
+	BOOST_CHECK(query != canonicalQuery(first, {x < y, y < 11}, {x}));
+	BOOST_CHECK(query != canonicalQuery(first, {x < y, y < 10}, {y}));
+}
+
+BOOST_AUTO_TEST_CASE(store_and_load)
+{
+	TemporaryDirectory tempDir("solc-query-cache-test-");
+	fs::path directory = tempDir.path();
+	QueryCache cache(directory);
+
+	BOOST_CHECK(!cache.load("sat query"));
+	cache.store("sat query", {CheckResult::SATISFIABLE, {"1", "(- 2)"}});
+	cache.store("unsat query", {CheckResult::UNSATISFIABLE, {}});
+	cache.store("unknown query", {CheckResult::UNKNOWN, {}});
+	cache.store("timeout query", {CheckResult::TIMEOUT, {}});
+
+	auto sat = QueryCache(directory).load("sat query");
+	BOOST_REQUIRE(sat);
+	BOOST_CHECK(sat->first == CheckResult::SATISFIABLE);
+	BOOST_CHECK(sat->second == (vector<string>{"1", "(- 2)"}));
+	auto unsat = cache.load("unsat query");
+	BOOST_REQUIRE(unsat);
+	BOOST_CHECK(unsat->first == CheckResult::UNSATISFIABLE);
+	BOOST_CHECK(!cache.load("unknown query"));
+	BOOST_CHECK(!cache.load("timeout query"));
+
+	// Corrupt entries are ignored.
+	for (auto const& entry: fs::directory_iterator(directory))
+		fs::ofstream(entry.path()) << "{\"result\": \"sat\"";
+	BOOST_CHECK(!cache.load("sat query"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,171 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Tests for the incremental analysis of changed sources.
+ */
+
+#include <test/Common.h>
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <liblangutil/Exceptions.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+using namespace std;
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+namespace solidity::frontend::test
+{
+
+namespace
+{
+
+StringMap const baseSources{
+	{"lib.sol", "pragma solidity >=0.0; library L { function f(uint x) internal pure returns (uint) { return x + 1; } function k() internal view returns (uint) { return 1; } }"},
+	{"base.sol", "pragma solidity >=0.0; import \"lib.sol\"; contract B { modifier m() { _; } function g() public pure virtual returns (uint) { return L.f(1); } }"},
+	{"a.sol", "pragma solidity >=0.0; import \"base.sol\"; contract A is B { function g() public pure override m returns (uint) { return 2; } }"},
+	{"c.sol", "pragma solidity >=0.0; import \"lib.sol\"; contract C { function h() public { uint x; } }"}
+};
+
+void configure(CompilerStack& _compiler)
+{
+	_compiler.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	_compiler.setOptimiserSettings(true);
+}
+
+map<string, string> bytecodeOf(CompilerStack const& _compiler)
+{
+	map<string, string> bytecode;
+	if (_compiler.compilationSuccessful())
+		for (string const& name: _compiler.contractNames())
+			bytecode[name] = _compiler.object(name).toHex();
+	return bytecode;
+}
+
+/// @returns the source names and the messages of all errors in the order in which they were reported.
+vector<string> errorMessages(CompilerStack const& _compiler)
+{
+	vector<string> errors;
+	for (auto const& error: _compiler.errors())
+	{
+		SourceLocation const* location = boost::get_error_info<errinfo_sourceLocation>(*error);
+		errors.push_back(
+			(location && location->source ? location->source->name() + ": " : "") +
+			*boost::get_error_info<errinfo_comment>(*error)
+		);
+	}
+	return errors;
+}
+
+/// @returns the bytecode of all contracts and the messages of all errors of a fresh compilation.
+pair<map<string, string>, vector<string>> compileFromScratch(StringMap const& _sources)
+{
+	CompilerStack compiler;
+	configure(compiler);
+	compiler.setSources(_sources);
+	if (compiler.parseAndAnalyze())
+		compiler.compile();
+	return {bytecodeOf(compiler), errorMessages(compiler)};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(IncrementalAnalysis)
+
+BOOST_AUTO_TEST_CASE(only_changed_sources_and_their_importers_are_analysed)
+{
+	StringMap changedSources = baseSources;
+	changedSources["base.sol"] = "pragma solidity >=0.0; import \"lib.sol\"; contract B { modifier m() { _; } function g() public pure virtual returns (uint) { return L.f(2); } }";
+	auto [expectedBytecode, expectedErrors] = compileFromScratch(changedSources);
+
+	CompilerStack compiler;
+	configure(compiler);
+	compiler.setSources(baseSources);
+	BOOST_REQUIRE(compiler.compile());
+	SourceUnit const* lib = &compiler.ast("lib.sol");
+	SourceUnit const* base = &compiler.ast("base.sol");
+	SourceUnit const* a = &compiler.ast("a.sol");
+	SourceUnit const* c = &compiler.ast("c.sol");
+
+	compiler.updateSources(changedSources);
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_CHECK(&compiler.ast("lib.sol") == lib);
+	BOOST_CHECK(&compiler.ast("c.sol") == c);
+	BOOST_CHECK(&compiler.ast("base.sol") != base);
+	BOOST_CHECK(&compiler.ast("a.sol") != a);
+	BOOST_CHECK(bytecodeOf(compiler) == expectedBytecode);
+	// The warnings of lib.sol and c.sol are kept, in the same order as in a fresh compilation.
+	BOOST_CHECK(errorMessages(compiler) == expectedErrors);
+}
+
+BOOST_AUTO_TEST_CASE(added_and_removed_sources)
+{
+	StringMap changedSources = baseSources;
+	changedSources.erase("lib.sol");
+	changedSources["d.sol"] = "pragma solidity >=0.0; contract D { function f() public pure returns (uint) { return 4; } }";
+	auto expectedErrors = compileFromScratch(changedSources).second;
+	BOOST_REQUIRE(!expectedErrors.empty());
+
+	CompilerStack compiler;
+	configure(compiler);
+	compiler.setSources(baseSources);
+	BOOST_REQUIRE(compiler.compile());
+
+	// Importers of the removed source are parsed again, which fails without an import callback.
+	compiler.updateSources(changedSources);
+	BOOST_CHECK(!compiler.parseAndAnalyze());
+	BOOST_CHECK(errorMessages(compiler) == expectedErrors);
+
+	// The failed analysis is not reused.
+	compiler.updateSources(baseSources);
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_CHECK(compiler.contractNames() == (vector<string>{"a.sol:A", "base.sol:B", "c.sol:C", "lib.sol:L"}));
+}
+
+BOOST_AUTO_TEST_CASE(errors_in_changed_sources)
+{
+	StringMap brokenSources = baseSources;
+	brokenSources["a.sol"] = "pragma solidity >=0.0; import \"base.sol\"; contract A is B { function g() public pure override returns (uint) { return x; } }";
+
+	CompilerStack compiler;
+	configure(compiler);
+	compiler.setSources(baseSources);
+	BOOST_REQUIRE(compiler.compile());
+	SourceUnit const* lib = &compiler.ast("lib.sol");
+
+	compiler.updateSources(brokenSources);
+	BOOST_CHECK(!compiler.parseAndAnalyze());
+	BOOST_CHECK(&compiler.ast("lib.sol") == lib);
+	bool undeclaredIdentifier = false;
+	for (auto const& error: compiler.errors())
+		if (error->type() == Error::Type::DeclarationError)
+			undeclaredIdentifier = true;
+	BOOST_CHECK(undeclaredIdentifier);
+
+	compiler.updateSources(baseSources);
+	BOOST_REQUIRE(compiler.compile());
+	BOOST_CHECK(!compiler.object("a.sol:A").bytecode.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
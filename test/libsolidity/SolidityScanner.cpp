@@ -660,6 +660,41 @@ BOOST_AUTO_TEST_CASE(irregular_line_breaks_in_strings)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(long_tokens)
+{
+	string const identifier = "_" + string(70, 'a') + "$Z9";
+	string const number = string(40, '1') + "_" + string(40, '2');
+	string const hexNumber = "0x" + string(40, 'a') + "_" + string(40, 'F');
+	string const whitespace = string(50, ' ') + "\t\r\n";
+	string const comment = "// " + string(50, '*') + "\xE2\x80 /* */ \xC2 " + string(50, 'c') + "\n";
+	string const multilineComment = "/*" + string(50, ' ') + "\n*" + string(50, '/') + " ** / */";
+	Scanner scanner(CharStream(
+		identifier + whitespace + comment + number + multilineComment + whitespace + hexNumber + whitespace + identifier,
+		""
+	));
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Number);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), number);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Number);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), hexNumber);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), identifier);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
+BOOST_AUTO_TEST_CASE(period_in_identifier)
+{
+	Scanner scanner(CharStream("abc.def.ghi + abc.def", ""));
+	scanner.supportPeriodInIdentifier(true);
+	BOOST_CHECK_EQUAL(scanner.currentToken(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "abc.def.ghi");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Add);
+	BOOST_CHECK_EQUAL(scanner.next(), Token::Identifier);
+	BOOST_CHECK_EQUAL(scanner.currentLiteral(), "abc.def");
+	BOOST_CHECK_EQUAL(scanner.next(), Token::EOS);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
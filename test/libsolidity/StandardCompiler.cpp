@@ -21,14 +21,17 @@
 
 #include <string>
 #include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
 #include <libsolidity/interface/OptimiserSettings.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
 #include <test/Metadata.h>
+#include <test/yulPhaser/TestHelpers.h>
 
 #include <set>
+#include <sstream>
 
 using namespace std;
 using namespace solidity::evmasm;
@@ -93,6 +96,18 @@ Json::Value compile(string _input)
 	return ret;
 }
 
+/// @returns the output of the streaming interface for @a _input.
+string compileStreamed(string const& _input, ReadCallback::Callback const& _readFile = {})
+{
+	StandardCompiler compiler(_readFile);
+	istringstream input(_input);
+	ostringstream output;
+	ostringstream errorOutput;
+	BOOST_REQUIRE(compiler.compile(input, output, errorOutput));
+	BOOST_CHECK_EQUAL(errorOutput.str(), "");
+	return output.str();
+}
+
 } // end anonymous namespace
 
 BOOST_AUTO_TEST_SUITE(StandardCompiler)
@@ -1245,6 +1260,302 @@ BOOST_AUTO_TEST_CASE(use_stack_optimization)
 	BOOST_CHECK(result["errors"][0]["type"] == "YulException");
 }
 
+BOOST_AUTO_TEST_CASE(parallelism)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": [ "evm.bytecode", "evm.deployedBytecode", "evm.assembly", "metadata" ] }
+			}
+		},
+		"sources": {
+			"fileA": { "content": "contract A { uint x; function f() public { x = 1; } }" },
+			"fileB": { "content": "import \"fileA\"; contract B { function f() public returns (A) { return new A(); } }" },
+			"fileC": { "content": "import \"fileA\"; contract C { function f() public returns (A) { return new A(); } }" },
+			"fileD": { "content": "import \"fileB\"; import \"fileC\"; contract D { B b = new B(); C c = new C(); }" },
+			"fileE": { "content": "library L { function f() public pure returns (uint) { return 7; } } contract E { function g() public pure returns (uint) { return L.f(); } }" }
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value sequentialResult = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(sequentialResult));
+	BOOST_REQUIRE(getContractResult(sequentialResult, "fileD", "D").isObject());
+
+	for (unsigned parallelism: {2, 4, 16})
+	{
+		parsedInput["settings"]["parallelism"] = parallelism;
+		Json::Value parallelResult = compiler.compile(parsedInput);
+		BOOST_CHECK(parallelResult == sequentialResult);
+	}
+
+	parsedInput["settings"]["parallelism"] = 0;
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.parallelism\" must be a positive integer."));
+}
+
+BOOST_AUTO_TEST_CASE(yul_parallelism)
+{
+	char const* input = R"(
+	{
+		"language": "Yul",
+		"settings": {
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": [ "evm.bytecode", "evm.deployedBytecode", "evm.assembly", "irOptimized" ] }
+			}
+		},
+		"sources": {
+			"A": { "content": "object \"A\" { code { datacopy(0, dataoffset(\"B\"), datasize(\"B\")) return(0, datasize(\"B\")) } object \"B\" { code { let x := add(calldataload(0), 1) sstore(0, mul(x, x)) datacopy(0, dataoffset(\"C\"), datasize(\"C\")) pop(create(0, 0, datasize(\"C\"))) } object \"C\" { code { function f(a) -> b { b := add(a, a) } sstore(1, f(calldataload(4))) } } } object \"D\" { code { mstore(0, sub(caller(), 2)) return(0, 32) } } }" }
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value sequentialResult = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(sequentialResult));
+	BOOST_REQUIRE(getContractResult(sequentialResult, "A", "A").isObject());
+
+	for (unsigned parallelism: {2, 4})
+	{
+		parsedInput["settings"]["parallelism"] = parallelism;
+		Json::Value parallelResult = compiler.compile(parsedInput);
+		BOOST_CHECK(parallelResult == sequentialResult);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Yul",
+		"settings": {
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": [ "*" ] }
+			}
+		},
+		"sources": {
+			"A": { "content": "{ function f(a) -> b { b := add(a, a) } sstore(0, f(calldataload(0))) }" }
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value contract = getContractResult(result, "A", "object");
+	BOOST_REQUIRE(contract.isObject());
+	BOOST_CHECK(!contract["evm"].isMember("optimizerProfile"));
+
+	parsedInput["settings"]["outputSelection"]["*"]["*"] = Json::arrayValue;
+	parsedInput["settings"]["outputSelection"]["*"]["*"].append("evm.optimizerProfile");
+	result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	Json::Value profile = getContractResult(result, "A", "object")["evm"]["optimizerProfile"];
+	BOOST_REQUIRE(profile.isObject());
+	// The expression simplifier is part of the default sequence.
+	BOOST_REQUIRE(profile.isMember("s"));
+	BOOST_CHECK_EQUAL(profile["s"]["name"].asString(), "ExpressionSimplifier");
+	BOOST_CHECK(profile["s"]["runs"].asUInt() > 0);
+	BOOST_CHECK(profile["s"]["changes"].asUInt() <= profile["s"]["runs"].asUInt());
+}
+
+BOOST_AUTO_TEST_CASE(cache_directory)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"*": { "*": [ "evm.bytecode", "evm.deployedBytecode", "evm.assembly", "evm.gasEstimates", "metadata" ] }
+			}
+		},
+		"sources": {
+			"fileA": { "content": "contract A { uint x; function f() public { x = 1; } }" },
+			"fileB": { "content": "import \"fileA\"; contract B { function f() public returns (A) { return new A(); } }" },
+			"fileC": { "content": "library L { function f() public pure returns (uint) { return 7; } } contract C { function g() public pure returns (uint) { return L.f(); } }" }
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value uncachedResult = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(uncachedResult));
+	BOOST_REQUIRE(getContractResult(uncachedResult, "fileB", "B").isObject());
+
+	phaser::test::TemporaryDirectory cacheDirectory("solc-cache-test-");
+	compiler.setCacheDirectory(cacheDirectory.path());
+	// The first run fills the cache, the second one uses it.
+	BOOST_CHECK(compiler.compile(parsedInput) == uncachedResult);
+	BOOST_CHECK(!boost::filesystem::is_empty(cacheDirectory.path()));
+	BOOST_CHECK(compiler.compile(parsedInput) == uncachedResult);
+
+	// Contracts depending on a changed source must not be restored from the cache.
+	parsedInput["sources"]["fileA"]["content"] = "contract A { uint x; function f() public { x = 2; } }";
+	uncachedResult = solidity::frontend::StandardCompiler().compile(parsedInput);
+	BOOST_CHECK(compiler.compile(parsedInput) == uncachedResult);
+
+	// The input must not choose where the compiler writes.
+	parsedInput["settings"]["cacheDirectory"] = cacheDirectory.path();
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsError(result, "JSONError", "Unknown key \"cacheDirectory\""));
+}
+
+BOOST_AUTO_TEST_CASE(incremental_compilation)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"outputSelection": {
+				"*": { "*": [ "evm.bytecode.object", "metadata" ] }
+			}
+		},
+		"sources": {
+			"fileA": { "content": "contract A { uint x; function f() public { x = 1; } }" },
+			"fileB": { "content": "import \"fileA\"; contract B { function f() public returns (A) { return new A(); } }" },
+			"fileC": { "content": "contract C { function g() public returns (uint) { uint y; return 7; } }" }
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	// Only one compiler stack can exist at a time, so the results of fresh compilations
+	// have to be computed before the incremental compiler keeps its stack.
+	vector<Json::Value> inputs{parsedInput};
+	// Only fileA and fileB are analysed again, the warnings of fileC are kept.
+	inputs.push_back(inputs.back());
+	inputs.back()["sources"]["fileA"]["content"] = "contract A { uint x; function f() public { x = 2; } }";
+	// A change of the settings compiles everything again.
+	inputs.push_back(inputs.back());
+	inputs.back()["settings"]["optimizer"]["enabled"] = true;
+	vector<Json::Value> expectations;
+	for (Json::Value const& input: inputs)
+		expectations.push_back(solidity::frontend::StandardCompiler().compile(input));
+
+	solidity::frontend::StandardCompiler compiler;
+	compiler.enableIncrementalCompilation();
+	for (size_t i = 0; i < inputs.size(); ++i)
+	{
+		Json::Value result = compiler.compile(inputs[i]);
+		BOOST_CHECK(containsAtMostWarnings(result));
+		BOOST_CHECK(result == expectations[i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_portfolio)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"modelChecker": { "portfolio": "race" }
+		},
+		"sources": {
+			"fileA": { "content": "pragma experimental SMTChecker; contract A { function f(uint x) public pure { assert(x > 0); } }" }
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	BOOST_CHECK(containsAtMostWarnings(compiler.compile(parsedInput)));
+
+	parsedInput["settings"]["modelChecker"]["portfolio"] = "fastest";
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsError(result, "JSONError", "Invalid value for settings.modelChecker.portfolio."));
+
+	parsedInput["settings"]["modelChecker"]["portfolio"] = 1;
+	result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsError(result, "JSONError", "settings.modelChecker.portfolio must be a string."));
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_timeout)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"modelChecker": { "timeout": 1000 }
+		},
+		"sources": {
+			"fileA": { "content": "pragma experimental SMTChecker; contract A { function f(uint x) public pure { assert(x > 0); } }" }
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	solidity::frontend::StandardCompiler compiler;
+	BOOST_CHECK(containsAtMostWarnings(compiler.compile(parsedInput)));
+
+	for (Json::Value timeout: {Json::Value(0), Json::Value(-1), Json::Value("1000")})
+	{
+		parsedInput["settings"]["modelChecker"]["timeout"] = timeout;
+		Json::Value result = compiler.compile(parsedInput);
+		BOOST_CHECK(containsError(result, "JSONError", "settings.modelChecker.timeout must be a positive integer."));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(model_checker_parallelism)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"settings": {
+			"modelChecker": { "parallelism": 4 }
+		},
+		"sources": {
+			"fileA": { "content": "pragma experimental SMTChecker; contract A { function f(uint x, uint y) public pure returns (uint) { assert(x > 0); return x / y + x * y; } }" }
+		}
+	}
+	)";
+
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	// The counterexamples depend on the state of the solver, which is only shared by the
+	// queries if they are checked on one thread.
+	auto reportedErrors = [](Json::Value const& _result) {
+		vector<pair<string, Json::Value>> errors;
+		for (Json::Value const& error: _result["errors"])
+			errors.emplace_back(error["errorCode"].asString(), error["sourceLocation"]);
+		return errors;
+	};
+
+	solidity::frontend::StandardCompiler compiler;
+	Json::Value parallelResult = compiler.compile(parsedInput);
+	BOOST_CHECK(containsAtMostWarnings(parallelResult));
+	parsedInput["settings"]["modelChecker"]["parallelism"] = 1;
+	BOOST_CHECK(reportedErrors(compiler.compile(parsedInput)) == reportedErrors(parallelResult));
+
+	parsedInput["settings"]["modelChecker"]["parallelism"] = 0;
+	Json::Value result = compiler.compile(parsedInput);
+	BOOST_CHECK(containsError(result, "JSONError", "settings.modelChecker.parallelism must be a positive integer."));
+}
+
 BOOST_AUTO_TEST_CASE(standard_output_selection_wildcard)
 {
 	char const* input = R"(
@@ -1411,6 +1722,69 @@ BOOST_AUTO_TEST_CASE(standard_output_selection_wildcard_multiple_sources)
 	BOOST_REQUIRE(result["sources"]["B"].isObject());
 }
 
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	// The contracts of "a.sol" come before those of "a.sol2", although "a.sol2:D" < "a.sol:C".
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{
+			"a.sol2": { "content": "pragma solidity >=0.0; import \"a.sol\"; contract D is C { function g() public { uint x; } }" },
+			"a.sol": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} } contract B {}" }
+		},
+		"settings":
+		{
+			"outputSelection": { "*": { "*": ["abi", "evm.bytecode", "evm.methodIdentifiers"], "": ["ast"] } }
+		}
+	}
+	)";
+	BOOST_CHECK_EQUAL(compileStreamed(input), frontend::StandardCompiler().compile(input));
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsAtMostWarnings(result));
+	BOOST_CHECK(result["errors"].isArray());
+	BOOST_CHECK(result["contracts"]["a.sol"]["B"].isObject());
+	BOOST_CHECK(result["contracts"]["a.sol2"]["D"]["evm"]["bytecode"].isObject());
+	BOOST_CHECK(result["sources"]["a.sol2"]["ast"].isObject());
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output_errors)
+{
+	vector<string> inputs{
+		"",
+		"[]",
+		" 1",
+		"{\"language\": \"Solidity\"} ,",
+		"{\"language\": \"Solidity\", \"sources\": {\"a\": {\"content\": tru}}}",
+		"{\"language\": \"Solidity\", \"sources\": {}, \"x\": 1} x",
+		"{\"language\": \"Solidity\", \"language\": \"Solidity\"}",
+		"{\"language\": \"Solidity\", \"sources\": {\"a\": {\"content\": \"\"}}, \"x\": 1}",
+		"{\"language\": \"Solidity\", \"sources\": {\"b\": {}, \"a\": {\"urls\": [\"x\"]}}}",
+		"{\"language\": \"Solidity\", \"sources\": []}",
+		"{\"language\": \"Solidity\", \"sources\": {}}",
+		"{\"language\": \"Vyper\", \"sources\": {\"a\": {\"content\": \"\"}}}",
+		"{\"language\": \"Solidity\", \"sources\": {\"a\": {\"content\": \"contract C { uint x = y; }\"}}}"
+	};
+	for (string const& input: inputs)
+		BOOST_CHECK_EQUAL(compileStreamed(input), frontend::StandardCompiler().compile(input));
+}
+
+BOOST_AUTO_TEST_CASE(streamed_input_reads_urls_after_validation)
+{
+	size_t reads = 0;
+	ReadCallback::Callback readFile = [&](string const&, string const&) {
+		++reads;
+		return ReadCallback::Result{true, "contract C {}"};
+	};
+	string const invalid = "{\"sources\": {\"a\": {\"urls\": [\"x\"]}}, \"language\": \"Solidity\", \"x\": 1}";
+	BOOST_CHECK_EQUAL(compileStreamed(invalid, readFile), frontend::StandardCompiler(readFile).compile(invalid));
+	BOOST_CHECK_EQUAL(reads, 0);
+
+	string const valid = "{\"sources\": {\"a\": {\"urls\": [\"x\"]}}, \"language\": \"Solidity\"}";
+	BOOST_CHECK_EQUAL(compileStreamed(valid, readFile), frontend::StandardCompiler(readFile).compile(valid));
+	BOOST_CHECK_EQUAL(reads, 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -0,0 +1,98 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the copy-on-write value wrapper.
+ */
+
+#include <libsolutil/CopyOnWrite.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <map>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(CopyOnWriteTest)
+
+BOOST_AUTO_TEST_CASE(copies_share_the_value)
+{
+	CopyOnWrite<vector<int>> original(vector<int>{1, 2, 3});
+	CopyOnWrite<vector<int>> copy = original;
+	BOOST_CHECK(copy.sharesValueWith(original));
+	BOOST_CHECK(&*copy == &*original);
+	BOOST_CHECK(*copy == (vector<int>{1, 2, 3}));
+}
+
+BOOST_AUTO_TEST_CASE(write_detaches_the_copy)
+{
+	CopyOnWrite<vector<int>> original(vector<int>{1, 2, 3});
+	CopyOnWrite<vector<int>> copy = original;
+	copy.write().push_back(4);
+	BOOST_CHECK(!copy.sharesValueWith(original));
+	BOOST_CHECK(*original == (vector<int>{1, 2, 3}));
+	BOOST_CHECK(*copy == (vector<int>{1, 2, 3, 4}));
+
+	// The original is not shared anymore and is modified in place.
+	vector<int> const* value = &*original;
+	original.write().push_back(5);
+	BOOST_CHECK(&*original == value);
+	BOOST_CHECK(*original == (vector<int>{1, 2, 3, 5}));
+	BOOST_CHECK(*copy == (vector<int>{1, 2, 3, 4}));
+}
+
+BOOST_AUTO_TEST_CASE(write_after_the_copies_are_destroyed)
+{
+	CopyOnWrite<map<int, int>> original;
+	original.write()[1] = 1;
+	map<int, int> const* value = &*original;
+	{
+		CopyOnWrite<map<int, int>> copy = original;
+		BOOST_CHECK(copy->at(1) == 1);
+	}
+	original.write()[2] = 2;
+	BOOST_CHECK(&*original == value);
+	BOOST_CHECK(original->size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE(copies_in_other_threads)
+{
+	CopyOnWrite<vector<int>> original(vector<int>(100, 1));
+	// Boost.Test assertions must not be used in other threads.
+	vector<char> correct(4, false);
+	vector<thread> threads;
+	for (int i = 0; i < 4; ++i)
+		threads.emplace_back([copy = original, i, &correct]() mutable {
+			for (int& element: copy.write())
+				element = i;
+			correct[size_t(i)] = *copy == vector<int>(100, i);
+		});
+	for (auto& thread: threads)
+		thread.join();
+	BOOST_CHECK(correct == vector<char>(4, true));
+	BOOST_CHECK(*original == vector<int>(100, 1));
+	original.write()[0] = 2;
+	BOOST_CHECK((*original)[0] == 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the mapped files.
+ */
+
+#include <libsolutil/MappedFile.h>
+
+#include <test/Common.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <fstream>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+/// Temporary file that is removed at the end of the scope.
+struct TemporaryFile
+{
+	explicit TemporaryFile(string const& _contents):
+		path(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("solidity-%%%%-%%%%"))
+	{
+		ofstream(path.string(), ios::binary) << _contents;
+	}
+	~TemporaryFile() { boost::filesystem::remove(path); }
+
+	boost::filesystem::path path;
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(MappedFileTest)
+
+BOOST_AUTO_TEST_CASE(contents)
+{
+	string large(MappedFile::c_minimumMappedSize + 1, 'a');
+	large.back() = 'b';
+	TemporaryFile largeFile(large);
+	MappedFile mapped(largeFile.path.string());
+#if !defined(_WIN32)
+	BOOST_CHECK(mapped.mapped());
+#endif
+	BOOST_CHECK_EQUAL(mapped.contents(), large);
+	BOOST_CHECK_EQUAL(mapped.contents().data()[large.size()], 0);
+
+	TemporaryFile smallFile("contract C {}");
+	MappedFile read(smallFile.path.string());
+	BOOST_CHECK(!read.mapped());
+	BOOST_CHECK_EQUAL(read.contents(), "contract C {}");
+}
+
+BOOST_AUTO_TEST_CASE(missing_file)
+{
+	MappedFile missing((boost::filesystem::temp_directory_path() / "solidity-missing-file").string());
+	BOOST_CHECK(!missing.mapped());
+	BOOST_CHECK(missing.contents().empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
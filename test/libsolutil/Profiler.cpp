@@ -0,0 +1,107 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the recording of compiler phases.
+ */
+
+#include <libsolutil/Profiler.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ProfilerTest)
+
+BOOST_AUTO_TEST_CASE(no_profiler)
+{
+	ScopedTimer timer(nullptr, "a");
+	timer.next("b");
+}
+
+BOOST_AUTO_TEST_CASE(records_phases)
+{
+	Profiler profiler;
+	{
+		ScopedTimer timer(&profiler, "a", "x");
+		timer.next("b");
+		{
+			ScopedTimer inner(&profiler, "c");
+		}
+	}
+	ScopedTimer(&profiler, "a", "y");
+
+	vector<Profiler::Phase> phases = profiler.phases();
+	BOOST_REQUIRE_EQUAL(phases.size(), 4);
+	BOOST_CHECK_EQUAL(phases[0].name, "a");
+	BOOST_CHECK_EQUAL(phases[0].detail, "x");
+	// Phases are recorded when they end.
+	BOOST_CHECK_EQUAL(phases[1].name, "c");
+	BOOST_CHECK_EQUAL(phases[2].name, "b");
+	BOOST_CHECK_EQUAL(phases[3].detail, "y");
+	BOOST_CHECK(phases[0].start + phases[0].duration <= phases[2].start);
+	BOOST_CHECK(phases[2].start <= phases[1].start);
+	for (auto const& phase: phases)
+	{
+		BOOST_CHECK_EQUAL(phase.thread, 0);
+		BOOST_CHECK(phase.peakMemoryBefore <= phase.peakMemoryAfter);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(chrome_trace)
+{
+	Profiler profiler;
+	ScopedTimer(&profiler, "a", "x");
+	profiler.count("n", 2);
+	profiler.count("n");
+
+	Json::Value trace = profiler.chromeTrace();
+	BOOST_REQUIRE(trace["traceEvents"].isArray());
+	BOOST_REQUIRE_EQUAL(trace["traceEvents"].size(), 2);
+	Json::Value const& phase = trace["traceEvents"][0];
+	BOOST_CHECK_EQUAL(phase["name"].asString(), "a");
+	BOOST_CHECK_EQUAL(phase["ph"].asString(), "X");
+	BOOST_CHECK_EQUAL(phase["args"]["detail"].asString(), "x");
+	Json::Value const& counter = trace["traceEvents"][1];
+	BOOST_CHECK_EQUAL(counter["ph"].asString(), "C");
+	BOOST_CHECK_EQUAL(counter["args"]["n"].asUInt64(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(summary)
+{
+	Profiler profiler;
+	ScopedTimer(&profiler, "first");
+	ScopedTimer(&profiler, "second");
+	ScopedTimer(&profiler, "first");
+	profiler.count("counter");
+
+	string summary = profiler.summary();
+	size_t first = summary.find("first");
+	size_t second = summary.find("second");
+	BOOST_REQUIRE(first != string::npos);
+	BOOST_REQUIRE(second != string::npos);
+	BOOST_CHECK(first < second);
+	// Phases of the same name are combined into one line.
+	BOOST_CHECK_EQUAL(summary.find("first", first + 1), string::npos);
+	BOOST_CHECK(summary.find("counter") != string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
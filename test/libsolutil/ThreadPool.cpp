@@ -0,0 +1,102 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the thread pool.
+ */
+
+#include <libsolutil/ThreadPool.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ThreadPoolTest)
+
+BOOST_AUTO_TEST_CASE(runs_all_tasks)
+{
+	atomic<size_t> counter{0};
+	ThreadPool pool(4);
+	for (size_t i = 0; i < 100; ++i)
+		pool.post([&] { ++counter; });
+	pool.wait();
+	BOOST_CHECK_EQUAL(counter, 100);
+}
+
+BOOST_AUTO_TEST_CASE(tasks_posting_tasks)
+{
+	atomic<size_t> counter{0};
+	ThreadPool pool(3);
+	function<void(size_t)> spawn = [&](size_t _depth)
+	{
+		++counter;
+		if (_depth > 0)
+			for (size_t i = 0; i < 2; ++i)
+				pool.post([&, _depth] { spawn(_depth - 1); });
+	};
+	pool.post([&] { spawn(5); });
+	pool.wait();
+	BOOST_CHECK_EQUAL(counter, 63);
+}
+
+BOOST_AUTO_TEST_CASE(rethrows_first_exception)
+{
+	atomic<size_t> counter{0};
+	ThreadPool pool(1);
+	pool.post([&] { ++counter; });
+	pool.post([] { throw runtime_error("first"); });
+	pool.post([] { throw runtime_error("second"); });
+	pool.post([&] { ++counter; });
+	BOOST_CHECK_EXCEPTION(pool.wait(), runtime_error, [](runtime_error const& _e) {
+		return string(_e.what()) == "first";
+	});
+	BOOST_CHECK_EQUAL(counter, 2);
+
+	// The exception is only reported once.
+	pool.post([&] { ++counter; });
+	pool.wait();
+	BOOST_CHECK_EQUAL(counter, 3);
+}
+
+BOOST_AUTO_TEST_CASE(run_from_tasks)
+{
+	// A single worker thread only finishes if the tasks waiting for their own tasks help to run them.
+	atomic<size_t> counter{0};
+	ThreadPool pool(1);
+	for (size_t i = 0; i < 3; ++i)
+		pool.post([&] {
+			vector<function<void()>> tasks(10, [&] { ++counter; });
+			pool.run(move(tasks));
+			++counter;
+		});
+	pool.wait();
+	BOOST_CHECK_EQUAL(counter, 33);
+
+	vector<function<void()>> tasks{[&] { ++counter; }, [] { throw runtime_error("run"); }, [&] { ++counter; }};
+	BOOST_CHECK_THROW(pool.run(move(tasks)), runtime_error);
+	BOOST_CHECK_EQUAL(counter, 35);
+	pool.wait();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -207,6 +207,38 @@ BOOST_AUTO_TEST_CASE(invalid_param_rendered)
 	BOOST_CHECK_EQUAL(m.render(), templ);
 }
 
+BOOST_AUTO_TEST_CASE(unmatched_elements_are_text)
+{
+	string templ = "<a <#b> <?c> </d> <!e> <> <<f>> <?+> <#> x<";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("f", "F").render(), "<a <#b> <?c> </d> <!e> <> <F> <?+> <#> x<");
+}
+
+BOOST_AUTO_TEST_CASE(nested_conditions)
+{
+	string templ = "<?a>A<?b>B<!b>notB</b><!a>notA<?b>B</b></a>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", true)("b", true).render(), "AB");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", true)("b", false).render(), "AnotB");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", false)("b", true).render(), "notAB");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", false)("b", false).render(), "notA");
+}
+
+BOOST_AUTO_TEST_CASE(condition_in_list)
+{
+	string templ = "<#l><?c><x><!c>-</c>,</l>";
+	vector<map<string, string>> list(2);
+	list[0]["x"] = "1";
+	list[1]["x"] = "2";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", true)("l", list).render(), "1,2,");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("c", false)("l", list).render(), "-,-,");
+}
+
+BOOST_AUTO_TEST_CASE(same_template_different_values)
+{
+	string templ = "<a><?+a>!</+a>";
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "x").render(), "x!");
+	BOOST_CHECK_EQUAL(Whiskers(templ)("a", "").render(), "");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
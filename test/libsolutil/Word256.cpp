@@ -0,0 +1,169 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the fixed-width 256 bit integer, compared against u256.
+ */
+
+#include <libsolutil/Word256.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+namespace
+{
+
+using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 512, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
+
+/// @returns values that exercise the corner cases of carries, signs and division.
+vector<u256> testValues()
+{
+	vector<u256> values{0, 1, 2, 3, 7, 31, 32, 255, 256, u256(-1), u256(-2), u256(1) << 255};
+	for (unsigned bits: {31u, 32u, 33u, 63u, 64u, 65u, 127u, 128u, 129u, 191u, 192u, 193u, 254u})
+	{
+		values.push_back(u256(1) << bits);
+		values.push_back((u256(1) << bits) - 1);
+		values.push_back((u256(1) << bits) + 1);
+		values.push_back(u256(0) - (u256(1) << bits));
+	}
+	mt19937_64 random(1);
+	for (size_t i = 0; i < 40; ++i)
+	{
+		// Random values of random lengths, some of them with runs of zero or one bits.
+		u256 value;
+		for (size_t limb = 0; limb < 4; ++limb)
+			value = (value << 64) | random();
+		unsigned length = unsigned(random() % 257);
+		value = length == 256 ? value : value >> (256 - length);
+		if (i % 5 == 0)
+			value |= (u256(1) << (length / 2)) - 1;
+		values.push_back(value);
+	}
+	return values;
+}
+
+u256 signedDiv(u256 const& _a, u256 const& _b)
+{
+	return _b == 0 ? 0 : s2u(u2s(_a) / u2s(_b));
+}
+
+u256 signedMod(u256 const& _a, u256 const& _b)
+{
+	return _b == 0 ? 0 : s2u(u2s(_a) % u2s(_b));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(Word256Test)
+
+BOOST_AUTO_TEST_CASE(conversion)
+{
+	for (u256 const& value: testValues())
+		BOOST_CHECK_EQUAL(u256(Word256(value)), value);
+	BOOST_CHECK(Word256(-1) == Word256(u256(-1)));
+	BOOST_CHECK(Word256(uint64_t(-1)) == Word256(u256(uint64_t(-1))));
+	BOOST_CHECK_EQUAL(Word256(u256(1) << 200).limb(3), uint64_t(1) << 8);
+	BOOST_CHECK_EQUAL(Word256().bitLength(), 0);
+	BOOST_CHECK_EQUAL(Word256(1).bitLength(), 1);
+	BOOST_CHECK_EQUAL(Word256(u256(-1)).bitLength(), 256);
+	BOOST_CHECK_EQUAL(Word256(u256(1) << 130).bitLength(), 131);
+}
+
+BOOST_AUTO_TEST_CASE(binary_operations)
+{
+	vector<u256> values = testValues();
+	for (u256 const& a: values)
+		for (u256 const& b: values)
+		{
+			Word256 x(a);
+			Word256 y(b);
+			BOOST_CHECK_EQUAL(u256(x + y), a + b);
+			BOOST_CHECK_EQUAL(u256(x - y), a - b);
+			BOOST_CHECK_EQUAL(u256(x * y), a * b);
+			BOOST_CHECK_EQUAL(u256(x / y), b == 0 ? 0 : u256(a / b));
+			BOOST_CHECK_EQUAL(u256(x % y), b == 0 ? 0 : u256(a % b));
+			BOOST_CHECK_EQUAL(u256(x & y), a & b);
+			BOOST_CHECK_EQUAL(u256(x | y), a | b);
+			BOOST_CHECK_EQUAL(u256(x ^ y), a ^ b);
+			BOOST_CHECK_EQUAL(x < y, a < b);
+			BOOST_CHECK_EQUAL(x == y, a == b);
+			BOOST_CHECK_EQUAL(Word256::signedLess(x, y), u2s(a) < u2s(b));
+			BOOST_CHECK_EQUAL(u256(Word256::signedDiv(x, y)), signedDiv(a, b));
+			BOOST_CHECK_EQUAL(u256(Word256::signedMod(x, y)), signedMod(a, b));
+			BOOST_CHECK_EQUAL(u256(Word256::exp(x, y)), exp256(a, b));
+		}
+}
+
+BOOST_AUTO_TEST_CASE(modular_operations)
+{
+	vector<u256> values = testValues();
+	for (u256 const& a: values)
+		for (u256 const& b: values)
+			for (u256 const& m: {u256(0), u256(1), u256(7), u256(-1), u256(1) << 128, (u256(1) << 200) + 12345, b ^ (a >> 3)})
+			{
+				BOOST_CHECK_EQUAL(
+					u256(Word256::addMod(Word256(a), Word256(b), Word256(m))),
+					m == 0 ? 0 : u256((u512(a) + u512(b)) % m)
+				);
+				BOOST_CHECK_EQUAL(
+					u256(Word256::mulMod(Word256(a), Word256(b), Word256(m))),
+					m == 0 ? 0 : u256((u512(a) * u512(b)) % m)
+				);
+			}
+}
+
+BOOST_AUTO_TEST_CASE(shifts_and_bytes)
+{
+	for (u256 const& value: testValues())
+	{
+		Word256 word(value);
+		BOOST_CHECK_EQUAL(u256(~word), ~value);
+		for (unsigned shift = 0; shift <= 260; ++shift)
+		{
+			BOOST_CHECK_EQUAL(u256(word << shift), shift >= 256 ? 0 : u256(value << shift));
+			BOOST_CHECK_EQUAL(u256(word >> shift), shift >= 256 ? 0 : u256(value >> shift));
+			u256 arithmetic = shift >= 256 ? 0 : u256(value >> shift);
+			if (shift > 0 && u2s(value) < 0)
+				arithmetic |= shift >= 256 ? u256(-1) : u256(u256(-1) << (256 - shift));
+			BOOST_CHECK_EQUAL(u256(Word256::arithmeticShiftRight(word, shift)), arithmetic);
+			BOOST_CHECK_EQUAL(word.bit(shift), shift < 256 && boost::multiprecision::bit_test(value, shift));
+		}
+		for (unsigned index = 0; index <= 33; ++index)
+		{
+			u256 byte = index >= 32 ? 0 : u256((value >> (8 * (31 - index))) & 0xff);
+			BOOST_CHECK_EQUAL(u256(Word256::byte(index, word)), byte);
+
+			u256 extended = value;
+			if (index < 31)
+			{
+				unsigned testBit = index * 8 + 7;
+				u256 mask = (u256(1) << testBit) - 1;
+				extended = boost::multiprecision::bit_test(value, testBit) ? value | ~mask : value & mask;
+			}
+			BOOST_CHECK_EQUAL(u256(Word256::signExtend(index, word)), extended);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -0,0 +1,117 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Unit tests for the Yul string repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(empty_string)
+{
+	BOOST_CHECK(YulString().empty());
+	BOOST_CHECK(YulString(string{}).empty());
+	BOOST_CHECK(YulString() == YulString(""));
+	BOOST_CHECK_EQUAL(YulString().str(), "");
+	BOOST_CHECK(!YulString("a").empty());
+}
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString a("abc");
+	YulString b(string("ab") + "c");
+	YulString c("abd");
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(a != c);
+	BOOST_CHECK_EQUAL(a.str(), "abc");
+	BOOST_CHECK_EQUAL(c.str(), "abd");
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("abc"));
+}
+
+BOOST_AUTO_TEST_CASE(many_strings)
+{
+	// Needs more than one block of the repository.
+	vector<YulString> strings;
+	for (size_t i = 0; i < 10000; ++i)
+		strings.emplace_back("many_strings_" + to_string(i));
+	for (size_t i = 0; i < strings.size(); ++i)
+	{
+		BOOST_CHECK_EQUAL(strings[i].str(), "many_strings_" + to_string(i));
+		BOOST_CHECK(strings[i] == YulString("many_strings_" + to_string(i)));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 4;
+	size_t const stringCount = 4999;
+	vector<vector<YulString>> results(threadCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]()
+		{
+			// Every thread adds the same strings, in a different order.
+			results[t].resize(stringCount);
+			for (size_t i = 0; i < stringCount; ++i)
+			{
+				size_t index = (i * (2 * t + 1)) % stringCount;
+				results[t][index] = YulString("concurrent_" + to_string(index));
+			}
+		});
+	for (thread& t: threads)
+		t.join();
+
+	for (size_t i = 0; i < stringCount; ++i)
+	{
+		BOOST_CHECK_EQUAL(results[0][i].str(), "concurrent_" + to_string(i));
+		for (size_t t = 1; t < threadCount; ++t)
+			BOOST_CHECK(results[t][i] == results[0][i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(scopes)
+{
+	static size_t resets = 0;
+	static YulStringRepository::ResetCallback callback{[]() { ++resets; }};
+	size_t resetsBefore = resets;
+	{
+		YulStringRepository::Scope outer;
+		YulString a("scoped");
+		{
+			YulStringRepository::Scope inner;
+			BOOST_CHECK(YulString("scoped") == a);
+		}
+		BOOST_CHECK_EQUAL(resets, resetsBefore);
+		BOOST_CHECK_EQUAL(a.str(), "scoped");
+	}
+	BOOST_CHECK_EQUAL(resets, resetsBefore + 1);
+	BOOST_CHECK_EQUAL(YulString("scoped").str(), "scoped");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
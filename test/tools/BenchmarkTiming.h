@@ -0,0 +1,60 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Time measurements shared by the benchmark tools.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <ratio>
+#include <vector>
+
+namespace solidity::test
+{
+
+/// @returns the median of @a _values, which must not be empty.
+inline double median(std::vector<double> _values)
+{
+	std::sort(_values.begin(), _values.end());
+	return _values[_values.size() / 2];
+}
+
+/// Calls @a _function once and @returns the duration of the call in units of @a Period,
+/// seconds by default.
+template <typename Period = std::ratio<1>, typename Function>
+double measureDuration(Function&& _function)
+{
+	auto start = std::chrono::steady_clock::now();
+	_function();
+	std::chrono::duration<double, Period> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count();
+}
+
+/// Calls @a _function @a _repetitions times and @returns the median of the durations of the
+/// calls in units of @a Period, seconds by default.
+template <typename Period = std::ratio<1>, typename Function>
+double medianDuration(size_t _repetitions, Function&& _function)
+{
+	std::vector<double> durations;
+	for (size_t repetition = 0; repetition < _repetitions; ++repetition)
+		durations.push_back(measureDuration<Period>(_function));
+	return median(std::move(durations));
+}
+
+}
@@ -0,0 +1,183 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark of the evmasm common subexpression eliminator and of the knowledge gathering
+ * of the control flow graph on the assembly of the given contracts.
+ */
+
+#include <test/tools/BenchmarkTiming.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+
+#include <libevmasm/CommonSubexpressionEliminator.h>
+#include <libevmasm/ControlFlowGraph.h>
+#include <libevmasm/KnownState.h>
+
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::evmasm;
+using namespace solidity::frontend;
+using namespace solidity::test;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Runs the common subexpression eliminator on @a _items like Assembly::optimise does.
+/// @returns the number of optimised items.
+size_t eliminateCommonSubexpressions(AssemblyItems const& _items)
+{
+	bool usesMSize = find(_items.begin(), _items.end(), AssemblyItem{Instruction::MSIZE}) != _items.end();
+	size_t optimisedSize = 0;
+	auto iter = _items.begin();
+	while (iter != _items.end())
+	{
+		KnownState emptyState;
+		CommonSubexpressionEliminator eliminator{emptyState};
+		auto orig = iter;
+		iter = eliminator.feedItems(iter, _items.end(), usesMSize);
+		try
+		{
+			optimisedSize += min(eliminator.getOptimizedItems().size(), static_cast<size_t>(iter - orig));
+		}
+		catch (StackTooDeepException const&)
+		{
+			optimisedSize += static_cast<size_t>(iter - orig);
+		}
+		catch (ItemNotAvailableException const&)
+		{
+			optimisedSize += static_cast<size_t>(iter - orig);
+		}
+	}
+	return optimisedSize;
+}
+
+/// Builds the control flow graph of @a _items, which copies and joins the known states of all blocks.
+/// @returns the number of basic blocks.
+size_t gatherKnowledge(AssemblyItems const& _items)
+{
+	ControlFlowGraph cfg(_items);
+	return cfg.optimisedBlocks().size();
+}
+
+/// @returns the milliseconds per call of @a _function on @a _items.
+template <typename Function>
+double measure(Function const& _function, AssemblyItems const& _items, size_t _rounds, size_t& _sink)
+{
+	double elapsed = measureDuration<milli>([&]() {
+		for (size_t round = 0; round < _rounds; ++round)
+			_sink += _function(_items);
+	});
+	return elapsed / double(_rounds);
+}
+
+/// @returns all Solidity sources below @a _root, named by their path relative to it.
+StringMap loadSources(boost::filesystem::path const& _root)
+{
+	StringMap sources;
+	for (auto const& entry: boost::filesystem::recursive_directory_iterator(_root))
+		if (boost::filesystem::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+			sources[boost::filesystem::relative(entry.path(), _root).generic_string()] =
+				util::readFileAsString(entry.path().string());
+	return sources;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(csebench, benchmark of the evmasm common subexpression eliminator.
+Compiles all Solidity files below the given directories without optimisation and
+measures the common subexpression eliminator and the control flow graph on the
+creation and runtime assembly of each contract.
+Usage: csebench [Options] test/compilationTests
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23
+	);
+	options.add_options()
+		("input-directory", po::value<vector<string>>(), "Directory containing the contracts.")
+		("rounds", po::value<size_t>()->default_value(10), "Number of runs per contract.")
+		("help", "Show this help screen.");
+	po::positional_options_description positionalOptions;
+	positionalOptions.add("input-directory", -1);
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::command_line_parser(argc, argv).options(options).positional(positionalOptions).run(), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	if (arguments.count("help") || !arguments.count("input-directory"))
+	{
+		cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+	size_t rounds = max<size_t>(arguments["rounds"].as<size_t>(), 1);
+
+	size_t sink = 0;
+	double totalCSE = 0;
+	double totalCFG = 0;
+	cout << left << setw(48) << "contract" << right << setw(10) << "items" << setw(12) << "CSE ms" << setw(12) << "CFG ms" << endl;
+	for (string const& directory: arguments["input-directory"].as<vector<string>>())
+	{
+		CompilerStack compiler;
+		compiler.setSources(loadSources(directory));
+		compiler.setOptimiserSettings(false);
+		if (!compiler.compile())
+		{
+			solidity::langutil::SourceReferenceFormatter formatter(cerr);
+			for (auto const& error: compiler.errors())
+				formatter.printErrorInformation(*error);
+			return 1;
+		}
+		for (string const& contract: compiler.contractNames())
+			for (auto const* items: {compiler.assemblyItems(contract), compiler.runtimeAssemblyItems(contract)})
+			{
+				if (!items || items->empty())
+					continue;
+				double cse = measure(eliminateCommonSubexpressions, *items, rounds, sink);
+				double cfg = measure(gatherKnowledge, *items, rounds, sink);
+				totalCSE += cse;
+				totalCFG += cfg;
+				string name = items == compiler.runtimeAssemblyItems(contract) ? contract + " (runtime)" : contract;
+				cout << fixed << setprecision(2) << left << setw(48) << name << right << setw(10) << items->size()
+					<< setw(12) << cse << setw(12) << cfg << endl;
+			}
+	}
+	cout << fixed << setprecision(2) << left << setw(58) << "total" << right << setw(12) << totalCSE << setw(12) << totalCFG << endl;
+	cout << "checksum: " << sink << endl;
+	return 0;
+}
@@ -0,0 +1,146 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark of the throughput of the scanner and of the translation of source positions
+ * to lines and columns on a large source, flattened from the Solidity files of a corpus.
+ */
+
+#include <test/tools/BenchmarkTiming.h>
+
+#include <liblangutil/CharStream.h>
+#include <liblangutil/Scanner.h>
+
+#include <libsolutil/CommonIO.h>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::langutil;
+using namespace solidity::test;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+/// @returns the contents of all Solidity files below @a _directories, in the order of their
+/// paths, separated by line breaks.
+string flatten(vector<string> const& _directories)
+{
+	vector<fs::path> files;
+	for (string const& directory: _directories)
+		for (auto const& entry: fs::recursive_directory_iterator(directory))
+			if (fs::is_regular_file(entry.path()) && entry.path().extension() == ".sol")
+				files.push_back(entry.path());
+	sort(files.begin(), files.end());
+	string source;
+	for (fs::path const& file: files)
+		source += util::readFileAsString(file.string()) + "\n";
+	return source;
+}
+
+/// Number of token positions that are translated to lines and columns, spread evenly over the source.
+size_t constexpr c_lookups = 10000;
+
+void printRate(string const& _what, double _count, string const& _unit, double _seconds)
+{
+	cout << "  " << left << setw(24) << _what << right << setw(16) << fixed << setprecision(2)
+		<< _count / _seconds << " " << _unit << "/s" << endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(scannerbench, benchmark of the Solidity scanner.
+Concatenates all Solidity files below the given directories into one source and reports
+the median throughput of scanning it and of translating the positions of its tokens
+to lines and columns.
+Usage: scannerbench [Options] test/compilationTests
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23
+	);
+	options.add_options()
+		("input-directory", po::value<vector<string>>(), "Directory containing the contracts.")
+		("copies", po::value<size_t>()->default_value(10), "Number of times the files are repeated in the source.")
+		("repetitions", po::value<size_t>()->default_value(5), "Number of measurements.")
+		("help", "Show this help screen.");
+	po::positional_options_description positionalOptions;
+	positionalOptions.add("input-directory", -1);
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::command_line_parser(argc, argv).options(options).positional(positionalOptions).run(), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	if (arguments.count("help") || !arguments.count("input-directory"))
+	{
+		cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+
+	string const files = flatten(arguments["input-directory"].as<vector<string>>());
+	string source;
+	for (size_t copy = 0; copy < max<size_t>(arguments["copies"].as<size_t>(), 1); ++copy)
+		source += files;
+	size_t repetitions = max<size_t>(arguments["repetitions"].as<size_t>(), 1);
+	CharStream const stream(move(source), "flattened.sol");
+
+	vector<int> positions;
+	Scanner positionScanner(stream);
+	for (; positionScanner.currentToken() != Token::EOS; positionScanner.next())
+		positions.push_back(positionScanner.currentLocation().start);
+	size_t lines = size_t(get<0>(stream.translatePositionToLineColumn(int(stream.source().size())))) + 1;
+	cout << fixed << setprecision(2) << double(stream.source().size()) / 1e6 << " MB, "
+		<< lines << " lines, " << positions.size() << " tokens" << endl;
+
+	double scanning = medianDuration(repetitions, [&]() {
+		Scanner scanner(stream);
+		while (scanner.next() != Token::EOS)
+		{
+		}
+	});
+	// Every repetition uses a fresh copy of the characters, so that lines and columns are not
+	// only looked up in a table computed by an earlier repetition.
+	size_t lookups = min<size_t>(positions.size(), c_lookups);
+	double translating = medianDuration(repetitions, [&]() {
+		CharStream copy(string(stream.source()), stream.name());
+		for (size_t lookup = 0; lookup < lookups; ++lookup)
+			copy.translatePositionToLineColumn(positions[lookup * positions.size() / lookups]);
+	});
+
+	printRate("scanning", double(stream.source().size()) / 1e6, "MB", scanning);
+	printRate("scanning", double(positions.size()) / 1e6, "Mtokens", scanning);
+	printRate("line and column lookup", double(lookups), "lookups", translating);
+	return 0;
+}
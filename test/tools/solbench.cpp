@@ -0,0 +1,518 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Benchmark of the end-to-end and per-phase compilation time of a corpus of contracts
+ * under the legacy and the IR code generator, with and without optimiser. The results
+ * can be stored as a baseline and compared against it.
+ */
+
+#include <test/TestCaseReader.h>
+#include <test/tools/BenchmarkTiming.h>
+
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libyul/AssemblyStack.h>
+
+#include <liblangutil/Exceptions.h>
+#include <liblangutil/SourceReferenceFormatter.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+#include <libsolutil/Profiler.h>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using solidity::test::measureDuration;
+using solidity::test::median;
+
+namespace po = boost::program_options;
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+struct Configuration
+{
+	string name;
+	bool optimize;
+	bool viaIR;
+};
+
+vector<Configuration> const configurations{
+	{"legacy", false, false},
+	{"legacy-optimize", true, false},
+	{"via-ir", false, true},
+	{"via-ir-optimize", true, true}
+};
+
+/// Sources that are compiled together.
+struct CompilationUnit
+{
+	string name;
+	StringMap sources;
+};
+
+/// Result of compiling all units under one configuration.
+struct Measurement
+{
+	/// Milliseconds per compilation unit, median of the repetitions.
+	map<string, double> units;
+	/// Total milliseconds per compiler phase, median of the repetitions.
+	map<string, double> phases;
+	/// Units that did not compile under this configuration, e.g. due to features the
+	/// IR code generator does not implement yet.
+	vector<string> failed;
+	size_t peakMemory = 0;
+
+	double total() const
+	{
+		double sum = 0;
+		for (auto const& unit: units)
+			sum += unit.second;
+		return sum;
+	}
+};
+
+/// Loads the units below @a _root. Files in the format of isoltest, i.e. those containing
+/// a line starting with "// ----", are units on their own. All other files are grouped into
+/// one unit per subdirectory of @a _root, named by their path relative to it, so that their
+/// imports can be resolved.
+vector<CompilationUnit> loadUnits(fs::path const& _root)
+{
+	vector<CompilationUnit> units;
+	map<string, CompilationUnit> projects;
+	for (auto const& entry: fs::recursive_directory_iterator(_root))
+	{
+		if (!fs::is_regular_file(entry.path()) || entry.path().extension() != ".sol")
+			continue;
+		fs::path relative = fs::relative(entry.path(), _root);
+		string name = (_root.filename() / relative).generic_string();
+		string contents = util::readFileAsString(entry.path().string());
+		if (boost::starts_with(contents, "// ----") || contents.find("\n// ----") != string::npos)
+			units.push_back({name, frontend::test::TestCaseReader(entry.path().string()).sources()});
+		else
+		{
+			fs::path project = *relative.begin();
+			CompilationUnit& unit = projects[project.generic_string()];
+			unit.name = (_root.filename() / project).generic_string();
+			unit.sources[relative == project ? relative.generic_string() : fs::relative(relative, project).generic_string()] =
+				move(contents);
+		}
+	}
+	for (auto& project: projects)
+		units.push_back(move(project.second));
+	sort(units.begin(), units.end(), [](auto const& _a, auto const& _b) { return _a.name < _b.name; });
+	return units;
+}
+
+/// Compiles @a _unit under @a _configuration, recording its phases in @a _profiler.
+/// For the IR code generator, the optimized IR of each contract is also assembled into bytecode.
+/// @returns false if the unit does not compile.
+bool compile(
+	CompilationUnit const& _unit,
+	Configuration const& _configuration,
+	size_t _jobs,
+	util::Profiler& _profiler,
+	bool _verbose
+)
+{
+	OptimiserSettings settings = _configuration.optimize ? OptimiserSettings::standard() : OptimiserSettings::minimal();
+	CompilerStack compiler;
+	compiler.setSources(_unit.sources);
+	compiler.setOptimiserSettings(settings);
+	compiler.setParallelism(_jobs);
+	compiler.enableIRGeneration(_configuration.viaIR);
+	compiler.setProfiler(&_profiler);
+	try
+	{
+		if (!compiler.compile())
+		{
+			if (_verbose)
+			{
+				langutil::SourceReferenceFormatter formatter(cerr);
+				for (auto const& error: compiler.errors())
+					formatter.printErrorInformation(*error);
+			}
+			return false;
+		}
+		if (_configuration.viaIR)
+			for (string const& contract: compiler.contractNames())
+			{
+				string const& ir = compiler.yulIROptimized(contract);
+				if (ir.empty())
+					continue;
+				util::ScopedTimer timer(&_profiler, "IR assembly", contract);
+				yul::AssemblyStack stack(
+					langutil::EVMVersion{},
+					yul::AssemblyStack::Language::StrictAssembly,
+					settings
+				);
+				if (!stack.parseAndAnalyze(contract, ir))
+					return false;
+				stack.optimize();
+				stack.assemble(yul::AssemblyStack::Machine::EVM);
+			}
+	}
+	catch (util::Exception const& _exception)
+	{
+		if (_verbose)
+			cerr << _unit.name << " (" << _configuration.name << "): " << _exception.what() << endl;
+		return false;
+	}
+	return true;
+}
+
+Measurement measure(
+	vector<CompilationUnit> const& _units,
+	Configuration const& _configuration,
+	size_t _repetitions,
+	size_t _jobs,
+	bool _verbose
+)
+{
+	Measurement result;
+	map<string, vector<double>> phaseTimes;
+	for (CompilationUnit const& unit: _units)
+	{
+		vector<double> times;
+		for (size_t repetition = 0; repetition < _repetitions; ++repetition)
+		{
+			util::Profiler profiler;
+			bool success = false;
+			double elapsed = measureDuration<milli>([&]() {
+				success = compile(unit, _configuration, _jobs, profiler, _verbose && repetition == 0);
+			});
+			// Compilation is deterministic, so only the first repetition can fail.
+			if (!success)
+			{
+				result.failed.push_back(unit.name);
+				break;
+			}
+			times.push_back(elapsed);
+			map<string, double> phases;
+			for (auto const& phase: profiler.phases())
+				phases[phase.name] += double(phase.duration.count()) / 1000;
+			for (auto const& phase: phases)
+			{
+				auto& values = phaseTimes[phase.first];
+				values.resize(_repetitions);
+				values[repetition] += phase.second;
+			}
+		}
+		if (!times.empty())
+			result.units[unit.name] = median(times);
+	}
+	for (auto const& phase: phaseTimes)
+		result.phases[phase.first] = median(phase.second);
+	result.peakMemory = util::Profiler::peakMemoryUsage();
+	return result;
+}
+
+Json::Value toJson(Measurement const& _measurement)
+{
+	Json::Value entry(Json::objectValue);
+	entry["total"] = _measurement.total();
+	entry["peakMemory"] = Json::UInt64(_measurement.peakMemory);
+	entry["units"] = Json::objectValue;
+	for (auto const& unit: _measurement.units)
+		entry["units"][unit.first] = unit.second;
+	entry["phases"] = Json::objectValue;
+	for (auto const& phase: _measurement.phases)
+		entry["phases"][phase.first] = phase.second;
+	entry["failed"] = Json::arrayValue;
+	for (string const& unit: _measurement.failed)
+		entry["failed"].append(unit);
+	return entry;
+}
+
+Measurement measurementFromJson(Json::Value const& _entry)
+{
+	Measurement measurement;
+	measurement.peakMemory = _entry["peakMemory"].asUInt64();
+	for (string const& unit: _entry["units"].getMemberNames())
+		measurement.units[unit] = _entry["units"][unit].asDouble();
+	for (string const& phase: _entry["phases"].getMemberNames())
+		measurement.phases[phase] = _entry["phases"][phase].asDouble();
+	for (Json::Value const& unit: _entry["failed"])
+		measurement.failed.push_back(unit.asString());
+	return measurement;
+}
+
+Json::Value toJson(map<string, Measurement> const& _measurements)
+{
+	Json::Value output(Json::objectValue);
+	for (auto const& [configuration, measurement]: _measurements)
+		output["configurations"][configuration] = toJson(measurement);
+	return output;
+}
+
+/// Runs measure() in a child process, so that the peak memory is the one of this configuration
+/// and not the highest one of all configurations measured before.
+Measurement measureInChildProcess(
+	vector<CompilationUnit> const& _units,
+	Configuration const& _configuration,
+	size_t _repetitions,
+	size_t _jobs,
+	bool _verbose
+)
+{
+#if defined(_WIN32)
+	return measure(_units, _configuration, _repetitions, _jobs, _verbose);
+#else
+	int descriptors[2];
+	if (pipe(descriptors) != 0)
+		throw runtime_error("Could not create a pipe.");
+	cout.flush();
+	cerr.flush();
+	pid_t child = fork();
+	if (child < 0)
+		throw runtime_error("Could not start a child process.");
+	if (child == 0)
+	{
+		close(descriptors[0]);
+		int status = 0;
+		try
+		{
+			string output = util::jsonCompactPrint(toJson(measure(_units, _configuration, _repetitions, _jobs, _verbose)));
+			for (size_t written = 0; written < output.size();)
+			{
+				ssize_t result = write(descriptors[1], output.data() + written, output.size() - written);
+				if (result <= 0)
+				{
+					status = 1;
+					break;
+				}
+				written += static_cast<size_t>(result);
+			}
+		}
+		catch (exception const& _exception)
+		{
+			cerr << _exception.what() << endl;
+			status = 1;
+		}
+		// Skips the destructors and buffers that belong to the parent.
+		_exit(status);
+	}
+
+	close(descriptors[1]);
+	string output;
+	char buffer[4096];
+	for (ssize_t count; (count = read(descriptors[0], buffer, sizeof(buffer))) > 0;)
+		output.append(buffer, static_cast<size_t>(count));
+	close(descriptors[0]);
+	int status = 0;
+	Json::Value result;
+	if (
+		waitpid(child, &status, 0) != child ||
+		!WIFEXITED(status) ||
+		WEXITSTATUS(status) != 0 ||
+		!util::jsonParseStrict(output, result)
+	)
+		throw runtime_error("Measuring " + _configuration.name + " failed.");
+	return measurementFromJson(result);
+#endif
+}
+
+void printMeasurement(string const& _configuration, Measurement const& _measurement)
+{
+	cout << endl << _configuration << ": " << _measurement.units.size() << " units compiled";
+	if (!_measurement.failed.empty())
+		cout << ", " << _measurement.failed.size() << " failed";
+	cout << endl;
+	cout << fixed << setprecision(2);
+	for (auto const& phase: _measurement.phases)
+		cout << "  " << left << setw(32) << phase.first << right << setw(14) << phase.second << " ms" << endl;
+	cout << "  " << left << setw(32) << "total" << right << setw(14) << _measurement.total() << " ms" << endl;
+	cout << "  " << left << setw(32) << "peak memory" << right << setw(14) << _measurement.peakMemory << " KiB" << endl;
+}
+
+/// Compares @a _current against @a _baseline and prints all totals, phases and units that
+/// are slower by more than @a _threshold percent and by more than a millisecond.
+/// @returns the number of regressions.
+size_t compare(Json::Value const& _baseline, Json::Value const& _current, double _threshold)
+{
+	size_t regressions = 0;
+	auto check = [&](string const& _what, Json::Value const& _before, Json::Value const& _after)
+	{
+		if (!_before.isNumeric() || !_after.isNumeric())
+			return;
+		double before = _before.asDouble();
+		double after = _after.asDouble();
+		if (after > before * (1 + _threshold / 100) && after - before > 1)
+		{
+			++regressions;
+			cout << "  " << _what << ": " << fixed << setprecision(2) << before << " ms -> " << after << " ms (+"
+				<< setprecision(1) << (after / max(before, 1e-9) - 1) * 100 << "%)" << endl;
+		}
+	};
+
+	cout << endl << "Regressions against the baseline by more than " << _threshold << "%:" << endl;
+	for (string const& configuration: _current["configurations"].getMemberNames())
+	{
+		Json::Value const& before = _baseline["configurations"][configuration];
+		Json::Value const& after = _current["configurations"][configuration];
+		if (!before.isObject())
+			continue;
+		check(configuration + " total", before["total"], after["total"]);
+		for (string const& phase: after["phases"].getMemberNames())
+			check(configuration + " " + phase, before["phases"][phase], after["phases"][phase]);
+		for (string const& unit: after["units"].getMemberNames())
+			check(configuration + " " + unit, before["units"][unit], after["units"][unit]);
+	}
+	if (regressions == 0)
+		cout << "  none" << endl;
+	return regressions;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(solbench, benchmark of the compilation time of Solidity contracts.
+Compiles all Solidity files below the given directories under the legacy and the IR code
+generator, with and without optimiser, and reports the median time per compiler phase
+and the peak memory of the process. Files in the format of isoltest are compiled on their
+own, all other files are compiled together per subdirectory of the given directory.
+Each configuration is measured in its own process, so that its peak memory can be told apart.
+Usage: solbench [Options] test/compilationTests test/libsolidity/semanticTests
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23
+	);
+	options.add_options()
+		("input-directory", po::value<vector<string>>(), "Directory containing the contracts.")
+		(
+			"configuration",
+			po::value<vector<string>>(),
+			"Only run the given configurations: legacy, legacy-optimize, via-ir or via-ir-optimize."
+		)
+		("repetitions", po::value<size_t>()->default_value(3), "Number of compilations per unit.")
+		("jobs", po::value<size_t>()->default_value(1), "Number of contracts compiled concurrently.")
+		("output", po::value<string>(), "Write the results as JSON to the given file, e.g. to store a baseline.")
+		("baseline", po::value<string>(), "Compare the results to the JSON file written by an earlier run.")
+		("threshold", po::value<double>()->default_value(10), "Percentage above which a slowdown is reported.")
+		("verbose", "Print why units fail to compile.")
+		("help", "Show this help screen.");
+	po::positional_options_description positionalOptions;
+	positionalOptions.add("input-directory", -1);
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::command_line_parser(argc, argv).options(options).positional(positionalOptions).run(), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	if (arguments.count("help") || !arguments.count("input-directory"))
+	{
+		cout << options;
+		return arguments.count("help") ? 0 : 1;
+	}
+
+	vector<Configuration> selected;
+	if (arguments.count("configuration"))
+		for (string const& name: arguments["configuration"].as<vector<string>>())
+		{
+			auto it = find_if(configurations.begin(), configurations.end(), [&](auto const& _c) { return _c.name == name; });
+			if (it == configurations.end())
+			{
+				cerr << "Unknown configuration: " << name << endl;
+				return 1;
+			}
+			selected.push_back(*it);
+		}
+	else
+		selected = configurations;
+
+	Json::Value baseline;
+	if (arguments.count("baseline"))
+	{
+		string baselineFile = arguments["baseline"].as<string>();
+		if (!util::jsonParseStrict(util::readFileAsString(baselineFile), baseline))
+		{
+			cerr << "Could not parse baseline: " << baselineFile << endl;
+			return 1;
+		}
+	}
+
+	vector<CompilationUnit> units;
+	for (string const& directory: arguments["input-directory"].as<vector<string>>())
+		for (auto& unit: loadUnits(fs::canonical(directory)))
+			units.push_back(move(unit));
+	cout << units.size() << " compilation units" << endl;
+
+	size_t repetitions = max<size_t>(arguments["repetitions"].as<size_t>(), 1);
+	size_t jobs = max<size_t>(arguments["jobs"].as<size_t>(), 1);
+	map<string, Measurement> measurements;
+	for (Configuration const& configuration: selected)
+	{
+		try
+		{
+			measurements[configuration.name] = measureInChildProcess(
+				units,
+				configuration,
+				repetitions,
+				jobs,
+				arguments.count("verbose")
+			);
+		}
+		catch (runtime_error const& _exception)
+		{
+			cerr << _exception.what() << endl;
+			return 1;
+		}
+		printMeasurement(configuration.name, measurements[configuration.name]);
+	}
+
+	Json::Value results = toJson(measurements);
+	if (arguments.count("output"))
+	{
+		ofstream output(arguments["output"].as<string>());
+		output << util::jsonPrettyPrint(results) << endl;
+		if (!output)
+		{
+			cerr << "Could not write results to " << arguments["output"].as<string>() << endl;
+			return 1;
+		}
+	}
+	if (arguments.count("baseline") && compare(baseline, results, arguments["threshold"].as<double>()) > 0)
+		return 2;
+	return 0;
+}
@@ -0,0 +1,205 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+ * Microbenchmark comparing the EVM arithmetic on u256 and on Word256.
+ */
+
+#include <test/tools/BenchmarkTiming.h>
+
+#include <libsolutil/Word256.h>
+
+#include <boost/program_options.hpp>
+
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::test;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 256, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
+
+/// @returns the nanoseconds per call of @a _function, which is applied to all of @a _operands
+/// @a _rounds times.
+template <typename T, typename Function>
+double measure(Function const& _function, vector<T> const& _operands, size_t _rounds, T& _sink)
+{
+	double elapsed = measureDuration<nano>([&]() {
+		for (size_t round = 0; round < _rounds; ++round)
+			for (size_t i = 0; i + 2 < _operands.size(); ++i)
+				_sink += _function(_operands[i], _operands[i + 1], _operands[i + 2]);
+	});
+	return elapsed / double(_rounds * (_operands.size() - 2));
+}
+
+class Benchmark
+{
+public:
+	Benchmark(vector<u256> _operands, size_t _rounds): m_operands(move(_operands)), m_rounds(_rounds)
+	{
+		for (u256 const& operand: m_operands)
+			m_words.emplace_back(operand);
+		cout << left << setw(12) << "operation" << right << setw(12) << "u256 ns" << setw(14) << "Word256 ns"
+			<< setw(12) << "speedup" << setw(22) << "incl. conversion ns" << setw(12) << "speedup" << endl;
+	}
+
+	/// Measures an operation on u256, on Word256 and on Word256 including the conversion
+	/// of the operands and of the result.
+	template <typename OnU256, typename OnWord256>
+	void run(string const& _name, OnU256 const& _onU256, OnWord256 const& _onWord256)
+	{
+		double onU256 = measure(_onU256, m_operands, m_rounds, m_sink);
+		double onWord256 = measure(_onWord256, m_words, m_rounds, m_wordSink);
+		auto converting = [&](u256 const& _a, u256 const& _b, u256 const& _c) {
+			return u256(_onWord256(Word256(_a), Word256(_b), Word256(_c)));
+		};
+		double withConversion = measure(converting, m_operands, m_rounds, m_sink);
+		cout << fixed << setprecision(1) << left << setw(12) << _name << right
+			<< setw(12) << onU256 << setw(14) << onWord256 << setw(11) << onU256 / onWord256 << "x"
+			<< setw(22) << withConversion << setw(11) << onU256 / withConversion << "x" << endl;
+	}
+
+	/// Printing the checksum keeps the compiler from removing the measured operations.
+	u256 checksum() const { return m_sink + u256(m_wordSink); }
+
+private:
+	vector<u256> m_operands;
+	vector<Word256> m_words;
+	size_t m_rounds;
+	u256 m_sink;
+	Word256 m_wordSink;
+};
+
+}
+
+int main(int argc, char** argv)
+{
+	po::options_description options(
+		R"(word256bench, microbenchmark of the EVM arithmetic on u256 and on Word256.
+Usage: word256bench [Options]
+Allowed options)",
+		po::options_description::m_default_line_length,
+		po::options_description::m_default_line_length - 23
+	);
+	options.add_options()
+		("rounds", po::value<size_t>()->default_value(100), "Number of passes over the operands.")
+		("operands", po::value<size_t>()->default_value(1000), "Number of random operands.")
+		("help", "Show this help screen.");
+	po::variables_map arguments;
+	try
+	{
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+		po::notify(arguments);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	if (arguments.count("help"))
+	{
+		cout << options;
+		return 0;
+	}
+
+	// Operands of all lengths, since short ones take the fast paths of both types.
+	mt19937_64 random(0);
+	vector<u256> operands;
+	for (size_t i = 0; i < max<size_t>(arguments["operands"].as<size_t>(), 3); ++i)
+	{
+		u256 value;
+		for (size_t limb = 0; limb < 4; ++limb)
+			value = (value << 64) | random();
+		operands.push_back(value >> unsigned(random() % 256));
+	}
+
+	// The u256 variants are implemented like the operations were before switching to Word256.
+	Benchmark benchmark(move(operands), arguments["rounds"].as<size_t>());
+	benchmark.run(
+		"add",
+		[](u256 const& a, u256 const& b, u256 const&) { return a + b; },
+		[](Word256 const& a, Word256 const& b, Word256 const&) { return a + b; }
+	);
+	benchmark.run(
+		"mul",
+		[](u256 const& a, u256 const& b, u256 const&) { return a * b; },
+		[](Word256 const& a, Word256 const& b, Word256 const&) { return a * b; }
+	);
+	benchmark.run(
+		"div",
+		[](u256 const& a, u256 const& b, u256 const&) { return b == 0 ? 0 : u256(a / b); },
+		[](Word256 const& a, Word256 const& b, Word256 const&) { return a / b; }
+	);
+	benchmark.run(
+		"mod",
+		[](u256 const& a, u256 const& b, u256 const&) { return b == 0 ? 0 : u256(a % b); },
+		[](Word256 const& a, Word256 const& b, Word256 const&) { return a % b; }
+	);
+	benchmark.run(
+		"sdiv",
+		[](u256 const& a, u256 const& b, u256 const&) { return b == 0 ? 0 : s2u(u2s(a) / u2s(b)); },
+		[](Word256 const& a, Word256 const& b, Word256 const&) { return Word256::signedDiv(a, b); }
+	);
+	benchmark.run(
+		"slt",
+		[](u256 const& a, u256 const& b, u256 const&) { return u2s(a) < u2s(b) ? u256(1) : u256(0); },
+		[](Word256 const& a, Word256 const& b, Word256 const&) { return Word256(Word256::signedLess(a, b) ? 1 : 0); }
+	);
+	benchmark.run(
+		"exp",
+		[](u256 const& a, u256 const& b, u256 const&) { return exp256(a, b); },
+		[](Word256 const& a, Word256 const& b, Word256 const&) { return Word256::exp(a, b); }
+	);
+	benchmark.run(
+		"addmod",
+		[](u256 const& a, u256 const& b, u256 const& c) { return c == 0 ? 0 : u256((u512(a) + u512(b)) % c); },
+		[](Word256 const& a, Word256 const& b, Word256 const& c) { return Word256::addMod(a, b, c); }
+	);
+	benchmark.run(
+		"mulmod",
+		[](u256 const& a, u256 const& b, u256 const& c) { return c == 0 ? 0 : u256((u512(a) * u512(b)) % c); },
+		[](Word256 const& a, Word256 const& b, Word256 const& c) { return Word256::mulMod(a, b, c); }
+	);
+	benchmark.run(
+		"shl",
+		[](u256 const& a, u256 const& b, u256 const&) { return u256(a << unsigned(b & 0xff)); },
+		[](Word256 const& a, Word256 const& b, Word256 const&) { return a << unsigned(b.limb(0) & 0xff); }
+	);
+	benchmark.run(
+		"signextend",
+		[](u256 const& a, u256 const& b, u256 const&) {
+			unsigned byteIndex = unsigned(b & 0x1f);
+			if (byteIndex >= 31)
+				return a;
+			unsigned testBit = byteIndex * 8 + 7;
+			u256 mask = (u256(1) << testBit) - 1;
+			return boost::multiprecision::bit_test(a, testBit) ? u256(a | ~mask) : u256(a & mask);
+		},
+		[](Word256 const& a, Word256 const& b, Word256 const&) { return Word256::signExtend(b & 0x1f, a); }
+	);
+	cout << "checksum: " << benchmark.checksum() << endl;
+	return 0;
+}
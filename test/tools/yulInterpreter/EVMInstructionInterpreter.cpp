@@ -28,6 +28,7 @@
 #include <libevmasm/Instruction.h>
 
 #include <libsolutil/Keccak256.h>
+#include <libsolutil/Word256.h>
 
 using namespace std;
 using namespace solidity;
@@ -36,6 +37,7 @@ using namespace solidity::yul::test;
 
 using solidity::util::h256;
 using solidity::util::keccak256;
+using solidity::util::Word256;
 
 namespace
 {
@@ -77,8 +79,6 @@ void copyZeroExtended(
 
 }
 
-using u512 = boost::multiprecision::number<boost::multiprecision::cpp_int_backend<512, 256, boost::multiprecision::unsigned_magnitude, boost::multiprecision::unchecked, void>>;
-
 u256 EVMInstructionInterpreter::eval(
 	evmasm::Instruction _instruction,
 	vector<u256> const& _arguments
@@ -103,15 +103,15 @@ u256 EVMInstructionInterpreter::eval(
 	case Instruction::SUB:
 		return arg[0] - arg[1];
 	case Instruction::DIV:
-		return arg[1] == 0 ? 0 : arg[0] / arg[1];
+		return u256(Word256(arg[0]) / Word256(arg[1]));
 	case Instruction::SDIV:
-		return arg[1] == 0 ? 0 : s2u(u2s(arg[0]) / u2s(arg[1]));
+		return u256(Word256::signedDiv(Word256(arg[0]), Word256(arg[1])));
 	case Instruction::MOD:
-		return arg[1] == 0 ? 0 : arg[0] % arg[1];
+		return u256(Word256(arg[0]) % Word256(arg[1]));
 	case Instruction::SMOD:
-		return arg[1] == 0 ? 0 : s2u(u2s(arg[0]) % u2s(arg[1]));
+		return u256(Word256::signedMod(Word256(arg[0]), Word256(arg[1])));
 	case Instruction::EXP:
-		return exp256(arg[0], arg[1]);
+		return u256(Word256::exp(Word256(arg[0]), Word256(arg[1])));
 	case Instruction::NOT:
 		return ~arg[0];
 	case Instruction::LT:
@@ -153,9 +153,9 @@ u256 EVMInstructionInterpreter::eval(
 		}
 	}
 	case Instruction::ADDMOD:
-		return arg[2] == 0 ? 0 : u256((u512(arg[0]) + u512(arg[1])) % arg[2]);
+		return u256(Word256::addMod(Word256(arg[0]), Word256(arg[1]), Word256(arg[2])));
 	case Instruction::MULMOD:
-		return arg[2] == 0 ? 0 : u256((u512(arg[0]) * u512(arg[1])) % arg[2]);
+		return u256(Word256::mulMod(Word256(arg[0]), Word256(arg[1]), Word256(arg[2])));
 	case Instruction::SIGNEXTEND:
 		if (arg[0] >= 31)
 			return arg[1];